@@ -0,0 +1,192 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "HeadlessReplay.h"
+#include "AsyncChecksum.h"
+#include "EventManager.h"
+#include "Game.h"
+#include "ReplayPlayer.h"
+#include "TradePathCache.h"
+#include "addons/const_addons.h"
+#include "pathfinding/FreePathFinder.h"
+#include "world/GameWorld.h"
+#include <algorithm>
+#include <numeric>
+#include <ostream>
+#include <stdexcept>
+#ifdef _WIN32
+#    include <windows.h>
+#    include <psapi.h>
+#else
+#    include <sys/resource.h>
+#endif
+
+namespace {
+std::string escapeJSON(const std::string& str)
+{
+    std::string result;
+    for(const char c : str)
+    {
+        if(c == '"' || c == '\\')
+            result += '\\';
+        result += c;
+    }
+    return result;
+}
+
+/// Mean GF time in us
+double getMeanGFTime(const ReplayRunResult& result)
+{
+    if(result.gfTimes.empty())
+        return 0.;
+    return std::accumulate(result.gfTimes.begin(), result.gfTimes.end(), 0.) / result.gfTimes.size();
+}
+} // namespace
+
+ReplayRunResult::Histogram ReplayRunResult::getHistogram() const
+{
+    Histogram result{};
+    for(const uint32_t time : gfTimes)
+    {
+        unsigned bucket = 0;
+        while(bucket + 1u < numHistogramBuckets && time >= (1u << bucket))
+            ++bucket;
+        ++result[bucket];
+    }
+    return result;
+}
+
+uint32_t ReplayRunResult::getPercentile(unsigned percentile) const
+{
+    if(gfTimes.empty())
+        return 0;
+    std::vector<uint32_t> sortedTimes = gfTimes;
+    const auto idx = std::min<size_t>(sortedTimes.size() * percentile / 100u, sortedTimes.size() - 1u);
+    std::nth_element(sortedTimes.begin(), sortedTimes.begin() + idx, sortedTimes.end());
+    return sortedTimes[idx];
+}
+
+ReplayRunResult runReplay(const boost::filesystem::path& replayPath, std::ostream* checksumOut)
+{
+    ReplayPlayer player(replayPath);
+    Game& game = player.GetGame();
+
+    ReplayRunResult result;
+    result.name = replayPath.filename().string();
+    result.gfTimes.reserve(player.GetReplay().GetLastGF() + 1u);
+    if(checksumOut)
+        *checksumOut << "gf,randChecksum,objCt,objIdCt,eventCt,evInstanceCt\n";
+
+    using clock = std::chrono::steady_clock;
+    while(!player.IsFinished())
+    {
+        const unsigned curGF = game.em_->GetCurrentGF();
+        if(checksumOut)
+        {
+            const AsyncChecksum checksum = AsyncChecksum::create(game);
+            *checksumOut << curGF << ',' << checksum.randChecksum << ',' << checksum.objCt << ',' << checksum.objIdCt
+                         << ',' << checksum.eventCt << ',' << checksum.evInstanceCt << '\n';
+        }
+        const auto startTime = clock::now();
+        const bool isInSync = player.RunGF();
+        const auto gfTime = clock::now() - startTime;
+        if(!isInSync)
+        {
+            if(result.numAsyncs == 0)
+                result.firstAsyncGF = curGF;
+            ++result.numAsyncs;
+        }
+        result.totalTime += gfTime;
+        result.gfTimes.push_back(
+          static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::microseconds>(gfTime).count()));
+    }
+    result.peakRSS = getPeakRSS();
+    GameWorld& gameWorld = game.world_;
+    const FreePathCache& freePathCache = gameWorld.GetFreePathFinder().GetCache();
+    result.freePathCacheHits = freePathCache.GetNumHits();
+    result.freePathCacheMisses = freePathCache.GetNumMisses();
+    if(gameWorld.GetGGS().isEnabled(AddonId::TRADE))
+    {
+        const TradePathCache& tradePathCache = gameWorld.GetTradePathCache();
+        result.tradePathCacheHits = tradePathCache.getNumHits();
+        result.tradePathCacheMisses = tradePathCache.getNumMisses();
+    }
+    return result;
+}
+
+uint64_t getPeakRSS()
+{
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+        return 0;
+    return counters.PeakWorkingSetSize / 1024u;
+#else
+    rusage usage;
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+        return 0;
+#    ifdef __APPLE__
+    // Bytes on OSX
+    return static_cast<uint64_t>(usage.ru_maxrss) / 1024u;
+#    else
+    return static_cast<uint64_t>(usage.ru_maxrss);
+#    endif
+#endif
+}
+
+void writeCSVHeader(std::ostream& os)
+{
+    os << "replay,gfs,total_s,mean_gf_us,p50_gf_us,p95_gf_us,p99_gf_us,max_gf_us,asyncs,first_async_gf,peak_rss_kib,"
+          "free_path_cache_hits,free_path_cache_misses,trade_path_cache_hits,trade_path_cache_misses";
+    for(unsigned i = 0; i + 1u < ReplayRunResult::numHistogramBuckets; i++)
+        os << ",gfs_lt_" << (1u << i) << "us";
+    os << ",gfs_ge_" << (1u << (ReplayRunResult::numHistogramBuckets - 2u)) << "us\n";
+}
+
+void writeCSV(std::ostream& os, const ReplayRunResult& result)
+{
+    const double totalSeconds = std::chrono::duration<double>(result.totalTime).count();
+    const double meanGFTime = getMeanGFTime(result);
+    os << '"' << result.name << '"' << ',' << result.gfTimes.size() << ',' << totalSeconds << ',' << meanGFTime << ','
+       << result.getPercentile(50) << ',' << result.getPercentile(95) << ',' << result.getPercentile(99) << ','
+       << result.getPercentile(100) << ',' << result.numAsyncs << ',' << result.firstAsyncGF << ',' << result.peakRSS;
+    os << ',' << result.freePathCacheHits << ',' << result.freePathCacheMisses << ','
+       << result.tradePathCacheHits << ',' << result.tradePathCacheMisses;
+    for(const unsigned count : result.getHistogram())
+        os << ',' << count;
+    os << '\n';
+}
+
+void writeJSON(std::ostream& os, const ReplayRunResult& result)
+{
+    const double totalSeconds = std::chrono::duration<double>(result.totalTime).count();
+    const double meanGFTime = getMeanGFTime(result);
+    os << "{\n";
+    os << "  \"replay\": \"" << escapeJSON(result.name) << "\",\n";
+    os << "  \"gfs\": " << result.gfTimes.size() << ",\n";
+    os << "  \"total_s\": " << totalSeconds << ",\n";
+    os << "  \"gf_us\": {\"mean\": " << meanGFTime << ", \"p50\": " << result.getPercentile(50)
+       << ", \"p95\": " << result.getPercentile(95) << ", \"p99\": " << result.getPercentile(99)
+       << ", \"max\": " << result.getPercentile(100) << "},\n";
+    os << "  \"histogram_us\": [";
+    const auto histogram = result.getHistogram();
+    for(unsigned i = 0; i < histogram.size(); i++)
+    {
+        if(i > 0)
+            os << ", ";
+        if(i + 1u < histogram.size())
+            os << "{\"lt\": " << (1u << i) << ", \"count\": " << histogram[i] << "}";
+        else
+            os << "{\"ge\": " << (1u << (i - 1u)) << ", \"count\": " << histogram[i] << "}";
+    }
+    os << "],\n";
+    os << "  \"asyncs\": " << result.numAsyncs << ",\n";
+    os << "  \"first_async_gf\": " << result.firstAsyncGF << ",\n";
+    os << "  \"peak_rss_kib\": " << result.peakRSS << ",\n";
+    os << "  \"free_path_cache\": {\"hits\": " << result.freePathCacheHits
+       << ", \"misses\": " << result.freePathCacheMisses << "},\n";
+    os << "  \"trade_path_cache\": {\"hits\": " << result.tradePathCacheHits
+       << ", \"misses\": " << result.tradePathCacheMisses << "}\n";
+    os << "}";
+}
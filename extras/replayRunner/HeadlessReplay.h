@@ -0,0 +1,49 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <boost/filesystem/path.hpp>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/// Statistics of a replay run without GUI
+struct ReplayRunResult
+{
+    /// Buckets of the GF time histogram: Bucket i contains GFs taking less than 2^i us, the last one all others
+    static constexpr unsigned numHistogramBuckets = 21;
+    using Histogram = std::array<unsigned, numHistogramBuckets>;
+
+    std::string name;
+    /// Wall time of the simulation (commands and GF) per GF in us
+    std::vector<uint32_t> gfTimes;
+    std::chrono::nanoseconds totalTime{};
+    /// Number of GFs where the checksum did not match the recorded one
+    unsigned numAsyncs = 0;
+    unsigned firstAsyncGF = 0;
+    /// Peak resident set size of the process in KiB
+    uint64_t peakRSS = 0;
+    /// Hits and misses of the path caches over the whole run
+    unsigned freePathCacheHits = 0, freePathCacheMisses = 0;
+    unsigned tradePathCacheHits = 0, tradePathCacheMisses = 0;
+
+    Histogram getHistogram() const;
+    /// Get the GF time (in us) of the given percentile (0-100)
+    uint32_t getPercentile(unsigned percentile) const;
+};
+
+/// Load the replay and run it as fast as possible. Throws a std::runtime_error on failure.
+/// If checksumOut is set, the checksum of the game at the start of each GF is written to it as CSV
+ReplayRunResult runReplay(const boost::filesystem::path& replayPath, std::ostream* checksumOut);
+
+/// Get the peak resident set size of the current process in KiB
+uint64_t getPeakRSS();
+
+void writeCSVHeader(std::ostream& os);
+void writeCSV(std::ostream& os, const ReplayRunResult& result);
+void writeJSON(std::ostream& os, const ReplayRunResult& result);
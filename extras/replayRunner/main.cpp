@@ -0,0 +1,224 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "HeadlessReplay.h"
+#include "RttrConfig.h"
+#include "ogl/glAllocator.h"
+#include "libsiedler2/libsiedler2.h"
+#include "s25util/LocaleHelper.h"
+#include "s25util/Log.h"
+#include "s25util/NullWriter.h"
+#include <boost/dll/runtime_symbol_info.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/nowide/args.hpp>
+#include <boost/nowide/fstream.hpp>
+#include <boost/nowide/iostream.hpp>
+#include <boost/process/args.hpp>
+#include <boost/process/child.hpp>
+#include <boost/process/exe.hpp>
+#include <boost/program_options.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace bfs = boost::filesystem;
+namespace bnw = boost::nowide;
+namespace bp = boost::process;
+namespace po = boost::program_options;
+
+namespace {
+struct Options
+{
+    bfs::path outputDir;
+    bool useJSON;
+    bool writeChecksums;
+};
+
+bfs::path getResultPath(const bfs::path& replayPath, const Options& options)
+{
+    return options.outputDir / (replayPath.stem().string() + (options.useJSON ? ".json" : ".csv"));
+}
+
+/// Run a single replay in this process and write its results
+bool runSingleReplay(const bfs::path& replayPath, const Options& options)
+{
+    try
+    {
+        std::unique_ptr<bnw::ofstream> checksumFile;
+        if(options.writeChecksums)
+        {
+            checksumFile = std::make_unique<bnw::ofstream>(
+              (options.outputDir / (replayPath.stem().string() + ".checksums.csv")).string());
+        }
+        const ReplayRunResult result = runReplay(replayPath, checksumFile.get());
+        bnw::ofstream resultFile(getResultPath(replayPath, options).string());
+        if(options.useJSON)
+            writeJSON(resultFile, result);
+        else
+        {
+            writeCSVHeader(resultFile);
+            writeCSV(resultFile, result);
+        }
+        bnw::cout << replayPath.filename() << ": " << result.gfTimes.size() << " GFs in "
+                  << std::chrono::duration<double>(result.totalTime).count() << "s" << std::endl;
+        if(result.numAsyncs)
+            bnw::cerr << replayPath.filename() << ": Async at GF " << result.firstAsyncGF << std::endl;
+        return true;
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << replayPath.filename() << ": " << e.what() << std::endl;
+        return false;
+    }
+}
+
+/// Run each replay in a separate process (as the game uses global state) using up to numJobs processes at once
+std::vector<bool> runReplaysInProcesses(const std::vector<bfs::path>& replayPaths, unsigned numJobs,
+                                        const Options& options)
+{
+    const bfs::path exePath = boost::dll::program_location();
+    std::vector<char> success(replayPaths.size(), false);
+    std::atomic<unsigned> nextReplay(0);
+    std::vector<std::thread> workers;
+    for(unsigned i = 0; i < std::min<size_t>(numJobs, replayPaths.size()); i++)
+    {
+        workers.emplace_back([&]() {
+            for(unsigned idx = nextReplay++; idx < replayPaths.size(); idx = nextReplay++)
+            {
+                std::vector<std::string> args{replayPaths[idx].string(), "--no-summary", "--output-dir",
+                                              options.outputDir.string(), "--format",
+                                              options.useJSON ? "json" : "csv"};
+                if(options.writeChecksums)
+                    args.push_back("--checksums");
+                bp::child child(bp::exe = exePath.string(), bp::args = args);
+                child.wait();
+                success[idx] = child.exit_code() == 0;
+            }
+        });
+    }
+    for(std::thread& worker : workers)
+        worker.join();
+    return std::vector<bool>(success.begin(), success.end());
+}
+
+/// Combine the results of the successful replays into one file
+void writeSummary(const std::vector<bfs::path>& replayPaths, const std::vector<bool>& success,
+                  const Options& options)
+{
+    const bfs::path summaryPath = options.outputDir / (options.useJSON ? "summary.json" : "summary.csv");
+    bnw::ofstream summary(summaryPath.string());
+    if(options.useJSON)
+        summary << "[\n";
+    bool isFirst = true;
+    for(unsigned i = 0; i < replayPaths.size(); i++)
+    {
+        if(!success[i])
+            continue;
+        bnw::ifstream resultFile(getResultPath(replayPaths[i], options).string());
+        std::string line;
+        // Each CSV file has a header line, which is only copied once
+        bool isHeader = !options.useJSON;
+        if(options.useJSON && !isFirst)
+            summary << ",\n";
+        while(std::getline(resultFile, line))
+        {
+            if(!isHeader || isFirst)
+                summary << line << '\n';
+            isHeader = false;
+        }
+        isFirst = false;
+    }
+    if(options.useJSON)
+        summary << "]\n";
+    bnw::cout << "Results written to " << summaryPath << std::endl;
+}
+
+int runReplays(const po::variables_map& vm)
+{
+    Options options;
+    options.outputDir = vm["output-dir"].as<std::string>();
+    const auto format = vm["format"].as<std::string>();
+    if(format != "csv" && format != "json")
+    {
+        bnw::cerr << "Invalid format: " << format << std::endl;
+        return 1;
+    }
+    options.useJSON = format == "json";
+    options.writeChecksums = vm.count("checksums") > 0;
+    bfs::create_directories(options.outputDir);
+
+    std::vector<bfs::path> replayPaths;
+    for(const std::string& replay : vm["replay"].as<std::vector<std::string>>())
+        replayPaths.push_back(replay);
+
+    std::vector<bool> success;
+    if(replayPaths.size() == 1u)
+    {
+        if(!LocaleHelper::init() || !RTTRCONFIG.Init())
+            return 1;
+        // Only log to console
+        LOG.setWriter(new NullWriter(), LogTarget::File);
+        libsiedler2::setAllocator(new GlAllocator);
+        success.push_back(runSingleReplay(replayPaths.front(), options));
+        libsiedler2::setAllocator(nullptr);
+    } else
+        success = runReplaysInProcesses(replayPaths, std::max(1u, vm["jobs"].as<unsigned>()), options);
+
+    if(!vm.count("no-summary"))
+        writeSummary(replayPaths, success, options);
+    return std::all_of(success.begin(), success.end(), [](bool s) { return s; }) ? 0 : 1;
+}
+} // namespace
+
+int main(int argc, char** argv)
+{
+    bnw::args _(argc, argv);
+
+    po::options_description desc("Allowed options");
+    // clang-format off
+    desc.add_options()
+        ("help,h", "Show help")
+        ("replay", po::value<std::vector<std::string>>()->required(), "Replay(s) to run")
+        ("jobs,j", po::value<unsigned>()->default_value(std::max(1u, std::thread::hardware_concurrency())),
+            "Number of replays to run in parallel")
+        ("output-dir,o", po::value<std::string>()->default_value("."), "Directory to write the results to")
+        ("format,f", po::value<std::string>()->default_value("csv"), "Format of the results: csv or json")
+        ("checksums", "Write the checksum of each GF to <replay>.checksums.csv")
+        ("no-summary", "Only write the results per replay")
+        ;
+    // clang-format on
+    po::positional_options_description positionalOptions;
+    positionalOptions.add("replay", -1);
+
+    po::variables_map vm;
+    try
+    {
+        po::store(po::command_line_parser(argc, argv).options(desc).positional(positionalOptions).run(), vm);
+        if(vm.count("help"))
+        {
+            bnw::cout << "Runs replays without GUI as fast as possible and reports the time per GF, the checksums "
+                         "and the memory usage\n\n"
+                      << desc << "\n";
+            return 0;
+        }
+        po::notify(vm);
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << "Error: " << e.what() << "\n\n";
+        bnw::cerr << desc << "\n";
+        return 1;
+    }
+
+    try
+    {
+        return runReplays(vm);
+    } catch(const std::exception& e)
+    {
+        bnw::cerr << "An exception occurred: " << e.what() << std::endl;
+        return 1;
+    }
+}
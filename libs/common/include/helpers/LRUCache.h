@@ -0,0 +1,85 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "RTTR_Assert.h"
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace helpers {
+
+/// Map with a maximum number of entries. If it is full, the least recently used entry is replaced.
+/// Finding or inserting an entry makes it the most recently used one.
+template<typename TKey, typename TValue, class THash = std::hash<TKey>>
+class LRUCache
+{
+    using Entry = std::pair<TKey, TValue>;
+    using EntryList = std::list<Entry>;
+
+public:
+    explicit LRUCache(size_t maxSize) : maxSize_(maxSize) { RTTR_Assert(maxSize > 0u); }
+    LRUCache(const LRUCache&) = delete;
+    LRUCache& operator=(const LRUCache&) = delete;
+
+    /// Return the value stored for the key or nullptr if there is none
+    TValue* find(const TKey& key)
+    {
+        const auto it = index_.find(key);
+        if(it == index_.end())
+            return nullptr;
+        entries_.splice(entries_.begin(), entries_, it->second);
+        return &it->second->second;
+    }
+
+    /// Store the value for the key replacing the current value or the least recently used entry if the cache is full
+    TValue& insert(const TKey& key, TValue value)
+    {
+        const auto it = index_.find(key);
+        if(it != index_.end())
+        {
+            entries_.splice(entries_.begin(), entries_, it->second);
+            it->second->second = std::move(value);
+            return it->second->second;
+        }
+        if(entries_.size() >= maxSize_)
+        {
+            index_.erase(entries_.back().first);
+            entries_.pop_back();
+        }
+        entries_.emplace_front(key, std::move(value));
+        index_.emplace(key, entries_.begin());
+        return entries_.front().second;
+    }
+
+    /// Remove the entry for the key if it exists
+    void erase(const TKey& key)
+    {
+        const auto it = index_.find(key);
+        if(it == index_.end())
+            return;
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+
+    void clear()
+    {
+        index_.clear();
+        entries_.clear();
+    }
+
+    size_t size() const { return entries_.size(); }
+    size_t max_size() const { return maxSize_; }
+
+private:
+    size_t maxSize_;
+    /// All entries, most recently used first
+    EntryList entries_;
+    std::unordered_map<TKey, typename EntryList::iterator, THash> index_;
+};
+
+} // namespace helpers
@@ -0,0 +1,95 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "RTTR_Assert.h"
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace helpers {
+
+/// Allocator for objects of a single type which gets its memory in chunks of T_chunkSize objects
+/// instead of doing one heap allocation per object.
+/// Destroyed objects put their slot into a free list which is used first for new objects.
+/// All memory is only released when the pool is destroyed, which does NOT call the destructors of live objects
+template<typename T, size_t T_chunkSize = 512>
+class ObjectPool
+{
+    static_assert(T_chunkSize > 0u, "Chunk size must not be empty");
+
+    union Slot
+    {
+        Slot* nextFree;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    /// Construct a new object from the given arguments
+    template<typename... Args>
+    T* create(Args&&... args)
+    {
+        if(!freeList_)
+            addChunk();
+        Slot* slot = freeList_;
+        freeList_ = slot->nextFree;
+        T* result;
+        try
+        {
+            result = new(&slot->storage) T(std::forward<Args>(args)...);
+        } catch(...)
+        {
+            slot->nextFree = freeList_;
+            freeList_ = slot;
+            throw;
+        }
+        ++numUsed_;
+        return result;
+    }
+
+    /// Destroy an object previously created by this pool
+    void destroy(const T* obj)
+    {
+        if(!obj)
+            return;
+        RTTR_Assert(numUsed_ > 0u);
+        obj->~T();
+        auto* slot = reinterpret_cast<Slot*>(const_cast<T*>(obj));
+        slot->nextFree = freeList_;
+        freeList_ = slot;
+        --numUsed_;
+    }
+
+    /// Number of currently live objects
+    size_t size() const { return numUsed_; }
+    /// Number of objects that can be live without allocating more memory
+    size_t capacity() const { return chunks_.size() * T_chunkSize; }
+
+private:
+    std::vector<std::unique_ptr<Slot[]>> chunks_;
+    Slot* freeList_ = nullptr;
+    size_t numUsed_ = 0;
+
+    void addChunk()
+    {
+        chunks_.emplace_back(new Slot[T_chunkSize]);
+        Slot* chunk = chunks_.back().get();
+        // Link in reverse so the slots get used in memory order
+        for(size_t i = T_chunkSize; i-- > 0;)
+        {
+            chunk[i].nextFree = freeList_;
+            freeList_ = &chunk[i];
+        }
+    }
+};
+
+} // namespace helpers
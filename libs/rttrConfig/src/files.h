@@ -18,6 +18,7 @@ namespace folders {
     constexpr auto assetsNations = "<RTTR_RTTR>/assets/nations";     // Addon specific assets
     constexpr auto assetsOverrides = "<RTTR_RTTR>/assets/overrides"; // Assets overriding S2 files
     constexpr auto assetsUserOverrides = "<RTTR_USERDATA>/LSTS";     // User overrides for assets
+    constexpr auto cache = "<RTTR_USERDATA>/cache";                  // Data which can be recreated
     constexpr auto config = "<RTTR_USERDATA>";
     constexpr auto data = "<RTTR_GAME>/DATA"; // S2 game data
     constexpr auto driver = "<RTTR_DRIVER>";
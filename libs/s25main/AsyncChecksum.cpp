@@ -11,29 +11,48 @@
 #include "s25util/Serializer.h"
 #include <ostream>
 
-AsyncChecksum::AsyncChecksum() : randChecksum(0), objCt(0), objIdCt(0), eventCt(0), evInstanceCt(0) {}
+constexpr AsyncChecksum::Version AsyncChecksum::currentVersion;
+
+AsyncChecksum::AsyncChecksum()
+    : randChecksum(0), objCt(0), objIdCt(0), eventCt(0), evInstanceCt(0), hasStateHash(false), stateHash(0)
+{}
 
 AsyncChecksum::AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt,
                              unsigned evInstanceCt)
-    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt)
+    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt),
+      hasStateHash(false), stateHash(0)
+{}
+
+AsyncChecksum::AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt,
+                             unsigned evInstanceCt, unsigned stateHash)
+    : randChecksum(randChecksum), objCt(objCt), objIdCt(objIdCt), eventCt(eventCt), evInstanceCt(evInstanceCt),
+      hasStateHash(true), stateHash(stateHash)
 {}
 
-void AsyncChecksum::Serialize(Serializer& ser) const
+void AsyncChecksum::Serialize(Serializer& ser, const Version version) const
 {
     ser.PushUnsignedInt(randChecksum);
     ser.PushUnsignedInt(objCt);
     ser.PushUnsignedInt(objIdCt);
     ser.PushUnsignedInt(eventCt);
     ser.PushUnsignedInt(evInstanceCt);
+    if(version >= Version::WithStateHash)
+    {
+        ser.PushBool(hasStateHash);
+        if(hasStateHash)
+            ser.PushUnsignedInt(stateHash);
+    }
 }
 
-void AsyncChecksum::Deserialize(Serializer& ser)
+void AsyncChecksum::Deserialize(Serializer& ser, const Version version)
 {
     randChecksum = ser.PopUnsignedInt();
     objCt = ser.PopUnsignedInt();
     objIdCt = ser.PopUnsignedInt();
     eventCt = ser.PopUnsignedInt();
     evInstanceCt = ser.PopUnsignedInt();
+    hasStateHash = (version >= Version::WithStateHash) && ser.PopBool();
+    stateHash = hasStateHash ? ser.PopUnsignedInt() : 0;
 }
 
 unsigned AsyncChecksum::getHash() const
@@ -46,11 +65,15 @@ unsigned AsyncChecksum::getHash() const
 AsyncChecksum AsyncChecksum::create(const Game& game)
 {
     return AsyncChecksum(RANDOM.GetChecksum(), GameObject::GetNumObjs(), GameObject::GetObjIDCounter(),
-                         game.em_->GetNumActiveEvents(), game.em_->GetEventInstanceCtr());
+                         game.em_->GetNumActiveEvents(), game.em_->GetEventInstanceCtr(),
+                         game.world_.GetStateHash().Get());
 }
 
 std::ostream& operator<<(std::ostream& os, const AsyncChecksum& checksum)
 {
     return os << "RandCS = " << checksum.randChecksum << ",\tobjects/ID = " << checksum.objCt << "/" << checksum.objIdCt
-              << ",\tevents/ID = " << checksum.eventCt << "/" << checksum.evInstanceCt;
+              << ",\tevents/ID = " << checksum.eventCt << "/" << checksum.evInstanceCt << ",\tstate = ";
+    if(checksum.hasStateHash)
+        return os << checksum.stateHash;
+    return os << "unknown";
 }
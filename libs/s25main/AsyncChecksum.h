@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstdint>
 #include <iosfwd>
 
 class Game;
@@ -12,13 +13,30 @@ class Serializer;
 /// Checksum of the game before the game commands of any player is executed
 struct AsyncChecksum
 {
+    /// Format of the serialized checksum
+    enum class Version : uint8_t
+    {
+        /// Only counters and RNG. Used by replays to stay compatible
+        Basic,
+        /// Including the hash of the game state
+        WithStateHash
+    };
+    static constexpr Version currentVersion = Version::WithStateHash;
+
     unsigned randChecksum;
     unsigned objCt, objIdCt;
     unsigned eventCt, evInstanceCt;
+    /// False if the state hash is unknown, e.g. for checksums from a replay
+    bool hasStateHash;
+    /// Hash of the game state (see StateHash). Only valid if hasStateHash is set
+    unsigned stateHash;
     AsyncChecksum();
+    /// Create a checksum without a state hash
     AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt);
-    void Serialize(Serializer& ser) const;
-    void Deserialize(Serializer& ser);
+    AsyncChecksum(unsigned randChecksum, unsigned objCt, unsigned objIdCt, unsigned eventCt, unsigned evInstanceCt,
+                  unsigned stateHash);
+    void Serialize(Serializer& ser, Version version = currentVersion) const;
+    void Deserialize(Serializer& ser, Version version = currentVersion);
     /// Get a hash for this checksum
     unsigned getHash() const;
 
@@ -30,8 +48,9 @@ struct AsyncChecksum
 
 inline bool AsyncChecksum::operator==(const AsyncChecksum& rhs) const
 {
+    // An unknown state hash matches any
     return randChecksum == rhs.randChecksum && objCt == rhs.objCt && objIdCt == rhs.objIdCt && eventCt == rhs.eventCt
-           && evInstanceCt == rhs.evInstanceCt;
+           && evInstanceCt == rhs.evInstanceCt && (!hasStateHash || !rhs.hasStateHash || stateHash == rhs.stateHash);
 }
 
 inline bool AsyncChecksum::operator!=(const AsyncChecksum& rhs) const
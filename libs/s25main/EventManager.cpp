@@ -6,9 +6,43 @@
 #include "GameEvent.h"
 #include "GameObject.h"
 #include "SerializedGameData.h"
-#include "helpers/containerUtils.h"
 #include "s25util/Log.h"
 #include <mygettext/mygettext.h>
+#include <algorithm>
+
+constexpr unsigned EventManager::wheelBits;
+constexpr unsigned EventManager::wheelSize;
+constexpr unsigned EventManager::wheelMask;
+
+void EventManager::EventList::push_back(const GameEvent& event)
+{
+    RTTR_Assert(!event.prev && !event.next);
+    event.prev = last;
+    if(last)
+        last->next = &event;
+    else
+        first = &event;
+    last = &event;
+}
+
+void EventManager::EventList::erase(const GameEvent& event)
+{
+    if(event.prev)
+        event.prev->next = event.next;
+    else
+    {
+        RTTR_Assert(first == &event);
+        first = event.next;
+    }
+    if(event.next)
+        event.next->prev = event.prev;
+    else
+    {
+        RTTR_Assert(last == &event);
+        last = event.prev;
+    }
+    event.prev = event.next = nullptr;
+}
 
 EventManager::EventManager(unsigned startGF)
     : numActiveEvents(0), eventInstanceCtr(1), currentGF(startGF), curActiveEvent(nullptr)
@@ -21,22 +55,28 @@ EventManager::~EventManager()
 
 void EventManager::Clear()
 {
-    for(const auto& event : events)
-    {
-        for(const GameEvent* ev : event.second)
+    const auto clearEvents = [this](EventList& events) {
+        while(!events.empty())
         {
-            delete ev;
+            const GameEvent* ev = events.first;
+            events.erase(*ev);
+            eventPool.destroy(ev);
             RTTR_Assert(numActiveEvents > 0u);
             numActiveEvents--;
         }
-    }
-    events.clear();
+    };
+    for(EventList& events : blockEvents)
+        clearEvents(events);
+    for(EventList& events : superBlockEvents)
+        clearEvents(events);
+    clearEvents(farEvents);
     RTTR_Assert(numActiveEvents == 0u);
 
     for(auto* it : killList)
     {
         GameObject* obj = it;
         it = nullptr;
+        obj->isInKillList = false;
         delete obj;
     }
     killList.clear();
@@ -51,17 +91,53 @@ const GameEvent* EventManager::AddEventToQueue(const GameEvent* event)
 {
     // Should be in the future!
     RTTR_Assert(event->GetTargetGF() > currentGF);
-    events[event->GetTargetGF()].push_back(event);
+    GetEventList(event->GetTargetGF()).push_back(*event);
+    LinkToObject(*event);
     ++numActiveEvents;
     return event;
 }
 
+void EventManager::LinkToObject(const GameEvent& event)
+{
+    GameObject& obj = *event.obj;
+    RTTR_Assert(!event.objPrev && !event.objNext);
+    event.objNext = obj.lastAddedEvent;
+    if(obj.lastAddedEvent)
+        obj.lastAddedEvent->objPrev = &event;
+    obj.lastAddedEvent = &event;
+}
+
+void EventManager::UnlinkFromObject(const GameEvent& event)
+{
+    if(event.objPrev)
+        event.objPrev->objNext = event.objNext;
+    else
+    {
+        RTTR_Assert(event.obj->lastAddedEvent == &event);
+        event.obj->lastAddedEvent = event.objNext;
+    }
+    if(event.objNext)
+        event.objNext->objPrev = event.objPrev;
+    event.objPrev = event.objNext = nullptr;
+}
+
+EventManager::EventList& EventManager::GetEventList(unsigned targetGF)
+{
+    const unsigned changedBits = targetGF ^ currentGF;
+    if(changedBits < wheelSize)
+        return blockEvents[targetGF & wheelMask];
+    else if(changedBits < wheelSize * wheelSize)
+        return superBlockEvents[(targetGF >> wheelBits) & wheelMask];
+    else
+        return farEvents;
+}
+
 const GameEvent* EventManager::AddEvent(GameObject* obj, unsigned gf_length, unsigned id)
 {
     RTTR_Assert(obj);
     RTTR_Assert(gf_length);
 
-    return AddEventToQueue(new GameEvent(GetNextEventInstanceId(), obj, currentGF, gf_length, id));
+    return AddEventToQueue(eventPool.create(GetNextEventInstanceId(), obj, currentGF, gf_length, id));
 }
 
 const GameEvent* EventManager::AddEvent(GameObject* obj, unsigned gf_length, unsigned id, unsigned gf_elapsed)
@@ -69,7 +145,7 @@ const GameEvent* EventManager::AddEvent(GameObject* obj, unsigned gf_length, uns
     RTTR_Assert(gf_length > gf_elapsed);
     // Anfang des Events in die Vergangenheit zurückverlegen
     RTTR_Assert(currentGF >= gf_elapsed);
-    return AddEventToQueue(new GameEvent(GetNextEventInstanceId(), obj, currentGF - gf_elapsed, gf_length, id));
+    return AddEventToQueue(eventPool.create(GetNextEventInstanceId(), obj, currentGF - gf_elapsed, gf_length, id));
 }
 
 unsigned EventManager::GetNextEventInstanceId()
@@ -80,14 +156,69 @@ unsigned EventManager::GetNextEventInstanceId()
     return result;
 }
 
+const GameEvent* EventManager::CreateSerializedEvent(SerializedGameData& sgd, unsigned instanceId)
+{
+    return eventPool.create(sgd, instanceId);
+}
+
 void EventManager::ExecuteNextGF()
 {
-    currentGF++;
+    AdvanceToGF(currentGF + 1);
 
     ExecuteCurrentEvents();
     DestroyCurrentObjects();
 }
 
+void EventManager::AdvanceToGF(unsigned gf)
+{
+    RTTR_Assert(gf >= currentGF);
+    const unsigned changedBits = gf ^ currentGF;
+    currentGF = gf;
+    if(changedBits < wheelSize)
+        return;
+    // Entered a new block (and maybe superblock) -> Move its events down to the lower levels
+    if(changedBits >= wheelSize * wheelSize)
+        RescheduleEvents(farEvents);
+    RescheduleEvents(superBlockEvents[(gf >> wheelBits) & wheelMask]);
+}
+
+void EventManager::RescheduleEvents(EventList& events)
+{
+    const GameEvent* ev = events.first;
+    events = EventList();
+    while(ev)
+    {
+        const GameEvent* next = ev->next;
+        ev->prev = ev->next = nullptr;
+        GetEventList(ev->GetTargetGF()).push_back(*ev);
+        ev = next;
+    }
+}
+
+unsigned EventManager::GetNextEventGF() const
+{
+    RTTR_Assert(numActiveEvents > 0u);
+    for(unsigned gf = currentGF + 1; (gf ^ currentGF) < wheelSize; gf++)
+    {
+        if(!blockEvents[gf & wheelMask].empty())
+            return gf;
+    }
+    const auto getMinTargetGF = [](const EventList& events) {
+        unsigned result = events.first->GetTargetGF();
+        for(const GameEvent* ev = events.first->next; ev; ev = ev->next)
+            result = std::min(result, ev->GetTargetGF());
+        return result;
+    };
+    for(unsigned block = (currentGF >> wheelBits) + 1; ((block ^ (currentGF >> wheelBits)) < wheelSize); block++)
+    {
+        const EventList& events = superBlockEvents[block & wheelMask];
+        if(!events.empty())
+            return getMinTargetGF(events);
+    }
+    RTTR_Assert(!farEvents.empty());
+    return getMinTargetGF(farEvents);
+}
+
 void EventManager::DestroyCurrentObjects()
 {
     // Remove all objects
@@ -96,6 +227,7 @@ void EventManager::DestroyCurrentObjects()
         GameObject* obj = it;
         // Object is no longer in the kill list (some may check this upon destruction)
         it = nullptr;
+        obj->isInKillList = false;
         obj->Destroy();
         RTTR_Assert(!ObjectHasEvents(*obj));
         delete obj;
@@ -107,44 +239,59 @@ void EventManager::DestroyCurrentObjects()
 std::vector<const GameEvent*> EventManager::GetEvents() const
 {
     std::vector<const GameEvent*> nextEv;
-    for(const auto& event : events)
-        nextEv.insert(nextEv.end(), event.second.begin(), event.second.end());
+    nextEv.reserve(numActiveEvents);
+    const auto addEvents = [&nextEv](const EventList& events) {
+        for(const GameEvent* ev = events.first; ev; ev = ev->next)
+            nextEv.push_back(ev);
+    };
+    // Each list of the current block contains only events of a single GF
+    for(const EventList& events : blockEvents)
+        addEvents(events);
+    // The others contain events of multiple GFs -> Sort by GF keeping insertion order inside a GF
+    const auto sortByGF = [](const GameEvent* lhs, const GameEvent* rhs) {
+        return lhs->GetTargetGF() < rhs->GetTargetGF();
+    };
+    for(const EventList& events : superBlockEvents)
+    {
+        const auto startIdx = nextEv.size();
+        addEvents(events);
+        std::stable_sort(nextEv.begin() + startIdx, nextEv.end(), sortByGF);
+    }
+    const auto startIdx = nextEv.size();
+    addEvents(farEvents);
+    std::stable_sort(nextEv.begin() + startIdx, nextEv.end(), sortByGF);
     return nextEv;
 }
 
 void EventManager::ExecuteCurrentEvents()
 {
-    if(events.empty())
-        return;
-    // Get list of events to be executed next
-    auto itCurEvents = events.begin();
-
-    RTTR_Assert(itCurEvents->first >= currentGF);
-
-    if(itCurEvents->first == currentGF)
-        ExecuteEvents(itCurEvents);
+    ExecuteEvents(blockEvents[currentGF & wheelMask]);
 }
 
-void EventManager::ExecuteEvents(const EventMap::iterator& itEvents)
+void EventManager::ExecuteEvents(EventList& events)
 {
-    EventList& curEvents = itEvents->second;
     // We have to allow 2 cases:
-    // 1) Adding of events to current GF -> std::list allows this without invalidating any iterators
-    // 2) Checking for events -> Remove all deleted events so only valid ones are in the list
-    for(auto e_it = curEvents.begin(); e_it != curEvents.end(); e_it = curEvents.erase(e_it))
+    // 1) Adding of events to current GF -> They are appended to the list
+    // 2) Removing events of the current GF -> They are unlinked from the list
+    // The active event cannot be removed so it stays the first until it is finished
+    while(!events.empty())
     {
-        const GameEvent* ev = *e_it;
+        const GameEvent* ev = events.first;
+        RTTR_Assert(ev->GetTargetGF() == currentGF);
         RTTR_Assert(ev->obj);
         RTTR_Assert(ev->obj->GetObjId() <= GameObject::GetObjIDCounter());
 
+        // Unlink from the object first as it might get deleted during the event
+        UnlinkFromObject(*ev);
         curActiveEvent = ev;
         ev->obj->HandleEvent(ev->id);
 
-        delete ev;
+        RTTR_Assert(events.first == ev);
+        events.erase(*ev);
+        eventPool.destroy(ev);
         --numActiveEvents;
     }
     curActiveEvent = nullptr;
-    events.erase(itEvents);
 }
 
 void EventManager::Serialize(SerializedGameData& sgd) const
@@ -183,35 +330,37 @@ void EventManager::Deserialize(SerializedGameData& sgd)
         boost::format eventCtError(_("Event count mismatch. Read events: %1%. Expected: %2%.\n"));
         throw SerializedGameData::Error((eventCtError % numActiveEvents % numEvents).str());
     }
-    for(const auto& it : events)
+    for(const GameEvent* ev : GetEvents())
     {
-        for(const GameEvent* ev : it.second)
+        if(ev->GetInstanceId() >= eventInstanceCtr)
         {
-            if(ev->GetInstanceId() >= eventInstanceCtr)
-            {
-                boost::format eventIdError(_("Invalid event instance id. Found: %1%. Expected less than %2%.\n"));
-                throw SerializedGameData::Error((eventIdError % ev->GetInstanceId() % eventInstanceCtr).str());
-            }
+            boost::format eventIdError(_("Invalid event instance id. Found: %1%. Expected less than %2%.\n"));
+            throw SerializedGameData::Error((eventIdError % ev->GetInstanceId() % eventInstanceCtr).str());
         }
     }
 }
 
-bool EventManager::ObjectHasEvents(const GameObject& obj)
+bool EventManager::ObjectHasEvents(const GameObject& obj) const
 {
-    for(const auto& event : events)
-    {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->obj == &obj)
-                return true;
-        }
-    }
-    return false;
+    return obj.lastAddedEvent || (curActiveEvent && curActiveEvent->obj == &obj);
 }
 
-bool EventManager::IsObjectInKillList(const GameObject& obj)
+bool EventManager::IsObjectInKillList(const GameObject& obj) const
 {
-    return helpers::contains(killList, &obj);
+    return obj.isInKillList;
+}
+
+std::vector<const GameEvent*> EventManager::GetObjectEvents(const GameObject& obj) const
+{
+    std::vector<const GameEvent*> objEvents;
+    for(const GameEvent* ev = obj.lastAddedEvent; ev; ev = ev->objNext)
+        objEvents.push_back(ev);
+    // Events of the same GF are processed in the order they were added
+    std::reverse(objEvents.begin(), objEvents.end());
+    std::stable_sort(objEvents.begin(), objEvents.end(), [](const GameEvent* lhs, const GameEvent* rhs) {
+        return lhs->GetTargetGF() < rhs->GetTargetGF();
+    });
+    return objEvents;
 }
 
 void EventManager::RemoveEvent(const GameEvent*& ep)
@@ -227,36 +376,24 @@ void EventManager::RemoveEvent(const GameEvent*& ep)
         return;
     }
     RemoveEventFromQueue(*ep);
-    deletePtr(ep);
+    eventPool.destroy(ep);
+    ep = nullptr;
 }
 
 void EventManager::RemoveEventFromQueue(const GameEvent& event)
 {
     RTTR_Assert(curActiveEvent != &event);
-    auto itEventsAtTime = events.find(event.GetTargetGF());
-    if(itEventsAtTime != events.end())
+    // Note: Removing from the currently processed list is possible, as the curActiveEvent is always left in it
+    EventList& eventsAtTime = GetEventList(event.GetTargetGF());
+    if(event.prev || eventsAtTime.first == &event)
     {
-        EventList& eventsAtTime = itEventsAtTime->second;
-        auto e_it = helpers::find(eventsAtTime, &event);
-        if(e_it != eventsAtTime.end())
-        {
-            eventsAtTime.erase(e_it);
-            --numActiveEvents;
-            RTTR_Assert(!helpers::contains(eventsAtTime, &event)); // Event existed multiple times?
-        } else
-        {
-            RTTR_Assert(false);
-            LOG.write("Bug detected: Event to be removed did not exist");
-        }
-
-        // Note: Removing this is possible, as it cannot be the currently processed list
-        //       because there is always the curActiveEvent left, which cannot be removed (check above)
-        if(eventsAtTime.empty())
-            events.erase(itEventsAtTime);
+        eventsAtTime.erase(event);
+        UnlinkFromObject(event);
+        --numActiveEvents;
     } else
     {
         RTTR_Assert(false);
-        LOG.write("Bug detected: GF of event to be removed did not exist");
+        LOG.write("Bug detected: Event to be removed did not exist");
     }
 }
 
@@ -264,6 +401,7 @@ void EventManager::AddToKillList(GameObject* obj)
 {
     RTTR_Assert(obj);
     RTTR_Assert(!IsObjectInKillList(*obj));
+    obj->isInKillList = true;
     killList.emplace_back(obj);
 }
 
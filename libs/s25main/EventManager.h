@@ -4,13 +4,14 @@
 
 #pragma once
 
+#include "GameEvent.h"
+#include "helpers/ObjectPool.h"
+#include <array>
 #include <list>
-#include <map>
 #include <memory>
 #include <vector>
 
 class SerializedGameData;
-class GameEvent;
 class GameObject;
 
 class EventManager
@@ -43,38 +44,76 @@ public:
 
     void Serialize(SerializedGameData& sgd) const;
     void Deserialize(SerializedGameData& sgd);
+    /// Create an event from serialized data. It is added to the queue by Deserialize
+    const GameEvent* CreateSerializedEvent(SerializedGameData& sgd, unsigned instanceId);
 
     unsigned GetNextEventInstanceId();
 
     unsigned GetCurrentGF() const { return currentGF; }
 
-    /// Return true if the object has any active events. SLOW!
-    bool ObjectHasEvents(const GameObject& obj);
+    /// Return true if the object has any active events
+    bool ObjectHasEvents(const GameObject& obj) const;
     /// Return true if the object will be destroyed after the current GF
-    bool IsObjectInKillList(const GameObject& obj);
+    bool IsObjectInKillList(const GameObject& obj) const;
 
 protected:
-    // Use list to allow removing of events while iterating (Event A can cause Event B in the same GF to be removed)
-    using EventList = std::list<const GameEvent*>;
-    using EventMap = std::map<unsigned, EventList>;
+    /// Intrusive list of events in insertion order.
+    /// Allows removing of events while iterating (Event A can cause Event B in the same GF to be removed)
+    struct EventList
+    {
+        const GameEvent* first = nullptr;
+        const GameEvent* last = nullptr;
+
+        bool empty() const { return first == nullptr; }
+        void push_back(const GameEvent& event);
+        void erase(const GameEvent& event);
+    };
     // Use list to allow adding events while iterating (Destroying 1 object may lead to destruction of another)
     using GameObjList = std::list<GameObject*>;
+
+    /// The events are stored in a hierarchical timing wheel:
+    /// The GFs are split into blocks of wheelSize GFs and superblocks of wheelSize blocks.
+    /// Level 0 contains one list per GF of the current block, level 1 one list per block of the current superblock
+    /// and all later events are in a single list. Whenever a new (super)block is entered its events are moved down.
+    /// As the lists keep insertion order and are empty when filled by moving the order within a GF is preserved.
+    static constexpr unsigned wheelBits = 10;
+    static constexpr unsigned wheelSize = 1u << wheelBits;
+    static constexpr unsigned wheelMask = wheelSize - 1u;
+
     unsigned numActiveEvents;
     /// Instances created. Must be != 0
     unsigned eventInstanceCtr;
     unsigned currentGF;
-    EventMap events;      /// Mapping of GF to Events to be executed in this GF
+    std::array<EventList, wheelSize> blockEvents;      /// Events per GF of the current block
+    std::array<EventList, wheelSize> superBlockEvents; /// Events per block of the current superblock
+    EventList farEvents;                               /// All events after the current superblock
+    helpers::ObjectPool<GameEvent> eventPool;
     GameObjList killList; /// Objects that will be killed after current GF
     const GameEvent* curActiveEvent;
 
     const GameEvent* AddEventToQueue(const GameEvent* event);
     void RemoveEventFromQueue(const GameEvent& event);
+    /// Add the event to the list of events of its object
+    static void LinkToObject(const GameEvent& event);
+    /// Remove the event from the list of events of its object
+    static void UnlinkFromObject(const GameEvent& event);
+    /// Get the list in which an event for the given GF is stored
+    EventList& GetEventList(unsigned targetGF);
+    /// Set the current GF moving events into the lower wheel levels.
+    /// There must not be any events before that GF
+    void AdvanceToGF(unsigned gf);
+    /// Move all events of the list to the list they belong to at the current GF
+    void RescheduleEvents(EventList& events);
+    /// Return the GF of the next event. There must be at least one event
+    unsigned GetNextEventGF() const;
     /// Execute all events of the current GF
     void ExecuteCurrentEvents();
-    /// Execute the events from the given iterator
-    void ExecuteEvents(const EventMap::iterator& itEvents);
+    /// Execute all events from the given list
+    void ExecuteEvents(EventList& events);
     /// Destroy all objects in the kill list
     void DestroyCurrentObjects();
     /// Get all events in the order they will be processed
     std::vector<const GameEvent*> GetEvents() const;
+    /// Get all events of the object in the order they will be processed
+    std::vector<const GameEvent*> GetObjectEvents(const GameObject& obj) const;
 };
@@ -10,12 +10,14 @@
 //-V:clock::time_point:813
 
 FrameCounter::FrameCounter(clock::duration updateInverval)
-    : updateInverval_(updateInverval), framerate_(0), curNumFrames_(0)
+    : updateInverval_(updateInverval), framerate_(0), curNumFrames_(0), numDrawCalls_(0), curNumDrawCalls_(0)
 {}
 
 void FrameCounter::update(clock::time_point curTime)
 {
     lastUpdateTime_ = curTime;
+    numDrawCalls_ = curNumDrawCalls_;
+    curNumDrawCalls_ = 0;
     if(curNumFrames_ == 0)
         curStartTime_ = curTime;
     else
@@ -19,6 +19,7 @@ private:
     clock::duration updateInverval_; /// How often the FPS are updated
     unsigned framerate_;             /// Current FPS
     unsigned curNumFrames_;
+    unsigned numDrawCalls_, curNumDrawCalls_; /// Draw calls of the last and the current frame
     clock::time_point curStartTime_, lastUpdateTime_;
 
 public:
@@ -35,6 +36,10 @@ public:
     /// Return length of current intervall (start of the intervall until the last update call)
     clock::duration getCurIntervalLength() const { return lastUpdateTime_ - curStartTime_; }
     clock::duration getUpdateInterval() const { return updateInverval_; }
+    /// To be called for draw calls issued in the current frame
+    void addDrawCalls(unsigned count) { curNumDrawCalls_ += count; }
+    /// Get the number of draw calls of the last frame
+    unsigned getNumDrawCalls() const { return numDrawCalls_; }
 };
 
 class FrameTimer
@@ -7,6 +7,7 @@
 #include "EventManager.h"
 #include "GameInterface.h"
 #include "GamePlayer.h"
+#include "WorkerPool.h"
 #include "addons/AddonEconomyModeGameLength.h"
 #include "addons/const_addons.h"
 #include "ai/AIPlayer.h"
@@ -14,6 +15,8 @@
 #include "network/GameClient.h"
 #include "gameData/GameConsts.h"
 #include <boost/optional.hpp>
+#include <algorithm>
+#include <thread>
 
 Game::Game(GlobalGameSettings settings, unsigned startGF, const std::vector<PlayerInfo>& players)
     : Game(std::move(settings), std::make_unique<EventManager>(startGF), players)
@@ -98,6 +101,27 @@ void Game::RunGF()
         CheckObjective();
 }
 
+void Game::RunAIs(unsigned gf, bool gfisnwf)
+{
+    const auto numAIs = static_cast<unsigned>(aiPlayers_.size());
+    if(numAIs > 1u && !aiWorkers_)
+    {
+        // The calling thread works too
+        const unsigned numThreads = std::min(std::max(std::thread::hardware_concurrency(), 1u), numAIs) - 1u;
+        aiWorkers_ = std::make_unique<WorkerPool>(numThreads);
+    }
+    // Each AI only uses its own state and random generator and the commands are fetched per player.
+    // So the result is the same as running them sequentially
+    const World::AIRunScope aiRunScope(world_);
+    if(aiWorkers_)
+        aiWorkers_->Run(numAIs, [this, gf, gfisnwf](unsigned i) { aiPlayers_[i].RunGF(gf, gfisnwf); });
+    else
+    {
+        for(AIPlayer& ai : aiPlayers_)
+            ai.RunGF(gf, gfisnwf);
+    }
+}
+
 void Game::StatisticStep()
 {
     for(unsigned i = 0; i < world_.GetNumPlayers(); ++i)
@@ -10,6 +10,7 @@
 #include <memory>
 
 class AIPlayer;
+class WorkerPool;
 
 /// Holds all data for a running game
 class Game
@@ -27,6 +28,8 @@ public:
     /// Does the remaining initializations for starting the game
     void Start(bool startFromSave);
     void RunGF();
+    /// Run the AIs for the current GF. They only read the world and queue their commands, so they run concurrently
+    void RunAIs(unsigned gf, bool gfisnwf);
     bool IsStarted() const { return started_; }
     bool IsGameFinished() const { return finished_; }
     AIPlayer* GetAIPlayer(unsigned id);
@@ -41,4 +44,6 @@ private:
 
     bool started_, finished_;
     std::unique_ptr<LuaInterfaceGame> lua;
+    /// Threads running the AIs, created when there is more than 1 AI
+    std::unique_ptr<WorkerPool> aiWorkers_;
 };
@@ -9,7 +9,16 @@ class SerializedGameData;
 
 class GameEvent
 {
+    friend class EventManager;
+
     const unsigned instanceId; /// unique ID
+    /// Neighbours in the list of events scheduled for the same slot. Managed by the EventManager
+    mutable const GameEvent* prev = nullptr;
+    mutable const GameEvent* next = nullptr;
+    /// Neighbours in the list of events of the object. Managed by the EventManager
+    mutable const GameEvent* objPrev = nullptr;
+    mutable const GameEvent* objNext = nullptr;
+
 public:
     /// Object that will handle this event
     GameObject* obj;
@@ -12,11 +12,14 @@
 class SerializedGameData;
 class GameWorld;
 class EventManager;
+class GameEvent;
 class PostMsg;
 
 /// Basisklasse für alle Spielobjekte
 class GameObject
 {
+    friend class EventManager;
+
 public:
     GameObject();
     GameObject(SerializedGameData& sgd, unsigned obj_id);
@@ -48,6 +51,10 @@ protected:
 
 private:
     unsigned objId; /// unique ID
+    /// Set while the object is in the kill list of the EventManager
+    bool isInKillList = false;
+    /// Most recently added event of this object, others are linked via GameEvent::objNext. Managed by the EventManager
+    const GameEvent* lastAddedEvent = nullptr;
 
     // Static members
 public:
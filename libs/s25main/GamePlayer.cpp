@@ -322,10 +322,7 @@ nobBaseWarehouse* GamePlayer::FindWarehouse(const noRoadNode& start, const T_IsW
                                             bool to_wh, bool use_boat_roads, unsigned* length,
                                             const RoadSegment* forbidden) const
 {
-    nobBaseWarehouse* best = nullptr;
-
-    unsigned best_length = std::numeric_limits<unsigned>::max();
-
+    std::vector<nobBaseWarehouse*> candidates;
     for(nobBaseWarehouse* wh : buildings.GetStorehouses())
     {
         // Lagerhaus geeignet?
@@ -340,29 +337,20 @@ nobBaseWarehouse* GamePlayer::FindWarehouse(const noRoadNode& start, const T_IsW
                 *length = 0;
             return wh;
         }
-
-        // now check if there is at least a chance that the next wh is closer than current best because pathfinding
-        // takes time
-        if(world.CalcDistance(start.GetPos(), wh->GetPos()) > best_length)
-            continue;
-        // Bei der erlaubten Benutzung von Bootsstraßen Waren-Pathfinding benutzen wenns zu nem Lagerhaus gehn soll
-        // start <-> ziel tauschen bei der wegfindung
-        unsigned tlength;
-        if(world.GetRoadPathFinder().FindPath(to_wh ? start : *wh, to_wh ? *wh : start, use_boat_roads, best_length,
-                                              forbidden, &tlength))
-        {
-            if(tlength < best_length || !best)
-            {
-                best_length = tlength;
-                best = wh;
-            }
-        }
+        candidates.push_back(wh);
     }
 
+    // Search all at once and take the nearest one (the first of those with the same costs)
+    // Bei der erlaubten Benutzung von Bootsstraßen Waren-Pathfinding benutzen wenns zu nem Lagerhaus gehn soll
+    const std::vector<const noRoadNode*> goals(candidates.begin(), candidates.end());
+    unsigned best_length = std::numeric_limits<unsigned>::max();
+    const int bestIdx = world.GetRoadPathFinder().FindBestGoal(start, goals, use_boat_roads, !to_wh,
+                                                               best_length, forbidden, &best_length);
+
     if(length)
         *length = best_length;
 
-    return best;
+    return bestIdx >= 0 ? candidates[bestIdx] : nullptr;
 }
 
 void GamePlayer::AddBuildingSite(noBuildingSite* bldSite)
@@ -395,6 +383,8 @@ void GamePlayer::AddBuilding(noBuilding* bld, BuildingType bldType)
         // Schiff durchgehen und denen Bescheid sagen
         for(noShip* ship : ships)
             ship->NewHarborBuilt(static_cast<nobHarborBuilding*>(bld));
+        // New ship connections
+        world.GetRoadPathFinder().OnRoadNetworkChanged();
     } else if(bldType == BuildingType::Headquarters)
         hqPos = bld->GetPos();
     else if(BuildingProperties::IsMilitary(bldType))
@@ -1013,12 +1003,46 @@ noBaseBuilding* GamePlayer::FindClientForWare(const Ware& ware)
     // sort our clients, highest score first
     std::sort(possibleClients.begin(), possibleClients.end());
 
+    // Get the path lengths to all clients at once. Only paths to clients with a score above 0 are of interest
+    // (see below) and once a client with a score is reached, farther clients can't get a better score.
+    // A client at the location of the ware is never chosen as there is no route to it (like in FindPathForWareOnRoads)
+    std::vector<const noRoadNode*> clientNodes;
+    std::vector<unsigned> clientIdxs;
+    clientNodes.reserve(possibleClients.size());
+    clientIdxs.reserve(possibleClients.size());
+    unsigned maxPoints = 0;
+    for(unsigned i = 0; i < possibleClients.size(); i++)
+    {
+        if(possibleClients[i].bld == start)
+            continue;
+        clientNodes.push_back(possibleClients[i].bld);
+        clientIdxs.push_back(i);
+        maxPoints = std::max(maxPoints, possibleClients[i].points);
+    }
+    std::vector<unsigned> pathLengths(possibleClients.size(), std::numeric_limits<unsigned>::max());
+    if(maxPoints > 0)
+    {
+        unsigned maxScore = 0;
+        const auto onClientReached = [&possibleClients, &clientIdxs, &maxScore, maxPoints](unsigned idx,
+                                                                                          unsigned pathLength) {
+            const unsigned points = possibleClients[clientIdxs[idx]].points;
+            if(points > pathLength / 2)
+                maxScore = std::max(maxScore, points - pathLength / 2);
+            // Paths longer than this lead to a score lower than the current maximum
+            return maxScore ? (maxPoints - maxScore) * 2 + 1 : maxPoints * 2 - 1;
+        };
+        const std::vector<unsigned> clientDistances = world.GetRoadPathFinder().FindDistances(
+          *start, clientNodes, true, false, maxPoints * 2 - 1, nullptr, onClientReached);
+        for(unsigned i = 0; i < clientDistances.size(); i++)
+            pathLengths[clientIdxs[i]] = clientDistances[i];
+    }
+
     noBaseBuilding* lastBld = nullptr;
     noBaseBuilding* bestBld = nullptr;
     unsigned best_points = 0;
-    for(auto& possibleClient : possibleClients)
+    for(unsigned i = 0; i < possibleClients.size(); i++)
     {
-        unsigned path_length;
+        const ClientForWare& possibleClient = possibleClients[i];
 
         // If our estimate is worse (or equal) best_points, the real value cannot be better.
         // As our list is sorted, further entries cannot be better either, so stop searching.
@@ -1035,16 +1059,14 @@ noBaseBuilding* GamePlayer::FindClientForWare(const Ware& ware)
         if(possibleClient.points < best_points + 1)
             continue;
 
-        // Find path ONLY if it may be better. Pathfinding is limited to the worst path score that would lead to a
-        // better score. This eliminates the worst case scenario where all nodes in a split road network would be hit by
-        // the pathfinding only to conclude that there is no possible path.
-        if(world.FindPathForWareOnRoads(*start, *possibleClient.bld, &path_length, nullptr,
-                                        (possibleClient.points - best_points) * 2 - 1)
-           != RoadPathDirection::None)
+        // Use the path ONLY if it may be better: Its length is limited to the worst path score that would lead to a
+        // better score. Unknown path lengths are longer than any path to a client with the best score.
+        const unsigned path_length = pathLengths[i];
+        if(path_length <= (possibleClient.points - best_points) * 2 - 1)
         {
             unsigned score = possibleClient.points - (path_length / 2);
 
-            // As we have limited our pathfinding to take a maximum of (points - best_points) * 2 - 1 steps,
+            // As we have limited the path length to a maximum of (points - best_points) * 2 - 1 steps,
             // path_length / 2 can at most be points - best_points - 1, so the score will be greater than best_points.
             // :)
             RTTR_Assert(score > best_points);
@@ -1163,6 +1185,17 @@ bool GamePlayer::IsAlly(const unsigned char playerId) const
         return GetPactState(PactType::TreatyOfAlliance, playerId) == PactState::Accepted;
 }
 
+unsigned GamePlayer::GetAllyMask() const
+{
+    unsigned mask = 0;
+    for(unsigned i = 0; i < world.GetNumPlayers(); ++i)
+    {
+        if(IsAlly(i))
+            mask |= 1u << i;
+    }
+    return mask;
+}
+
 bool GamePlayer::IsAttackable(const unsigned char playerId) const
 {
     // Verbündete dürfen nicht angegriffen werden
@@ -1738,14 +1771,40 @@ bool GamePlayer::IsWareDependent(const Ware& ware)
     return false;
 }
 
+template<typename T>
+void GamePlayer::ToggleInventoryHash(const T type)
+{
+    world.GetStateHash().ToggleInventory(GetPlayerId(), type, global_inventory[type]);
+}
+
 void GamePlayer::IncreaseInventoryWare(const GoodType ware, const unsigned count)
 {
-    global_inventory.Add(ConvertShields(ware), count);
+    const GoodType good = ConvertShields(ware);
+    ToggleInventoryHash(good);
+    global_inventory.Add(good, count);
+    ToggleInventoryHash(good);
 }
 
 void GamePlayer::DecreaseInventoryWare(const GoodType ware, const unsigned count)
 {
-    global_inventory.Remove(ConvertShields(ware), count);
+    const GoodType good = ConvertShields(ware);
+    ToggleInventoryHash(good);
+    global_inventory.Remove(good, count);
+    ToggleInventoryHash(good);
+}
+
+void GamePlayer::IncreaseInventoryJob(const Job job, const unsigned count)
+{
+    ToggleInventoryHash(job);
+    global_inventory.Add(job, count);
+    ToggleInventoryHash(job);
+}
+
+void GamePlayer::DecreaseInventoryJob(const Job job, const unsigned count)
+{
+    ToggleInventoryHash(job);
+    global_inventory.Remove(job, count);
+    ToggleInventoryHash(job);
 }
 
 /// Registriert ein Schiff beim Einwohnermeldeamt
@@ -178,8 +178,8 @@ public:
     /// Fügt Waren zur Inventur hinzu
     void IncreaseInventoryWare(GoodType ware, unsigned count);
     void DecreaseInventoryWare(GoodType ware, unsigned count);
-    void IncreaseInventoryJob(const Job job, unsigned count) { global_inventory.Add(job, count); }
-    void DecreaseInventoryJob(const Job job, unsigned count) { global_inventory.Remove(job, count); }
+    void IncreaseInventoryJob(Job job, unsigned count);
+    void DecreaseInventoryJob(Job job, unsigned count);
 
     /// Gibt Inventory-Settings zurück
     const Inventory& GetInventory() const { return global_inventory; }
@@ -197,6 +197,8 @@ public:
     bool IsAttackable(unsigned char playerId) const;
     /// Are these players allied? (-> Teamview, attack support, ...)
     bool IsAlly(unsigned char playerId) const;
+    /// Return a bitmask with the bit of each player set that this player is allied with (including itself)
+    unsigned GetAllyMask() const;
     /// Order troops of each rank according to `counts` without exceeding `total_max` in total
     void OrderTroops(nobMilitary* goal, std::array<unsigned, NUM_SOLDIER_RANKS> counts, unsigned total_max) const;
     /// Prüft die Besatzung von allen Militärgebäuden und reguliert entsprechend (bei Veränderung der
@@ -426,6 +428,9 @@ private:
     bool FindWarehouseForJob(Job job, noRoadNode* goal) const;
     /// Prüft, ob der Spieler besiegt wurde
     void TestDefeat();
+    /// Add or remove the current inventory count of the ware or job to/from the state hash of the world
+    template<typename T>
+    void ToggleInventoryHash(T type);
 
     //////////////////////////////////////////////////////////////////////////
     /// Unsynchronized state (e.g. lua, gui...)
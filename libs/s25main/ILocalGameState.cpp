@@ -0,0 +1,32 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ILocalGameState.h"
+#include "helpers/format.hpp"
+#include "gameData/GameConsts.h"
+#include <chrono>
+#include <cstdint>
+
+std::string ILocalGameState::FormatGFTime(const unsigned numGFs) const
+{
+    using seconds = std::chrono::duration<uint32_t, std::chrono::seconds::period>;
+    using hours = std::chrono::duration<uint32_t, std::chrono::hours::period>;
+    using minutes = std::chrono::duration<uint32_t, std::chrono::minutes::period>;
+    using std::chrono::duration_cast;
+
+    // In Sekunden umrechnen
+    seconds numSeconds = duration_cast<seconds>(numGFs * SPEED_GF_LENGTHS[referenceSpeed]);
+
+    // Angaben rausfiltern
+    hours numHours = duration_cast<hours>(numSeconds);
+    numSeconds -= numHours;
+    minutes numMinutes = duration_cast<minutes>(numSeconds);
+    numSeconds -= numMinutes;
+
+    // ganze Stunden mit dabei? Dann entsprechend anderes format, ansonsten ignorieren wir die einfach
+    if(numHours.count())
+        return helpers::format("%u:%02u:%02u", numHours.count(), numMinutes.count(), numSeconds.count());
+    else
+        return helpers::format("%02u:%02u", numMinutes.count(), numSeconds.count());
+}
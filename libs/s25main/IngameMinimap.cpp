@@ -14,114 +14,96 @@
 
 IngameMinimap::IngameMinimap(const GameWorldViewer& gwv)
     : Minimap(gwv.GetWorld().GetSize()), gwv(gwv), nodes_updated(GetMapSize().x * GetMapSize().y, false),
-      dos(GetMapSize().x * GetMapSize().y, DrawnObject::Invalid), territory(true), houses(true), roads(true)
+      dos(GetMapSize().x * GetMapSize().y, DrawnObject::Invalid), nodeColors(GetMapSize().x * GetMapSize().y),
+      territory(true), houses(true), roads(true)
 {
     CreateMapTexture();
 }
 
 unsigned IngameMinimap::CalcPixelColor(const MapPoint pt, const unsigned t)
 {
-    unsigned color = 0;
-
+    const unsigned idx = GetMMIdx(pt);
     Visibility visibility = gwv.GetVisibility(pt);
 
     if(visibility == Visibility::Invisible)
     {
-        dos[GetMMIdx(pt)] = DrawnObject::Invisible;
-        // Man sieht nichts --> schwarz
-        return 0xFF000000;
-    } else
-    {
-        DrawnObject drawn_object = DrawnObject::Invalid;
+        dos[idx] = DrawnObject::Invisible;
+        return ComposePixelColor(idx, t);
+    }
 
-        const bool fow = (visibility == Visibility::FogOfWar);
+    NodeColors& colors = nodeColors[idx];
+    colors.fow = (visibility == Visibility::FogOfWar);
 
-        unsigned char owner;
-        NodalObjectType noType = NodalObjectType::Nothing;
-        FoW_Type fot = FoW_Type::Nothing;
-        if(!fow)
-        {
-            const MapNode& node = gwv.GetNode(pt);
-            owner = node.owner;
-            if(node.obj)
-                noType = node.obj->GetType();
-        } else
-        {
-            const FoWNode& node = gwv.GetYoungestFOWNode(pt);
-            owner = node.owner;
-            if(node.object)
-                fot = node.object->GetType();
-        }
+    NodalObjectType noType = NodalObjectType::Nothing;
+    FoW_Type fot = FoW_Type::Nothing;
+    if(!colors.fow)
+    {
+        const MapNode& node = gwv.GetNode(pt);
+        colors.owner = node.owner;
+        if(node.obj)
+            noType = node.obj->GetType();
+    } else
+    {
+        const FoWNode& node = gwv.GetYoungestFOWNode(pt);
+        colors.owner = node.owner;
+        if(node.object)
+            fot = node.object->GetType();
+    }
 
-        // Baum an dieser Stelle?
-        if((!fow && noType == NodalObjectType::Tree) || (fow && fot == FoW_Type::Tree)) //-V807
-        {
-            color = VaryBrightness(TREE_COLOR, VARY_TREE_COLOR);
-            drawn_object = DrawnObject::Terrain;
-            // Ggf. mit Spielerfarbe
-            if(owner)
-            {
-                drawn_object = DrawnObject::Player;
-                if(territory)
-                    color = CombineWithPlayerColor(color, owner);
-            }
-        }
-        // Granit an dieser Stelle?
-        else if((!fow && noType == NodalObjectType::Granite) || (fow && fot == FoW_Type::Granite))
-        {
-            color = VaryBrightness(GRANITE_COLOR, VARY_GRANITE_COLOR);
-            drawn_object = DrawnObject::Terrain;
-            // Ggf. mit Spielerfarbe
-            if(owner)
-            {
-                drawn_object = DrawnObject::Player;
-                if(territory)
-                    color = CombineWithPlayerColor(color, owner);
-            }
-        }
-        // Ansonsten die jeweilige Terrainfarbe nehmen
+    // Baum an dieser Stelle?
+    if(noType == NodalObjectType::Tree || fot == FoW_Type::Tree)
+    {
+        colors.base[t] = VaryBrightness(TREE_COLOR, VARY_TREE_COLOR);
+        dos[idx] = colors.owner ? DrawnObject::Player : DrawnObject::Terrain;
+    }
+    // Granit an dieser Stelle?
+    else if(noType == NodalObjectType::Granite || fot == FoW_Type::Granite)
+    {
+        colors.base[t] = VaryBrightness(GRANITE_COLOR, VARY_GRANITE_COLOR);
+        dos[idx] = colors.owner ? DrawnObject::Player : DrawnObject::Terrain;
+    }
+    // Ansonsten die jeweilige Terrainfarbe nehmen
+    else
+    {
+        colors.base[t] = CalcTerrainColor(pt, t);
+        if(!colors.owner)
+            dos[idx] = DrawnObject::Terrain;
+        // Building?
+        else if(noType == NodalObjectType::Building || noType == NodalObjectType::Buildingsite
+                || fot == FoW_Type::Building || fot == FoW_Type::Buildingsite)
+            dos[idx] = DrawnObject::Buidling;
+        /// Roads?
+        else if(IsRoad(pt, visibility))
+            dos[idx] = DrawnObject::Road;
+        // ansonsten normales Territorium
         else
-        {
-            // Ggf. Spielerfarbe mit einberechnen, falls das von einem Spieler ein Territorium ist
-            if(owner)
-            {
-                // Building?
-                if(((!fow && (noType == NodalObjectType::Building || noType == NodalObjectType::Buildingsite))
-                    || (fow && (fot == FoW_Type::Building || fot == FoW_Type::Buildingsite))))
-                    drawn_object = DrawnObject::Buidling;
-                /// Roads?
-                else if(IsRoad(pt, visibility))
-                    drawn_object = DrawnObject::Road;
-                // ansonsten normales Territorium?
-                else
-                    drawn_object = DrawnObject::Player;
+            dos[idx] = DrawnObject::Player;
+    }
 
-                if(drawn_object == DrawnObject::Buidling && houses)
-                    color = BUILDING_COLOR;
-                /// Roads?
-                else if(drawn_object == DrawnObject::Road && roads)
-                    color = ROAD_COLOR;
-                // ansonsten normales Territorium?
-                else if(territory)
-                    // Normales Terrain und Spielerfarbe berechnen
-                    color = CombineWithPlayerColor(CalcTerrainColor(pt, t), owner);
-                else
-                    // Normales Terrain berechnen
-                    color = CalcTerrainColor(pt, t);
-            } else
-            {
-                // Normales Terrain berechnen
-                color = CalcTerrainColor(pt, t);
-                drawn_object = DrawnObject::Terrain;
-            }
-        }
+    return ComposePixelColor(idx, t);
+}
 
-        // Bei FOW die Farben abdunkeln
-        if(fow)
-            color = MakeColor(0xFF, GetRed(color) / 2, GetGreen(color) / 2, GetBlue(color) / 2);
+unsigned IngameMinimap::ComposePixelColor(const unsigned idx, const unsigned t) const
+{
+    const DrawnObject drawn_object = dos[idx];
+    // Man sieht nichts --> schwarz
+    if(drawn_object == DrawnObject::Invisible || drawn_object == DrawnObject::Invalid)
+        return 0xFF000000;
 
-        dos[GetMMIdx(pt)] = drawn_object;
-    }
+    const NodeColors& colors = nodeColors[idx];
+    unsigned color;
+    if(drawn_object == DrawnObject::Buidling && houses)
+        color = BUILDING_COLOR;
+    else if(drawn_object == DrawnObject::Road && roads)
+        color = ROAD_COLOR;
+    else if(drawn_object != DrawnObject::Terrain && territory)
+        color = CombineWithPlayerColor(colors.base[t], colors.owner);
+    else
+        color = colors.base[t];
+
+    // Bei FOW die Farben abdunkeln
+    if(colors.fow)
+        color = MakeColor(0xFF, GetRed(color) / 2, GetGreen(color) / 2, GetBlue(color) / 2);
 
     return color;
 }
@@ -249,13 +231,13 @@ void IngameMinimap::UpdateAll(const DrawnObject drawn_object)
     {
         for(unsigned t = 0; t < 2; ++t)
         {
-            if(dos[GetMMIdx(pt)] == drawn_object
+            const unsigned idx = GetMMIdx(pt);
+            if(dos[idx] == drawn_object
                || (drawn_object == DrawnObject::Player && // for DrawnObject::Player check for not drawn buildings or
                                                           // roads as there is only the player territory visible
-                   ((dos[GetMMIdx(pt)] == DrawnObject::Buidling && !houses)
-                    || (dos[GetMMIdx(pt)] == DrawnObject::Road && !roads))))
+                   ((dos[idx] == DrawnObject::Buidling && !houses) || (dos[idx] == DrawnObject::Road && !roads))))
             {
-                unsigned color = CalcPixelColor(pt, t);
+                unsigned color = ComposePixelColor(idx, t);
                 DrawPoint texPos((pt.x * 2 + t + (pt.y & 1)) % (GetMapSize().x * 2), pt.y);
                 map.updatePixel(texPos, libsiedler2::ColorBGRA(color));
             }
@@ -6,6 +6,7 @@
 
 #include "Minimap.h"
 #include "gameTypes/MapTypes.h"
+#include <array>
 #include <vector>
 
 class GameWorldViewer;
@@ -33,6 +34,18 @@ class IngameMinimap : public Minimap
 
     std::vector<DrawnObject> dos;
 
+    /// Colors of the layers of a node, so the pixels can be recomposed without querying the world again
+    struct NodeColors
+    {
+        /// Color of terrain, tree or granite for both triangles
+        std::array<unsigned, 2> base;
+        /// Owner of the node (+1, 0 = none)
+        unsigned char owner;
+        /// Node is in fog of war
+        bool fow;
+    };
+    std::vector<NodeColors> nodeColors;
+
     /// Einzelne Dinge anzeigen oder nicht anzeigen
     bool territory; /// Länder der Spieler
     bool houses;    /// Häuser
@@ -55,6 +68,8 @@ public:
 protected:
     /// Berechnet die Farbe für einen bestimmten Pixel der Minimap (t = Terrain1 oder 2)
     unsigned CalcPixelColor(MapPoint pt, unsigned t) override;
+    /// Berechnet die Farbe eines Pixels aus den gespeicherten Farben der einzelnen Ebenen und den aktuellen Schaltern
+    unsigned ComposePixelColor(unsigned idx, unsigned t) const;
     /// Berechnet für einen bestimmten Punkt und ein Dreieck die normale Terrainfarbe
     unsigned CalcTerrainColor(MapPoint pt, unsigned t);
     /// Prüft ob an einer Stelle eine Straße gezeichnet werden muss
@@ -65,5 +80,6 @@ protected:
     /// in dem Falle: Karte aktualisieren
     void BeforeDrawing() override;
     /// Alle Punkte Updaten, bei denen das DrawnObject gleich dem übergebenen drawn_object ist
+    /// Uses the stored layer colors, so only the affected pixels are recomposed and uploaded
     void UpdateAll(DrawnObject drawn_object);
 };
@@ -5,10 +5,12 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "Loader.h"
+#include "FileChecksum.h"
 #include "ListDir.h"
 #include "RttrConfig.h"
 #include "Settings.h"
 #include "Timer.h"
+#include "WorkerPool.h"
 #include "addons/const_addons.h"
 #include "commonDefines.h"
 #include "convertSounds.h"
@@ -48,12 +50,15 @@
 #include <boost/pointer_cast.hpp>
 #include <boost/range/adaptor/map.hpp>
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <cstdio>
 #include <iomanip>
 #include <memory>
+#include <set>
 #include <sstream>
 #include <stdexcept>
+#include <thread>
 
 struct Loader::FileEntry
 {
@@ -62,6 +67,35 @@ struct Loader::FileEntry
     ResolvedFile resolvedFile;
 };
 
+/// Checksum of the content of all files of the resolved file including the files in its folders
+static uint32_t CalcChecksumOfResolvedFile(const ResolvedFile& resolvedFile)
+{
+    uint32_t checksum = 0;
+    const auto addFile = [&checksum](const bfs::path& filePath) {
+        checksum = checksum * 31u + CalcChecksumOfBuffer(filePath.filename().string())
+                   + static_cast<uint32_t>(bfs::file_size(filePath)) + CalcChecksumOfFile(filePath);
+    };
+    for(const bfs::path& path : resolvedFile)
+    {
+        if(!bfs::is_directory(path))
+        {
+            addFile(path);
+            continue;
+        }
+        std::vector<bfs::path> folderFiles;
+        for(const auto& entry : bfs::recursive_directory_iterator(path))
+        {
+            if(bfs::is_regular_file(entry.status()))
+                folderFiles.push_back(entry.path());
+        }
+        // Iteration order is unspecified
+        std::sort(folderFiles.begin(), folderFiles.end());
+        for(const bfs::path& filePath : folderFiles)
+            addFile(filePath);
+    }
+    return checksum;
+}
+
 template<typename T>
 static T convertChecked(libsiedler2::ArchivItem* item)
 {
@@ -431,72 +465,91 @@ bool Loader::LoadFilesAtGame(const std::string& mapGfxPath, bool isWinterGFX, co
                              const std::vector<AddonId>& enabledAddons)
 {
     initResourceFolders(nations, enabledAddons);
+    gameFilesChecksum_ = boost::none;
 
     namespace res = s25::resources;
     std::vector<std::string> files = {res::rom_bobs, res::carrier,  res::jobs,     res::boat,
                                       res::boot_z,   res::mis0bobs, res::mis1bobs, res::mis2bobs,
                                       res::mis3bobs, res::mis4bobs, res::mis5bobs};
 
-    const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
+    nation_gfx = nationIcons_ = {};
 
-    if(!LoadFiles(files) || !Load(ResourceId("map_new"), pal5))
+    // All files use the same palette and don't depend on each other, so load them together
+    std::vector<PendingLoad> pendingLoads;
+    for(const std::string& curFile : files)
+    {
+        if(!AddPendingLoad(pendingLoads, config_.ExpandPath(curFile)))
+            return false;
+    }
+    if(!AddPendingLoad(pendingLoads, ResourceId("map_new")))
         return false;
 
-    // Load nation building and icon graphics
-    nation_gfx = nationIcons_ = {};
+    // Nation building and icon graphics
     for(Nation nation : nations)
     {
         const auto resourceSource = getNationResourcesSource(nation, isWinterGFX, config_);
-        if(!Load(resourceSource.buildingsFilePath, pal5) || !Load(resourceSource.iconsFilePath, pal5))
+        if(!AddPendingLoad(pendingLoads, resourceSource.buildingsFilePath)
+           || !AddPendingLoad(pendingLoads, resourceSource.iconsFilePath))
             return false;
-        nation_gfx[nation] = &files_[ResourceId::make(resourceSource.buildingsFilePath)].archive;
-        nationIcons_[nation] = &files_[ResourceId::make(resourceSource.iconsFilePath)].archive;
     }
 
     // TODO: Move to addon folder and make it overwrite existing file
-    if(!LoadResources({"charburner", "charburner_bobs"}))
+    if(!AddPendingLoad(pendingLoads, ResourceId("charburner"))
+       || !AddPendingLoad(pendingLoads, ResourceId("charburner_bobs")))
         return false;
 
     const bfs::path mapGFXFile = config_.ExpandPath(mapGfxPath);
-    if(!Load(mapGFXFile, pal5))
+    if(!AddPendingLoad(pendingLoads, mapGFXFile))
         return false;
+
+    if(!LoadPending(pendingLoads, GetPaletteN("pal5")))
+        return false;
+
+    for(Nation nation : nations)
+    {
+        const auto resourceSource = getNationResourcesSource(nation, isWinterGFX, config_);
+        nation_gfx[nation] = &files_[ResourceId::make(resourceSource.buildingsFilePath)].archive;
+        nationIcons_[nation] = &files_[ResourceId::make(resourceSource.iconsFilePath)].archive;
+    }
     map_gfx = &GetArchive(ResourceId::make(mapGFXFile));
 
     isWinterGFX_ = isWinterGFX;
 
+    // The sprites only depend on these files, the palettes and the season
+    uint32_t checksum = isWinterGFX ? 1u : 0u;
+    for(const PendingLoad& pendingLoad : pendingLoads)
+        checksum = checksum * 31u + CalcChecksumOfResolvedFile(pendingLoad.resolvedFile);
+    for(const ResourceId& paletteId : {ResourceId("pal5"), ResourceId("colors")})
+    {
+        const auto itPalette = files_.find(paletteId);
+        if(itPalette != files_.end())
+            checksum = checksum * 31u + CalcChecksumOfResolvedFile(itPalette->second.resolvedFile);
+    }
+    gameFilesChecksum_ = checksum;
+
     return true;
 }
 
 bool Loader::LoadFiles(const std::vector<std::string>& files)
 {
-    const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
-    // load the files
+    std::vector<PendingLoad> pendingLoads;
     for(const std::string& curFile : files)
     {
-        const bfs::path filePath = config_.ExpandPath(curFile);
-        if(!Load(filePath, pal5))
-        {
-            logger_.write(_("Failed to load %s\n")) % filePath;
+        if(!AddPendingLoad(pendingLoads, config_.ExpandPath(curFile)))
             return false;
-        }
     }
-
-    return true;
+    return LoadPending(pendingLoads, GetPaletteN("pal5"));
 }
 
 bool Loader::LoadResources(const std::vector<ResourceId>& resources)
 {
-    const libsiedler2::ArchivItem_Palette* pal5 = GetPaletteN("pal5");
+    std::vector<PendingLoad> pendingLoads;
     for(const ResourceId& curResource : resources)
     {
-        if(!Load(curResource, pal5))
-        {
-            logger_.write(_("Failed to load %s\n")) % curResource;
+        if(!AddPendingLoad(pendingLoads, curResource))
             return false;
-        }
     }
-
-    return true;
+    return LoadPending(pendingLoads, GetPaletteN("pal5"));
 }
 
 void Loader::fillCaches()
@@ -906,8 +959,11 @@ void Loader::fillCaches()
 
     if(SETTINGS.video.shared_textures)
     {
-        // generate mega texture
-        stp->pack();
+        // generate mega texture, reusing the one from the last game if the files are the same
+        if(gameFilesChecksum_)
+            stp->pack(config_.ExpandPath(s25::folders::cache) / "textures.dat", *gameFilesChecksum_);
+        else
+            stp->pack();
     } else
         stp.reset();
 }
@@ -1001,32 +1057,89 @@ bool Loader::Load(libsiedler2::Archiv& archive, const ResourceId& resId, const l
 }
 
 template<typename T>
-bool Loader::LoadImpl(const T& resIdOrPath, const libsiedler2::ArchivItem_Palette* palette)
+bool Loader::AddPendingLoad(std::vector<PendingLoad>& pendingLoads, const T& resIdOrPath)
 {
-    const auto resolvedFile = archiveLocator_->resolve(resIdOrPath);
+    auto resolvedFile = archiveLocator_->resolve(resIdOrPath);
     if(!resolvedFile)
     {
         logger_.write(_("Failed to resolve resource %1%\n")) % resIdOrPath;
         return false;
     }
-    FileEntry& entry = files_[ResourceId::make(resIdOrPath)];
+    pendingLoads.push_back(PendingLoad{ResourceId::make(resIdOrPath), std::move(resolvedFile)});
+    return true;
+}
+
+bool Loader::LoadPending(const std::vector<PendingLoad>& pendingLoads, const libsiedler2::ArchivItem_Palette* palette)
+{
     // Do we really need to reload or can we reused the loaded version?
-    if(entry.resolvedFile != resolvedFile)
+    // For duplicate ids only the last one matters as it replaces the others
+    std::vector<const PendingLoad*> toLoad;
+    std::set<ResourceId> usedIds;
+    for(auto it = pendingLoads.rbegin(); it != pendingLoads.rend(); ++it)
     {
+        if(!usedIds.insert(it->id).second)
+            continue;
+        const auto itEntry = files_.find(it->id);
+        if(itEntry == files_.end() || itEntry->second.resolvedFile != it->resolvedFile)
+            toLoad.push_back(&*it);
+    }
+    std::reverse(toLoad.begin(), toLoad.end());
+
+    // Decoding is independent per file and the archives are only added to the repo afterwards.
+    // This relies on libsiedler2 only reading the palette and creating the items through the allocator,
+    // which is stateless (GlAllocator) and must not be changed while loading.
+    // Uploading textures happens later on the main thread
+    const auto numFiles = static_cast<unsigned>(toLoad.size());
+    std::vector<libsiedler2::Archiv> archives(numFiles);
+    // Not std::vector<bool> as the elements are written concurrently
+    std::vector<uint8_t> loaded(numFiles, false);
+    // Files after the first failed one are not used, so don't decode them if they weren't started yet
+    std::atomic<unsigned> firstFailed(numFiles);
+    const auto loadFile = [&](unsigned i) {
+        if(i > firstFailed)
+            return;
         try
         {
-            entry.archive = archiveLoader_->load(resolvedFile, palette);
+            archives[i] = archiveLoader_->load(toLoad[i]->resolvedFile, palette);
+            loaded[i] = true;
         } catch(const LoadError&)
         {
+            unsigned curFirstFailed = firstFailed;
+            while(i < curFirstFailed && !firstFailed.compare_exchange_weak(curFirstFailed, i)) {}
+        }
+    };
+    if(numFiles > 1u)
+    {
+        // The calling thread works too
+        WorkerPool workers(std::min(std::max(std::thread::hardware_concurrency(), 1u), numFiles) - 1u);
+        workers.Run(numFiles, loadFile);
+    } else if(numFiles == 1u)
+        loadFile(0);
+
+    // Store the files up to the first error like loading them one after another would
+    for(unsigned i = 0; i < numFiles; i++)
+    {
+        if(!loaded[i])
+        {
+            logger_.write(_("Failed to load %s\n")) % toLoad[i]->id;
             return false;
         }
+        FileEntry& entry = files_[toLoad[i]->id];
+        entry.archive = std::move(archives[i]);
+        RTTR_Assert(!entry.archive.empty());
         // Update how we loaded this
-        entry.resolvedFile = resolvedFile;
+        entry.resolvedFile = toLoad[i]->resolvedFile;
     }
-    RTTR_Assert(!entry.archive.empty());
     return true;
 }
 
+template<typename T>
+bool Loader::LoadImpl(const T& resIdOrPath, const libsiedler2::ArchivItem_Palette* palette)
+{
+    std::vector<PendingLoad> pendingLoads;
+    return AddPendingLoad(pendingLoads, resIdOrPath) && LoadPending(pendingLoads, palette);
+}
+
 bool Loader::Load(const bfs::path& path, const libsiedler2::ArchivItem_Palette* palette)
 {
     return LoadImpl(path, palette);
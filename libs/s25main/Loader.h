@@ -8,6 +8,7 @@
 #include "enum_cast.hpp"
 #include "helpers/MultiArray.h"
 #include "ogl/glSmartBitmap.h"
+#include "resources/ResolvedFile.h"
 #include "resources/ResourceId.h"
 #include "gameTypes/BuildingType.h"
 #include "gameTypes/Direction.h"
@@ -17,6 +18,7 @@
 #include "gameTypes/Nation.h"
 #include "gameData/AnimalConsts.h"
 #include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
 #include <array>
 #include <cstdint>
 #include <map>
@@ -79,7 +81,7 @@ public:
     /// Load files required during a game
     bool LoadFilesAtGame(const std::string& mapGfxPath, bool isWinterGFX, const std::vector<Nation>& nations,
                          const std::vector<AddonId>& enabledAddons);
-    /// Load all given files with the default palette
+    /// Load all given files with the default palette. Independent files are loaded concurrently
     bool LoadFiles(const std::vector<std::string>& files);
     bool LoadResources(const std::vector<ResourceId>& resources);
 
@@ -226,6 +228,19 @@ private:
     /// Load all sounds
     bool LoadSounds();
 
+    /// File to be loaded into the entry with the given id
+    struct PendingLoad
+    {
+        ResourceId id;
+        ResolvedFile resolvedFile;
+    };
+    /// Resolve the file and add it to the pending loads. Return false if it could not be resolved
+    template<typename T>
+    bool AddPendingLoad(std::vector<PendingLoad>& pendingLoads, const T& resIdOrPath);
+    /// Load all pending files concurrently and store them in the loader repo.
+    /// Files already loaded from the same sources are reused. Behaves like loading them one after another:
+    /// The last file for an id is used and files after the first failed one are not stored
+    bool LoadPending(const std::vector<PendingLoad>& pendingLoads, const libsiedler2::ArchivItem_Palette* palette);
     template<typename T>
     bool LoadImpl(const T& resIdOrPath, const libsiedler2::ArchivItem_Palette* palette);
 
@@ -241,6 +256,8 @@ private:
     helpers::EnumArray<libsiedler2::Archiv*, Nation> nationIcons_;
     libsiedler2::Archiv* map_gfx;
     std::unique_ptr<glTexturePacker> stp;
+    /// Checksum of the files loaded by LoadFilesAtGame. Identifies the sprites created by fillCaches
+    boost::optional<uint32_t> gameFilesChecksum_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -130,3 +130,10 @@ unsigned NWFInfo::getLastNWF() const
         throw std::runtime_error("Server is not ready yet");
     return serverInfos_.back().nextNWF;
 }
+
+unsigned NWFInfo::getLastNWFLength() const
+{
+    if(serverInfos_.empty())
+        throw std::runtime_error("Server is not ready yet");
+    return serverInfos_.back().nextNWF - serverInfos_.back().gf;
+}
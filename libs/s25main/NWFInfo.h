@@ -69,6 +69,8 @@ public:
     unsigned getNextNWF() const { return nextNWF_; }
     /// Return the nextNWF from the last serverInfo entry (must exist)
     unsigned getLastNWF() const;
+    /// Return the length of the NWF from the last serverInfo entry (must exist)
+    unsigned getLastNWFLength() const;
     /// Number of NWFs a command is sent in advance (>= 1)
     unsigned getCmdDelay() const { return cmdDelay_; }
 };
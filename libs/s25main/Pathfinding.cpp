@@ -3,7 +3,6 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "GamePlayer.h"
-#include "helpers/EnumRange.h"
 #include "pathfinding/FreePathFinder.h"
 #include "pathfinding/FreePathFinderImpl.h"
 #include "pathfinding/PathConditionHuman.h"
@@ -11,8 +10,8 @@
 #include "pathfinding/PathConditionTrade.h"
 #include "pathfinding/RoadPathFinder.h"
 #include "world/GameWorld.h"
-#include "gameTypes/ShipDirection.h"
 #include "gameData/GameConsts.h"
+#include <utility>
 
 /// Findet einen Weg für Figuren
 helpers::OptionalEnum<Direction> GameWorldBase::FindHumanPath(const MapPoint start, const MapPoint dest,
@@ -20,13 +19,20 @@ helpers::OptionalEnum<Direction> GameWorldBase::FindHumanPath(const MapPoint sta
                                                               unsigned* length, std::vector<Direction>* route) const
 {
     Direction first_dir{};
-    if(GetFreePathFinder().FindPath(start, dest, random_route, max_route, route, length, &first_dir,
-                                    PathConditionHuman(*this)))
+    if(GetFreePathFinder().FindPathCached(FreePathCondition::Human, start, dest, random_route, max_route, route,
+                                          length, &first_dir, PathConditionHuman(*this)))
         return first_dir;
     else
         return boost::none;
 }
 
+bool GameWorldBase::FindHumanPathLength(const MapPoint start, const MapPoint dest, const unsigned max_route,
+                                        unsigned* length) const
+{
+    return GetFreePathFinder().FindPathLengthCached(FreePathCondition::Human, start, dest, max_route, length,
+                                                    PathConditionHuman(*this));
+}
+
 /// Wegfindung für Menschen im Straßennetz
 RoadPathDirection GameWorld::FindHumanPathOnRoads(const noRoadNode& start, const noRoadNode& goal, unsigned* length,
                                                   MapPoint* firstPt, const RoadSegment* const forbidden)
@@ -54,27 +60,38 @@ bool GameWorldBase::FindShipPathToHarbor(const MapPoint start, unsigned harborId
                                          std::vector<Direction>* route, unsigned* length)
 {
     // Find the distance to the furthest harbor from the target harbor and take that as maximum
-    unsigned maxDistance = 0;
+    // Add a few fields reserve
+    const unsigned maxDistance = harborRoutes.GetMaxDistance(harborId, seaId) + 6;
+    const MapPoint dest = GetCoastalPoint(harborId, seaId);
+    // Ships mostly start at harbors, so routes from there are stored
+    const unsigned startIdx = GetIdx(start);
+    if(!harborRoutes.IsRouteStart(startIdx))
+        return FindShipPath(start, dest, maxDistance, route, length);
 
-    for(const auto dir : helpers::EnumRange<ShipDirection>{})
+    // The route depends on the direction the (random) search starts with, which depends on the GF.
+    // Storing it per direction keeps the result the same as a new search, even if the table is empty after loading
+    const Direction startDir = GetFreePathFinder().GetStartDir(start, true);
+    const HarborRouteTable::Route* storedRoute = harborRoutes.FindRoute(startIdx, startDir, harborId, seaId);
+    if(!storedRoute)
     {
-        const std::vector<HarborPos::Neighbor>& neighbors = GetHarborNeighbors(harborId, dir);
-        for(const HarborPos::Neighbor& neighbor : neighbors)
-        {
-            if(IsHarborAtSea(neighbor.id, seaId) && neighbor.distance > maxDistance)
-                maxDistance = neighbor.distance;
-        }
+        HarborRouteTable::Route newRoute;
+        newRoute.found = FindShipPath(start, dest, maxDistance, &newRoute.route, &newRoute.length);
+        storedRoute = &harborRoutes.AddRoute(startIdx, startDir, harborId, seaId, std::move(newRoute));
     }
-    // Add a few fields reserve
-    maxDistance += 6;
-    return FindShipPath(start, GetCoastalPoint(harborId, seaId), maxDistance, route, length);
+    if(!storedRoute->found)
+        return false;
+    if(route)
+        *route = storedRoute->route;
+    if(length)
+        *length = storedRoute->length;
+    return true;
 }
 
 bool GameWorldBase::FindShipPath(const MapPoint start, const MapPoint dest, unsigned maxDistance,
                                  std::vector<Direction>* route, unsigned* length)
 {
-    return GetFreePathFinder().FindPath(start, dest, true, maxDistance, route, length, nullptr,
-                                        PathConditionShip(*this));
+    return GetFreePathFinder().FindPathCached(FreePathCondition::Ship, start, dest, true, maxDistance, route, length,
+                                              nullptr, PathConditionShip(*this));
 }
 
 /// Prüft, ob eine Schiffsroute noch Gültigkeit hat
@@ -4,12 +4,25 @@
 
 #include "Replay.h"
 #include "Savegame.h"
+#include "SerializedGameData.h"
 #include "network/PlayerGameCommands.h"
 #include "gameTypes/MapInfo.h"
 #include <s25util/tmpFile.h>
 #include <boost/filesystem.hpp>
+#include <algorithm>
+#include <future>
+#include <iterator>
 #include <memory>
 #include <mygettext/mygettext.h>
+#include <stdexcept>
+
+namespace {
+/// Values of the compressed flag
+constexpr uint8_t UNCOMPRESSED = 0;
+constexpr uint8_t COMPRESSED = 1;
+/// Compressed followed by the keyframes
+constexpr uint8_t COMPRESSED_WITH_KEYFRAMES = 2;
+} // namespace
 
 std::string Replay::GetSignature() const
 {
@@ -25,7 +38,10 @@ uint16_t Replay::GetVersion() const
 
 //////////////////////////////////////////////////////////////////////////
 
-Replay::Replay() : random_init(0), isRecording_(false), lastGF_(0), lastGfFilePos_(0), mapType_(MapType::OldMap) {}
+Replay::Replay()
+    : random_init(0), isRecording_(false), lastGF_(0), lastGfFilePos_(0), gameDataFilePos_(0),
+      mapType_(MapType::OldMap), keyframeInterval_(0)
+{}
 
 Replay::~Replay() = default;
 
@@ -33,6 +49,15 @@ void Replay::Close()
 {
     file_.Close();
     uncompressedDataFile_.reset();
+    // The keyframe data gets discarded, but must not be written anymore
+    if(pendingKeyframe_.valid())
+    {
+        pendingKeyframe_.wait();
+        pendingKeyframe_ = std::future<unsigned>();
+    }
+    keyframeData_.Close();
+    keyframeDataFile_.reset();
+    keyframes_.clear();
     isRecording_ = false;
     filepath_.clear();
     ClearPlayers();
@@ -45,6 +70,16 @@ bool Replay::StopRecording()
     const unsigned replayDataSize = file_.Tell();
     isRecording_ = false;
     file_.Close();
+    try
+    {
+        FinishKeyframe();
+    } catch(const std::exception&)
+    {
+        // Only that keyframe is lost, the replay is still usable
+    }
+    // Keyframes are only stored in compressed replays
+    const bool hasKeyframes = !keyframes_.empty();
+    keyframeData_.Close();
 
     BinaryFile file;
     if(!file.Open(filepath_, OpenFileMode::OFM_READ))
@@ -65,7 +100,7 @@ bool Replay::StopRecording()
         RTTR_Assert(lastGF == lastGF_);
         compressedReplay.WriteUnsignedInt(lastGF);
         file.ReadUnsignedChar(); // Ignore compressed flag
-        compressedReplay.WriteUnsignedChar(1);
+        compressedReplay.WriteUnsignedChar(hasKeyframes ? COMPRESSED_WITH_KEYFRAMES : COMPRESSED);
 
         // Read and compress remaining data
         const auto uncompressedSize = replayDataSize - file.Tell();
@@ -74,11 +109,13 @@ bool Replay::StopRecording()
         data = CompressedData::compress(data);
         // If the compressed data turns out to be larger than the uncompressed one, bail out
         // This can happen for very short replays
-        if(data.size() >= uncompressedSize)
+        if(data.size() >= uncompressedSize && !hasKeyframes)
             return true;
         compressedReplay.WriteUnsignedInt(uncompressedSize);
         compressedReplay.WriteUnsignedInt(data.size());
         compressedReplay.WriteRawData(data.data(), data.size());
+        if(hasKeyframes)
+            WriteKeyframes(compressedReplay);
 
         // All done. Replace uncompressed replay
         compressedReplay.Close();
@@ -118,7 +155,9 @@ bool Replay::StartRecording(const boost::filesystem::path& filepath, const MapIn
     // Position merken für End-GF
     lastGfFilePos_ = file_.Tell();
     file_.WriteUnsignedInt(lastGF_);
-    file_.WriteUnsignedChar(0); // Compressed flag
+    file_.WriteUnsignedChar(UNCOMPRESSED); // Compressed flag
+    gameDataFilePos_ = file_.Tell();
+    keyframes_.clear();
 
     WritePlayerData(file_);
     WriteGGS(file_);
@@ -197,14 +236,26 @@ bool Replay::LoadGameData(MapInfo& mapInfo)
 {
     try
     {
-        const bool isCompressed = file_.ReadUnsignedChar() != 0;
-        if(isCompressed)
+        const uint8_t compressedFlag = file_.ReadUnsignedChar();
+        keyframes_.clear();
+        if(compressedFlag != UNCOMPRESSED)
         {
             const auto uncompressedSize = file_.ReadUnsignedInt();
             const auto compressedSize = file_.ReadUnsignedInt();
             CompressedData compressedData(uncompressedSize);
             compressedData.data.resize(compressedSize);
             file_.ReadRawData(compressedData.data.data(), compressedSize);
+            if(compressedFlag == COMPRESSED_WITH_KEYFRAMES)
+            {
+                // Only read the index table, the keyframes are loaded on demand
+                keyframes_.resize(file_.ReadUnsignedInt());
+                for(ReplayKeyframe& keyframe : keyframes_)
+                {
+                    keyframe.gf = file_.ReadUnsignedInt();
+                    keyframe.cmdOffset = file_.ReadUnsignedInt();
+                    keyframe.filePos = file_.ReadUnsignedInt();
+                }
+            }
             uncompressedDataFile_ = std::make_unique<TmpFile>(".rpl");
             uncompressedDataFile_->close();
             compressedData.DecompressToFile(uncompressedDataFile_->filePath);
@@ -279,7 +330,8 @@ void Replay::AddGameCommand(unsigned gf, uint8_t player, const PlayerGameCommand
     file_.WriteUnsignedChar(static_cast<uint8_t>(ReplayCommand::Game));
     Serializer ser;
     ser.PushUnsignedChar(player);
-    cmds.Serialize(ser);
+    // Replays keep the Basic format on purpose so existing replays stay readable
+    cmds.Serialize(ser, AsyncChecksum::Version::Basic);
     ser.WriteToFile(file_);
 
     // Sofort rein damit
@@ -323,7 +375,7 @@ void Replay::ReadGameCommand(uint8_t& player, PlayerGameCommands& cmds)
     Serializer ser;
     ser.ReadFromFile(file_);
     player = ser.PopUnsignedChar();
-    cmds.Deserialize(ser);
+    cmds.Deserialize(ser, AsyncChecksum::Version::Basic);
 }
 
 void Replay::UpdateLastGF(unsigned last_gf)
@@ -340,3 +392,143 @@ void Replay::UpdateLastGF(unsigned last_gf)
     file_.Seek(0, SEEK_END);
     lastGF_ = last_gf;
 }
+
+bool Replay::IsKeyframeDue(unsigned gf) const
+{
+    return keyframeInterval_ != 0 && gf != 0 && gf % keyframeInterval_ == 0
+           && (keyframes_.empty() || keyframes_.back().gf < gf);
+}
+
+void Replay::AddKeyframe(unsigned gf, const UsedPRNG& rngState, const SerializedGameData& sgd)
+{
+    RTTR_Assert(IsRecording());
+    RTTR_Assert(keyframes_.empty() || keyframes_.back().gf < gf);
+    if(!file_.IsValid())
+        return;
+
+    // Keyframes are appended to the same file, so only 1 is written at a time
+    FinishKeyframe();
+    if(!keyframeDataFile_)
+    {
+        keyframeDataFile_ = std::make_unique<TmpFile>(".rplkf");
+        keyframeDataFile_->close();
+        if(!keyframeData_.Open(keyframeDataFile_->filePath, OFM_WRITE))
+            throw std::runtime_error("Could not open keyframe file");
+    }
+
+    ReplayKeyframe keyframe;
+    keyframe.gf = gf;
+    keyframe.cmdOffset = file_.Tell() - gameDataFilePos_;
+    // Set by FinishKeyframe
+    keyframe.filePos = 0;
+    keyframes_.push_back(keyframe);
+
+    Serializer ser;
+    rngState.serialize(ser);
+    // Only copy the data during the GF and compress and write it in the background
+    std::vector<char> data(sgd.GetData(), sgd.GetData() + sgd.GetLength());
+    pendingKeyframe_ = std::async(std::launch::async, [this, ser = std::move(ser), data = std::move(data)]() mutable {
+        // Relative to the start of the keyframe data until written to the replay
+        const unsigned filePos = keyframeData_.Tell();
+        ser.WriteToFile(keyframeData_);
+        keyframeData_.WriteUnsignedInt(data.size());
+        data = CompressedData::compress(data);
+        keyframeData_.WriteUnsignedInt(data.size());
+        keyframeData_.WriteRawData(data.data(), data.size());
+        keyframeData_.Flush();
+        return filePos;
+    });
+}
+
+void Replay::FinishKeyframe()
+{
+    if(!pendingKeyframe_.valid())
+        return;
+    // The pending keyframe is always the last one
+    try
+    {
+        keyframes_.back().filePos = pendingKeyframe_.get();
+    } catch(...)
+    {
+        keyframes_.pop_back();
+        throw;
+    }
+}
+
+void Replay::WriteKeyframes(BinaryFile& file)
+{
+    RTTR_Assert(keyframeDataFile_);
+    BinaryFile keyframeData;
+    if(!keyframeData.Open(keyframeDataFile_->filePath, OFM_READ))
+        throw std::runtime_error("Could not open keyframe file");
+    keyframeData.Seek(0, SEEK_END);
+    const unsigned keyframeDataSize = keyframeData.Tell();
+    keyframeData.Seek(0, SEEK_SET);
+
+    // Index table: Number of keyframes followed by GF, command offset and file position of each keyframe
+    const unsigned indexPos = file.Tell();
+    const unsigned keyframeDataPos = indexPos + sizeof(uint32_t) * (1 + 3 * keyframes_.size());
+    file.WriteUnsignedInt(keyframes_.size());
+    for(ReplayKeyframe& keyframe : keyframes_)
+    {
+        keyframe.filePos += keyframeDataPos;
+        file.WriteUnsignedInt(keyframe.gf);
+        file.WriteUnsignedInt(keyframe.cmdOffset);
+        file.WriteUnsignedInt(keyframe.filePos);
+    }
+
+    // Copy in chunks as the data can get big
+    std::vector<char> buffer(1024 * 1024);
+    for(unsigned remaining = keyframeDataSize; remaining > 0;)
+    {
+        const unsigned curSize = std::min<unsigned>(remaining, buffer.size());
+        keyframeData.ReadRawData(buffer.data(), curSize);
+        file.WriteRawData(buffer.data(), curSize);
+        remaining -= curSize;
+    }
+}
+
+const ReplayKeyframe* Replay::FindKeyframe(unsigned gf) const
+{
+    const auto it =
+      std::upper_bound(keyframes_.begin(), keyframes_.end(), gf,
+                       [](unsigned curGF, const ReplayKeyframe& keyframe) { return curGF < keyframe.gf; });
+    return (it == keyframes_.begin()) ? nullptr : &*std::prev(it);
+}
+
+bool Replay::LoadKeyframe(const ReplayKeyframe& keyframe, SerializedGameData& sgd, UsedPRNG& rngState)
+{
+    // The game data might have been decompressed to a temporary file, so use the replay itself
+    BinaryFile file;
+    if(!file.Open(filepath_, OFM_READ))
+    {
+        lastErrorMsg = _("File could not be opened.");
+        return false;
+    }
+    try
+    {
+        file.Seek(keyframe.filePos, SEEK_SET);
+        Serializer ser;
+        ser.ReadFromFile(file);
+        rngState.deserialize(ser);
+        const auto uncompressedSize = file.ReadUnsignedInt();
+        std::vector<char> data(file.ReadUnsignedInt());
+        file.ReadRawData(data.data(), data.size());
+        data = CompressedData::decompress(data, uncompressedSize);
+        sgd.Clear();
+        sgd.PushRawData(data.data(), data.size());
+    } catch(std::runtime_error& e)
+    {
+        lastErrorMsg = e.what();
+        return false;
+    }
+    return true;
+}
+
+void Replay::SeekToKeyframe(const ReplayKeyframe& keyframe)
+{
+    RTTR_Assert(IsReplaying());
+    // Keyframes only exist in compressed replays whose game data got decompressed to the start of a temporary file
+    RTTR_Assert(uncompressedDataFile_);
+    file_.Seek(keyframe.cmdOffset, SEEK_SET);
+}
@@ -5,14 +5,18 @@
 #pragma once
 
 #include "SavedFile.h"
+#include "random/Random.h"
 #include "gameTypes/ChatDestination.h"
 #include "gameTypes/MapType.h"
 #include "s25util/BinaryFile.h"
+#include <future>
 #include <memory>
 #include <string>
+#include <vector>
 
 class MapInfo;
 struct PlayerGameCommands;
+class SerializedGameData;
 class TmpFile;
 
 /// Replay-Command-Art
@@ -23,11 +27,24 @@ enum class ReplayCommand
     Game
 };
 
+/// Game state stored in a replay from which the replay can be continued
+struct ReplayKeyframe
+{
+    /// GF of the state, i.e. before any command of that GF is executed
+    unsigned gf;
+    /// Position of the first command of that GF relative to the start of the game data
+    unsigned cmdOffset;
+    /// Position of the keyframe data in the file
+    unsigned filePos;
+};
+
 /// Holds a replay that is being recorded or was recorded and loaded
 /// It has a header that holds minimal information:
 ///     File header (version etc.), record time, map name, player names, length (last GF), savegame header (if
 ///     applicable)
 /// All game relevant data is stored afterwards
+/// Compressed replays can additionally contain keyframes (compressed snapshots of the game) after the game data
+/// preceded by an index table so a replay can be started at later GFs
 class Replay : public SavedFile
 {
 public:
@@ -72,6 +89,22 @@ public:
 
     unsigned GetLastGF() const { return lastGF_; }
 
+    /// Set the number of GFs between keyframes to record. 0 = No keyframes
+    void SetKeyframeInterval(unsigned interval) { keyframeInterval_ = interval; }
+    /// Return true if a keyframe should be recorded for the given GF
+    bool IsKeyframeDue(unsigned gf) const;
+    /// Add a keyframe for the given GF. Must be called before any command of that GF was added.
+    /// The data is compressed and written in the background
+    void AddKeyframe(unsigned gf, const UsedPRNG& rngState, const SerializedGameData& sgd);
+    /// Keyframes of a loaded replay ordered by GF
+    const std::vector<ReplayKeyframe>& GetKeyframes() const { return keyframes_; }
+    /// Return the last keyframe at or before the given GF or nullptr if there is none
+    const ReplayKeyframe* FindKeyframe(unsigned gf) const;
+    /// Load the game state of the keyframe
+    bool LoadKeyframe(const ReplayKeyframe& keyframe, SerializedGameData& sgd, UsedPRNG& rngState);
+    /// Continue reading the commands from the keyframe on
+    void SeekToKeyframe(const ReplayKeyframe& keyframe);
+
     /// Zufallsgeneratorinitialisierung
     unsigned random_init;
 
@@ -85,5 +118,20 @@ protected:
     unsigned lastGF_;
     /// Position des End-GF in der Datei
     unsigned lastGfFilePos_;
+    /// Position of the game data (after the compressed flag) in the file while recording
+    unsigned gameDataFilePos_;
     MapType mapType_;
+    unsigned keyframeInterval_;
+    std::vector<ReplayKeyframe> keyframes_;
+    /// Holds the keyframe data while recording as it is only appended when the recording is finished
+    std::unique_ptr<TmpFile> keyframeDataFile_;
+    BinaryFile keyframeData_;
+    /// Position of the keyframe being written in the background.
+    /// Must be declared after the data it writes so it is destroyed (i.e. waited for) first
+    std::future<unsigned> pendingKeyframe_;
+
+    /// Wait for the keyframe written in the background (if any) and store its position.
+    /// Rethrows errors of writing it after dropping it
+    void FinishKeyframe();
+    void WriteKeyframes(BinaryFile& file);
 };
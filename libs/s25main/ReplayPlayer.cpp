@@ -0,0 +1,115 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "ReplayPlayer.h"
+#include "AsyncChecksum.h"
+#include "EventManager.h"
+#include "Game.h"
+#include "GamePlayer.h"
+#include "PlayerInfo.h"
+#include "network/PlayerGameCommands.h"
+#include "random/Random.h"
+#include "world/GameWorld.h"
+#include "world/MapLoader.h"
+#include "gameTypes/MapInfo.h"
+#include "s25util/tmpFile.h"
+#include <stdexcept>
+#include <vector>
+
+ReplayPlayer::ReplayPlayer(const boost::filesystem::path& replayPath) : playerId_(0), nextGF_(0), isFinished_(false)
+{
+    MapInfo mapInfo;
+    if(!replay_.LoadHeader(replayPath) || !replay_.LoadGameData(mapInfo))
+        throw std::runtime_error("Invalid replay: " + replay_.GetLastErrorMsg());
+    if(mapInfo.savegame)
+        throw std::runtime_error("Replays started from a savegame are not supported");
+    TmpFile mapFile;
+    mapFile.close();
+    if(!mapInfo.mapData.DecompressToFile(mapFile.filePath))
+        throw std::runtime_error("Could not decompress the map");
+
+    std::vector<PlayerInfo> players;
+    for(unsigned i = 0; i < replay_.GetNumPlayers(); i++)
+        players.emplace_back(replay_.GetPlayer(i));
+    game_ = std::make_unique<Game>(replay_.ggs, /*startGF*/ 0, players);
+    RANDOM.Init(replay_.random_init);
+    GameWorld& gameWorld = game_->world_;
+
+    for(unsigned i = 0; i < gameWorld.GetNumPlayers(); ++i)
+        gameWorld.GetPlayer(i).MakeStartPacts();
+
+    MapLoader loader(gameWorld);
+    if(!loader.Load(mapFile.filePath))
+        throw std::runtime_error("Could not load the map");
+    if(mapInfo.luaData.uncompressedLength)
+    {
+        TmpFile luaFile(".lua");
+        luaFile.close();
+        if(!mapInfo.luaData.DecompressToFile(luaFile.filePath)
+           || !loader.LoadLuaScript(*game_, *this, luaFile.filePath))
+            throw std::runtime_error("Could not load the lua script");
+    }
+    gameWorld.SetupResources();
+    gameWorld.InitAfterLoad();
+
+    // Same player as chosen by the GameClient: First human player or first AI if there is none
+    bool playerFound = false;
+    for(unsigned i = 0; i < players.size() && !playerFound; ++i)
+    {
+        if(players[i].ps == PlayerState::Occupied)
+        {
+            playerId_ = i;
+            playerFound = true;
+        }
+    }
+    for(unsigned i = 0; i < players.size() && !playerFound; ++i)
+    {
+        if(players[i].ps == PlayerState::AI)
+        {
+            playerId_ = i;
+            playerFound = true;
+        }
+    }
+
+    game_->Start(false);
+    isFinished_ = !replay_.ReadGF(&nextGF_);
+}
+
+ReplayPlayer::~ReplayPlayer() = default;
+
+bool ReplayPlayer::RunGF()
+{
+    const unsigned curGF = game_->em_->GetCurrentGF();
+    bool isInSync = true;
+    if(!isFinished_ && nextGF_ == curGF)
+    {
+        // Checksum is taken before executing the commands, same as when the replay was recorded
+        const AsyncChecksum checksum = AsyncChecksum::create(*game_);
+        do
+        {
+            const ReplayCommand rc = replay_.ReadRCType();
+            if(rc == ReplayCommand::Chat)
+            {
+                uint8_t player, dest;
+                std::string message;
+                replay_.ReadChatCommand(player, dest, message);
+            } else if(rc == ReplayCommand::Game)
+            {
+                PlayerGameCommands msg;
+                uint8_t gcPlayer;
+                replay_.ReadGameCommand(gcPlayer, msg);
+                for(const gc::GameCommandPtr& gc : msg.gcs)
+                    gc->Execute(game_->world_, gcPlayer);
+                if(msg.checksum.randChecksum != 0 && msg.checksum != checksum)
+                    isInSync = false;
+            }
+            if(!replay_.ReadGF(&nextGF_))
+                isFinished_ = true;
+            else if(nextGF_ > replay_.GetLastGF())
+                throw std::runtime_error("Invalid GF in replay: " + std::to_string(nextGF_));
+        } while(!isFinished_ && nextGF_ == curGF);
+    }
+    game_->RunGF();
+    return isInSync;
+}
@@ -0,0 +1,45 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "ILocalGameState.h"
+#include "Replay.h"
+#include <boost/filesystem/path.hpp>
+#include <memory>
+
+class Game;
+
+/// Runs a replay without GUI and network, e.g. for tests and benchmarks.
+/// Lua scripts of the map are loaded but must not show windows (e.g. MsgBox) unless the GUI is initialized
+class ReplayPlayer : public ILocalGameState
+{
+public:
+    /// Load the replay and the game. Throws a std::runtime_error on failure
+    explicit ReplayPlayer(const boost::filesystem::path& replayPath);
+    ReplayPlayer(const ReplayPlayer&) = delete;
+    ReplayPlayer& operator=(const ReplayPlayer&) = delete;
+    ~ReplayPlayer() override;
+
+    Game& GetGame() { return *game_; }
+    const Replay& GetReplay() const { return replay_; }
+    /// True if all commands were executed
+    bool IsFinished() const { return isFinished_; }
+    /// Execute the commands of the current GF and run it.
+    /// Return false if the checksum of any command did not match, i.e. the game is asynchronous
+    bool RunGF();
+
+    unsigned GetPlayerId() const override { return playerId_; }
+    bool IsHost() const override { return false; }
+    void SystemChat(const std::string&) override {}
+
+private:
+    Replay replay_;
+    std::unique_ptr<Game> game_;
+    /// Player to view the game from (see GameClient::StartReplay)
+    unsigned playerId_;
+    /// GF of the next command
+    unsigned nextGF_;
+    bool isFinished_;
+};
@@ -68,19 +68,22 @@ void RoadSegment::Destroy()
 
         for(unsigned short i = 0; i < route.size() + 1; ++i)
         {
-            // Figuren sammeln
+            // Figuren sammeln (first collect them as they may start walking which could change the figures)
+            std::vector<noFigure*> figures;
             for(noBase& object : world->GetFigures(pt))
             {
                 if(object.GetType() == NodalObjectType::Figure)
                 {
                     auto& figure = static_cast<noFigure&>(object);
                     if(figure.GetCurrentRoad() == this)
-                    {
-                        figure.Abrogate();
-                        figure.StartWandering();
-                    }
+                        figures.push_back(&figure);
                 }
             }
+            for(noFigure* figure : figures)
+            {
+                figure->Abrogate();
+                figure->StartWandering();
+            }
 
             world->RoadNodeAvailable(pt);
 
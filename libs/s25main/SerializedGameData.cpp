@@ -96,7 +96,8 @@
 /// 8: noFlag::Wares converted to static_vector
 /// 9: Drop serialization of node BQ
 /// 10: troop_limits state introduced to military buildings
-static const unsigned currentGameDataVersion = 10;
+/// 11: Points pending for the Lua batch events onExploredBatch/onOccupiedBatch
+static const unsigned currentGameDataVersion = 11;
 // clang-format on
 
 std::unique_ptr<GameObject> SerializedGameData::Create_GameObject(const GO_Type got, const unsigned obj_id)
@@ -400,7 +401,9 @@ const GameEvent* SerializedGameData::PopEvent()
     const auto foundObj = readEvents.find(instanceId);
     if(foundObj != readEvents.end())
         return foundObj->second;
-    std::unique_ptr<GameEvent> ev = std::make_unique<GameEvent>(*this, instanceId);
+    RTTR_Assert(em);
+    // Memory is owned by the EventManager even if this fails
+    const GameEvent* ev = em->CreateSerializedEvent(*this, instanceId);
 
     unsigned short safety_code = PopUnsignedShort();
 
@@ -410,7 +413,7 @@ const GameEvent* SerializedGameData::PopEvent()
           % instanceId;
         throw Error("Invalid safety code after PopEvent");
     }
-    return ev.release();
+    return ev;
 }
 
 /// FoW-Objekt
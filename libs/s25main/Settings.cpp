@@ -138,6 +138,7 @@ void Settings::LoadDefaults()
     // interface
     // {
     interface.autosave_interval = 0;
+    interface.replay_keyframe_interval = 0;
     interface.revert_mouse = false;
     // }
 
@@ -295,6 +296,7 @@ void Settings::Load()
         // interface
         // {
         interface.autosave_interval = iniInterface->getIntValue("autosave_interval");
+        interface.replay_keyframe_interval = iniInterface->getValue("replay_keyframe_interval", 0);
         interface.revert_mouse = iniInterface->getBoolValue("revert_mouse");
         // }
 
@@ -451,6 +453,7 @@ void Settings::Save()
     // interface
     // {
     iniInterface->setValue("autosave_interval", interface.autosave_interval);
+    iniInterface->setValue("replay_keyframe_interval", interface.replay_keyframe_interval);
     iniInterface->setValue("revert_mouse", interface.revert_mouse);
     // }
 
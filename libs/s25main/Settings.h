@@ -104,6 +104,8 @@ public:
     struct
     {
         unsigned autosave_interval;
+        /// GFs between keyframes in recorded replays (0 = none, the default)
+        unsigned replay_keyframe_interval;
         bool revert_mouse;
     } interface;
 
@@ -3,33 +3,46 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "TradePathCache.h"
-#include "EventManager.h"
 #include "GamePlayer.h"
 #include "world/GameWorld.h"
 #include "gameData/GameConsts.h"
+#include <boost/container_hash/hash.hpp>
+
+constexpr unsigned TradePathCache::maxEntries;
+
+size_t TradePathCache::KeyHasher::operator()(const Key& key) const
+{
+    size_t result = 0;
+    boost::hash_combine(result, key.pt1.x);
+    boost::hash_combine(result, key.pt1.y);
+    boost::hash_combine(result, key.pt2.x);
+    boost::hash_combine(result, key.pt2.y);
+    boost::hash_combine(result, key.player);
+    return result;
+}
 
 bool TradePathCache::pathExists(const MapPoint start, const MapPoint goal, const unsigned char player)
 {
     RTTR_Assert(start != goal);
 
-    int entryIdx = findEntry(start, goal, player);
-    if(entryIdx >= 0)
+    const boost::optional<Key> key = findEntry(start, goal, player);
+    if(key)
     {
         // Found an entry --> Check if the route is still valid
+        const TradePath& path = *paths.find(*key);
         MapPoint checkedGoal;
-        if(world.CheckTradeRoute(paths[entryIdx].path.start, paths[entryIdx].path.route, 0, player, &checkedGoal))
+        if(world.CheckTradeRoute(path.start, path.route, 0, player, &checkedGoal))
         {
             RTTR_Assert(checkedGoal == start || checkedGoal == goal);
-            paths[entryIdx].lastUse = world.GetEvMgr().GetCurrentGF();
+            ++numHits;
             return true;
         } else
         {
             // TradePath is now invalid -> remove it
-            if(static_cast<unsigned>(entryIdx) != paths.size() - 1u)
-                std::swap(paths[entryIdx], paths.back());
-            paths.pop_back();
+            paths.erase(*key);
         }
     }
+    ++numMisses;
 
     std::vector<Direction> route;
     if(!world.FindTradePath(start, goal, player, std::numeric_limits<unsigned>::max(), false, &route))
@@ -39,41 +52,36 @@ bool TradePathCache::pathExists(const MapPoint start, const MapPoint goal, const
     return true;
 }
 
-int TradePathCache::findEntry(const MapPoint start, const MapPoint goal, const PlayerIdx player) const
+TradePathCache::Key TradePathCache::makeKey(const MapPoint start, const MapPoint goal, const PlayerIdx player) const
+{
+    if(world.GetIdx(start) < world.GetIdx(goal))
+        return Key{start, goal, player};
+    else
+        return Key{goal, start, player};
+}
+
+boost::optional<TradePathCache::Key> TradePathCache::findEntry(const MapPoint start, const MapPoint goal,
+                                                               const PlayerIdx player)
 {
     const GamePlayer& thisPlayer = world.GetPlayer(player);
 
-    for(unsigned i = 0; i < paths.size(); i++)
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
     {
-        const Entry& pathEntry = paths[i];
-        if(pathEntry.path.start != start && pathEntry.path.goal != start)
+        if(!thisPlayer.IsAlly(i))
             continue;
-        if(pathEntry.path.goal != goal && pathEntry.path.start != goal)
-            continue;
-        if(!thisPlayer.IsAlly(pathEntry.player))
-            continue;
-        return i;
+        const Key key = makeKey(start, goal, i);
+        if(paths.find(key))
+            return key;
     }
-    return -1;
+    return boost::none;
 }
 
 void TradePathCache::addEntry(TradePath path, const unsigned char player)
 {
-    Entry entry{player, world.GetEvMgr().GetCurrentGF(), std::move(path)};
-
-    int idx = findEntry(entry.path.start, entry.path.goal, player);
-    if(idx < 0)
-    {
-        // None found --> Find a new spot
-        if(paths.size() < paths.max_size())
-            paths.emplace_back(std::move(entry)); // We got space left --> append
-        else
-        {
-            // No space left --> Replace oldest
-            const auto itOldestElement = std::min_element(
-              paths.begin(), paths.end(), [](const Entry& rhs, const Entry& lhs) { return rhs.lastUse < lhs.lastUse; });
-            *itOldestElement = std::move(entry);
-        }
-    } else
-        paths[idx] = std::move(entry);
+    // Replace the entry of an ally if there is one
+    const boost::optional<Key> oldKey = findEntry(path.start, path.goal, player);
+    if(oldKey)
+        paths.erase(*oldKey);
+    const Key key = makeKey(path.start, path.goal, player);
+    paths.insert(key, std::move(path));
 }
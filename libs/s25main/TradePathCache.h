@@ -4,31 +4,51 @@
 
 #pragma once
 
+#include "helpers/LRUCache.h"
 #include "world/TradePath.h"
-#include <boost/container/static_vector.hpp>
+#include <boost/optional.hpp>
+#include <cstddef>
 
 class GameWorld;
 
+/// Cache for trade paths between 2 flags.
+/// Other than the FreePathCache the entries are revalidated by checking the route as trade paths also depend on the
+/// alliances which can change at any time. Paths of allied players are shared
 class TradePathCache
 {
     using PlayerIdx = unsigned char;
 
-    struct Entry
+    struct Key
     {
+        /// Start and goal ordered by index so both directions use the same key
+        MapPoint pt1, pt2;
         PlayerIdx player;
-        unsigned lastUse;
-        TradePath path;
+
+        bool operator==(const Key& rhs) const { return pt1 == rhs.pt1 && pt2 == rhs.pt2 && player == rhs.player; }
+    };
+    struct KeyHasher
+    {
+        size_t operator()(const Key& key) const;
     };
 
     const GameWorld& world;
-    boost::container::static_vector<Entry, 10> paths;
-    int findEntry(MapPoint start, MapPoint goal, PlayerIdx player) const;
+    helpers::LRUCache<Key, TradePath, KeyHasher> paths;
+    unsigned numHits, numMisses;
+
+    Key makeKey(MapPoint start, MapPoint goal, PlayerIdx player) const;
+    /// Return the key of the entry usable by the player if there is one
+    boost::optional<Key> findEntry(MapPoint start, MapPoint goal, PlayerIdx player);
 
 public:
-    TradePathCache(const GameWorld& world) : world(world) {}
+    static constexpr unsigned maxEntries = 10;
+
+    TradePathCache(const GameWorld& world) : world(world), paths(maxEntries), numHits(0), numMisses(0) {}
 
     void clear() { paths.clear(); }
     unsigned size() const { return paths.size(); }
     bool pathExists(MapPoint start, MapPoint goal, PlayerIdx player);
     void addEntry(TradePath path, PlayerIdx player);
+
+    unsigned getNumHits() const { return numHits; }
+    unsigned getNumMisses() const { return numMisses; }
 };
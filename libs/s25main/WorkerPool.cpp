@@ -0,0 +1,85 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "WorkerPool.h"
+#include <algorithm>
+
+WorkerPool::WorkerPool(unsigned numThreads)
+    : generation_(0), stop_(false), numBusyWorkers_(0), task_(nullptr), numTasks_(0), nextTask_(0)
+{
+    threads_.reserve(numThreads);
+    for(unsigned i = 0; i < numThreads; i++)
+        threads_.emplace_back([this]() { WorkerLoop(); });
+}
+
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    workAvailable_.notify_all();
+    for(std::thread& thread : threads_)
+        thread.join();
+}
+
+void WorkerPool::Run(unsigned numTasks, const Task& task)
+{
+    if(numTasks == 0)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        numTasks_ = numTasks;
+        nextTask_ = 0;
+        errors_.assign(numTasks, nullptr);
+        numBusyWorkers_ = static_cast<unsigned>(threads_.size());
+        ++generation_;
+    }
+    workAvailable_.notify_all();
+    RunTasks();
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        workDone_.wait(lock, [this]() { return numBusyWorkers_ == 0; });
+        task_ = nullptr;
+    }
+    const auto firstError = std::find_if(errors_.begin(), errors_.end(), [](const auto& error) { return !!error; });
+    if(firstError != errors_.end())
+        std::rethrow_exception(*firstError);
+}
+
+void WorkerPool::WorkerLoop()
+{
+    unsigned lastGeneration = 0;
+    while(true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            workAvailable_.wait(lock, [this, lastGeneration]() { return stop_ || generation_ != lastGeneration; });
+            if(stop_)
+                return;
+            lastGeneration = generation_;
+        }
+        RunTasks();
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            --numBusyWorkers_;
+        }
+        workDone_.notify_one();
+    }
+}
+
+void WorkerPool::RunTasks()
+{
+    for(unsigned i = nextTask_++; i < numTasks_; i = nextTask_++)
+    {
+        try
+        {
+            (*task_)(i);
+        } catch(...)
+        {
+            errors_[i] = std::current_exception();
+        }
+    }
+}
@@ -0,0 +1,52 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// Fixed set of threads which run indexed tasks concurrently.
+/// The calling thread takes part in the work, so a pool with 0 threads runs everything sequentially.
+/// Tasks must not change shared state without synchronization. For the AIs see AIInterface for what they may use
+class WorkerPool
+{
+public:
+    using Task = std::function<void(unsigned)>;
+
+    explicit WorkerPool(unsigned numThreads);
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    unsigned GetNumThreads() const { return static_cast<unsigned>(threads_.size()); }
+
+    /// Call task(i) for all i in [0, numTasks) and wait until all are finished.
+    /// If tasks throw, the exception of the task with the lowest index is rethrown after all tasks finished
+    void Run(unsigned numTasks, const Task& task);
+
+private:
+    void WorkerLoop();
+    /// Run tasks until there are none left
+    void RunTasks();
+
+    std::vector<std::thread> threads_;
+    std::mutex mutex_;
+    std::condition_variable workAvailable_, workDone_;
+    /// Incremented for each call to Run, so the workers know there is new work
+    unsigned generation_;
+    bool stop_;
+    /// Number of workers which still run tasks of the current generation
+    unsigned numBusyWorkers_;
+
+    const Task* task_;
+    unsigned numTasks_;
+    std::atomic<unsigned> nextTask_;
+    std::vector<std::exception_ptr> errors_;
+};
@@ -31,6 +31,11 @@ class nobUsual;
 struct Inventory;
 class GameMessage_Chat;
 
+/// Read-only access of an AI to the world. The AIs of a GF run concurrently (see Game::RunAIs), so AI code must not
+/// change the world or its caches, which is asserted in debug builds. In particular:
+/// - The FreePathCache and the RoadLandmarkIndex may only be used through the search functions of the pathfinders,
+///   which serialize concurrent searches. Never clear or invalidate them.
+/// - GetUpToDateBQ may flush BQ updates deferred by a BQUpdateBatch, use the BQ of the node instead
 class AIInterface : public GameCommandFactory
 {
 public:
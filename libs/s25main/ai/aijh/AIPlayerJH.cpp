@@ -163,7 +163,7 @@ static auto createResourceMaps(const AIInterface& aii, const AIMap& aiMap)
 AIPlayerJH::AIPlayerJH(const unsigned char playerId, const GameWorldBase& gwb, const AI::Level level)
     : AIPlayer(playerId, gwb, level), UpgradeBldPos(MapPoint::Invalid()), resourceMaps(createResourceMaps(aii, aiMap)),
       isInitGfCompleted(false), defeated(player.IsDefeated()), bldPlanner(std::make_unique<BuildingPlanner>(*this)),
-      construction(std::make_unique<AIConstruction>(*this))
+      construction(std::make_unique<AIConstruction>(*this)), rng_(rand())
 {
     InitNodes();
     InitResourceMaps();
@@ -344,7 +344,7 @@ void AIPlayerJH::PlanNewBuildings(const unsigned gf)
         DistributeGoodsByBlocking(GoodType::Boards, 30);
         DistributeGoodsByBlocking(GoodType::Stones, 50);
         // go to the picked random warehouse and try to build around it
-        int randomStore = rand() % (storehouses.size());
+        int randomStore = Random() % (storehouses.size());
         auto it = storehouses.begin();
         std::advance(it, randomStore);
         const MapPoint whPos = (*it)->GetPos();
@@ -365,7 +365,7 @@ void AIPlayerJH::PlanNewBuildings(const unsigned gf)
     const std::list<nobMilitary*>& militaryBuildings = aii.GetMilitaryBuildings();
     if(militaryBuildings.empty())
         return;
-    int randomMiliBld = rand() % militaryBuildings.size();
+    int randomMiliBld = Random() % militaryBuildings.size();
     auto it2 = militaryBuildings.begin();
     std::advance(it2, randomMiliBld);
     MapPoint bldPos = (*it2)->GetPos();
@@ -1214,7 +1214,7 @@ void AIPlayerJH::HandleExpedition(const noShip* ship)
         aii.FoundColony(ship);
     else
     {
-        const unsigned offset = rand() % helpers::MaxEnumValue_v<ShipDirection>;
+        const unsigned offset = Random() % helpers::MaxEnumValue_v<ShipDirection>;
         for(auto dir : helpers::EnumRange<ShipDirection>{})
         {
             dir = ShipDirection((rttr::enum_cast(dir) + offset) % helpers::MaxEnumValue_v<ShipDirection>);
@@ -1259,7 +1259,7 @@ void AIPlayerJH::HandleTreeChopped(const MapPoint pt)
 
     UpdateNodesAround(pt, 3);
 
-    int random = rand();
+    int random = Random();
 
     if(random % 2 == 0)
         AddMilitaryBuildJob(pt);
@@ -1543,7 +1543,7 @@ void AIPlayerJH::TryToAttack()
         // We skip the current building with a probability of limit/numMilBlds
         // -> For twice the number of blds as the limit we will most likely skip every 2nd building
         // This way we check roughly (at most) limit buildings but avoid any preference for one building over an other
-        if(rand() % numMilBlds > limit)
+        if(Random() % numMilBlds > limit)
             continue;
 
         if(milBld->GetFrontierDistance() == FrontierDistance::Far) // inland building? -> skip it
@@ -1575,8 +1575,7 @@ void AIPlayerJH::TryToAttack()
     }
 
     // shuffle everything but headquarters and harbors without any troops in them
-    std::shuffle(potentialTargets.begin() + hq_or_harbor_without_soldiers, potentialTargets.end(),
-                 std::mt19937(std::random_device()()));
+    std::shuffle(potentialTargets.begin() + hq_or_harbor_without_soldiers, potentialTargets.end(), rng_);
 
     // check for each potential attacking target the number of available attacking soldiers
     for(const nobBaseMilitary* target : potentialTargets)
@@ -1689,11 +1688,10 @@ void AIPlayerJH::TrySeaAttack()
             // \n",gwb.GetHarborPoint(i).x,gwb.GetHarborPoint(i).y);
         }
     }
-    auto prng = std::mt19937(std::random_device()());
     // any undefendedTargets? -> pick one by random
     if(!undefendedTargets.empty())
     {
-        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), prng);
+        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), rng_);
         for(const nobBaseMilitary* targetMilBld : undefendedTargets)
         {
             std::vector<GameWorldBase::PotentialSeaAttacker> attackers =
@@ -1709,7 +1707,7 @@ void AIPlayerJH::TrySeaAttack()
     unsigned limit = 15;
     unsigned skip = 0;
     if(searcharoundharborspots.size() > 15)
-        skip = std::max<int>(rand() % (searcharoundharborspots.size() / 15 + 1) * 15, 1) - 1;
+        skip = std::max<int>(Random() % (searcharoundharborspots.size() / 15 + 1) * 15, 1) - 1;
     for(unsigned i = skip; i < searcharoundharborspots.size() && limit > 0; i++)
     {
         limit--;
@@ -1746,7 +1744,7 @@ void AIPlayerJH::TrySeaAttack()
     // random
     if(!undefendedTargets.empty())
     {
-        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), prng);
+        std::shuffle(undefendedTargets.begin(), undefendedTargets.end(), rng_);
         for(const nobBaseMilitary* targetMilBld : undefendedTargets)
         {
             std::vector<GameWorldBase::PotentialSeaAttacker> attackers =
@@ -1758,7 +1756,7 @@ void AIPlayerJH::TrySeaAttack()
             }
         }
     }
-    std::shuffle(potentialTargets.begin(), potentialTargets.end(), prng);
+    std::shuffle(potentialTargets.begin(), potentialTargets.end(), rng_);
     for(const nobBaseMilitary* ship : potentialTargets)
     {
         // TODO: decide if it is worth attacking the target and not just "possible"
@@ -2027,7 +2025,7 @@ bool AIPlayerJH::HuntablesinRange(const MapPoint pt, unsigned min)
                     if(!static_cast<const noAnimal&>(fig).CanHunted())
                         continue;
                     // Und komme ich hin?
-                    if(gwb.FindHumanPath(pt, static_cast<const noAnimal&>(fig).GetPos(), maxrange))
+                    if(gwb.FindHumanPathLength(pt, static_cast<const noAnimal&>(fig).GetPos(), maxrange))
                     // Dann nehmen wir es
                     {
                         if(++huntablecount >= min)
@@ -2140,7 +2138,7 @@ bool AIPlayerJH::ValidTreeinRange(const MapPoint pt)
                     // not already getting cut down or a freaking pineapple thingy?
                     if(!gwb.GetNode(t2).reserved && gwb.GetSpecObj<noTree>(t2)->ProducesWood())
                     {
-                        if(gwb.FindHumanPath(pt, t2, 20))
+                        if(gwb.FindHumanPathLength(pt, t2, 20))
                             return true;
                     }
                 }
@@ -2164,7 +2162,7 @@ bool AIPlayerJH::ValidStoneinRange(const MapPoint pt)
                 // point has tree & path is available?
                 if(gwb.GetNO(t2)->GetType() == NodalObjectType::Granite)
                 {
-                    if(gwb.FindHumanPath(pt, t2, 20))
+                    if(gwb.FindHumanPathLength(pt, t2, 20))
                         return true;
                 }
             }
@@ -2323,7 +2321,7 @@ bool AIPlayerJH::ValidFishInRange(const MapPoint pt)
               // try to find a path to a neighboring node on the coast
               for(const MapPoint nb : gwb.GetNeighbours(curPt))
               {
-                  if(gwb.FindHumanPath(pt, nb, 10))
+                  if(gwb.FindHumanPathLength(pt, nb, 10))
                       return true;
               }
           }
@@ -14,6 +14,7 @@
 #include <list>
 #include <memory>
 #include <queue>
+#include <random>
 
 class noFlag;
 class noShip;
@@ -46,6 +47,9 @@ public:
     const BuildingPlanner& GetBldPlanner() const { return *bldPlanner; }
     const AIJob* GetCurrentJob() const { return currentJob.get(); }
     unsigned GetNumJobs() const;
+    /// Random number like rand() but from the generator of this AI.
+    /// So the decisions don't depend on the order in which the AIs run
+    int Random() { return static_cast<int>(rng_()); }
 
     void RunGF(unsigned gf, bool gfisnwf) override;
     void OnChatMessage(unsigned sendPlayerId, ChatDestination, const std::string& msg) override;
@@ -238,6 +242,7 @@ private:
 
     Subscription subBuilding, subExpedition, subResource, subRoad, subShip, subBQ;
     std::vector<MapPoint> nodesWithOutdatedBQ;
+    std::minstd_rand rng_;
 };
 
 } // namespace AIJH
@@ -41,11 +41,14 @@ void AIResourceMap::init()
     const MapExtent mapSize = aiMap.GetSize();
 
     map.Resize(mapSize);
+    ratings.Resize(mapSize);
     // Calculate value for each point.
-    // This is quite expensive so do just for the diminishable resources to sort out ones where there will never be
-    // anything, which allows an optimization when calculating the value which must always be done on demand
+    // This is done just for the diminishable resources to sort out ones where there will never be anything, which
+    // allows an optimization when calculating the value which must always be done on demand
     if(isDiminishableResource)
     {
+        RTTR_FOREACH_PT(MapPoint, mapSize)
+            ratings.Set(pt, aii.GetResourceRating(pt, res));
         RTTR_FOREACH_PT(MapPoint, mapSize)
         {
             bool isValid = true;
@@ -60,17 +63,27 @@ void AIResourceMap::init()
             {
                 isValid = aii.gwb.IsOfTerrain(pt, [](const TerrainDesc& desc) { return desc.Is(ETerrain::Mineable); });
             }
-            map[pt] = isValid ? aii.CalcResourceValue(pt, res) : 0;
+            map[pt] = isValid ? ratings.GetSumInRadius(pt, resRadius) : 0;
         }
     }
 }
 
 void AIResourceMap::updateAround(const MapPoint& pt, int radius)
 {
-    if(isDiminishableResource)
-        updateAroundDiminishable(pt, radius);
-    else
-        updateAroundReplinishable(pt, radius);
+    if(isDiminishableResource && isInfinite)
+        return;
+
+    // The values in the radius depend on all ratings within resRadius of them
+    for(const MapPoint& curPt : aii.gwb.GetPointsInRadiusWithCenter(pt, radius + resRadius))
+        ratings.Set(curPt, aii.GetResourceRating(curPt, res));
+    for(const MapPoint& curPt : aii.gwb.GetPointsInRadiusWithCenter(pt, radius))
+    {
+        int& value = map[curPt];
+        // Diminishable resources never come back, so skip points where there was never anything (or which are avoided)
+        if(isDiminishableResource && !value)
+            continue;
+        value = ratings.GetSumInRadius(curPt, resRadius);
+    }
 }
 
 MapPoint AIResourceMap::findBestPosition(const MapPoint& pt, BuildingQuality size, unsigned radius, int minimum) const
@@ -112,93 +125,4 @@ void AIResourceMap::avoidPosition(const MapPoint& pt)
     map[pt] = 0;
 }
 
-void AIResourceMap::updateAroundDiminishable(const MapPoint& pt, const int radius)
-{
-    if(isInfinite)
-        return;
-
-    bool lastCircleValueCalculated = false;
-    bool lastValueCalculated = false;
-    // to avoid having to calculate a value twice and still move left on the same level without any problems we use this
-    // variable to remember the first calculation we did in the circle.
-    int circleStartValue = 0;
-
-    for(MapCoord tx = aii.gwb.GetXA(pt, Direction::West), r = 1; r <= radius;
-        tx = aii.gwb.GetXA(MapPoint(tx, pt.y), Direction::West), ++r)
-    {
-        MapPoint curPt(tx, pt.y);
-        for(const auto curDir : helpers::enumRange(Direction::NorthEast))
-        {
-            for(MapCoord step = 0; step < r; ++step, curPt = aiMap.GetNeighbour(curPt, curDir))
-            {
-                int& resMapVal = map[curPt];
-                // only do a complete calculation for the first point or when moving outward and the last value is
-                // unknown
-                if((r < 2 || !lastCircleValueCalculated) && step < 1 && curDir == Direction::NorthEast && resMapVal)
-                {
-                    resMapVal = aii.CalcResourceValue(curPt, res);
-                    circleStartValue = resMapVal;
-                    lastCircleValueCalculated = true;
-                    lastValueCalculated = true;
-                } else if(!resMapVal) // was there ever anything? if not skip it!
-                {
-                    if(step < 1 && curDir == Direction::NorthEast)
-                        lastCircleValueCalculated = false;
-                    lastValueCalculated = false;
-                } else if(step < 1 && curDir == Direction::NorthEast) // circle not yet started? -> last direction was
-                                                                      // outward (left=0)
-                {
-                    resMapVal = aii.CalcResourceValue(curPt, res, Direction::West, circleStartValue);
-                    circleStartValue = resMapVal;
-                } else if(lastValueCalculated)
-                {
-                    if(step > 0) // we moved direction i%6
-                        resMapVal = aii.CalcResourceValue(curPt, res, curDir, resMapVal);
-                    else // last step was the previous direction
-                        resMapVal = aii.CalcResourceValue(curPt, res, curDir - 1u, resMapVal);
-                } else
-                {
-                    resMapVal = aii.CalcResourceValue(curPt, res);
-                    lastValueCalculated = true;
-                }
-            }
-        }
-    }
-}
-
-void AIResourceMap::updateAroundReplinishable(const MapPoint& pt, const int radius)
-{
-    // to avoid having to calculate a value twice and still move left on the same level without any problems we use this
-    // variable to remember the first calculation we did in the circle.
-    int circleStartValue = 0;
-
-    int resValue = 0;
-    for(MapCoord tx = aii.gwb.GetXA(pt, Direction::West), r = 1; r <= radius;
-        tx = aii.gwb.GetXA(MapPoint(tx, pt.y), Direction::West), ++r)
-    {
-        MapPoint curPt(tx, pt.y);
-        for(const auto curDir : helpers::enumRange(Direction::NorthEast))
-        {
-            for(MapCoord step = 0; step < r; ++step, curPt = aii.gwb.GetNeighbour(curPt, curDir))
-            {
-                if(r == 1 && step == 0 && curDir == Direction::NorthEast)
-                {
-                    // only do a complete calculation for the first point!
-                    resValue = aii.CalcResourceValue(curPt, res);
-                    circleStartValue = resValue;
-                } else if(step == 0 && curDir == Direction::NorthEast)
-                {
-                    // circle not yet started? -> last direction was outward
-                    resValue = aii.CalcResourceValue(curPt, res, Direction::West, circleStartValue);
-                    circleStartValue = resValue;
-                } else if(step > 0) // we moved direction i%6
-                    resValue = aii.CalcResourceValue(curPt, res, curDir, resValue);
-                else // last step was the previous direction
-                    resValue = aii.CalcResourceValue(curPt, res, curDir - 1u, resValue);
-                map[curPt] = resValue;
-            }
-        }
-    }
-}
-
 } // namespace AIJH
@@ -7,6 +7,7 @@
 #include "AIMap.h"
 #include "ai/AIResource.h"
 #include "world/NodeMapBase.h"
+#include "world/RadiusSumMap.h"
 #include "gameTypes/BuildingQuality.h"
 #include "gameTypes/BuildingType.h"
 
@@ -22,6 +23,7 @@ public:
     /// Initialize the resource map
     void init();
 
+    /// Update the values of all points in the radius around pt from the current state of the world
     void updateAround(const MapPoint& pt, int radius);
 
     /// Finds the best position for a specific resource in an area using the resource maps,
@@ -35,17 +37,14 @@ public:
     int operator[](const MapPoint& pt) const { return map[pt]; }
 
 private:
-    /// Update algorithm for resources which cannot be regrown
-    void updateAroundDiminishable(const MapPoint& pt, int radius);
-    /// Update algorithm for resources which can be replenished
-    void updateAroundReplinishable(const MapPoint& pt, int radius);
-
     /// Which resource is stored in the map and radius of affected nodes
     const AIResource res;
     const bool isInfinite;
     const bool isDiminishableResource;
     const unsigned resRadius;
 
+    /// Rating of each single node. The value of a point is the sum of the ratings in resRadius around it
+    RadiusSumMap ratings;
     NodeMapBase<int> map;
     const AIInterface& aii;
     const AIMap& aiMap;
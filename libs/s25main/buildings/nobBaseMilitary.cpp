@@ -152,7 +152,7 @@ nofAttacker* nobBaseMilitary::FindAggressor(nofAggressiveDefender* defender)
         if(world->CalcDistance(attackerPos, defenderPos) <= 5)
         {
             // Check it further (e.g. if they have to walk around a river...)
-            if(world->FindHumanPath(attackerPos, defenderPos, 5))
+            if(world->FindHumanPathLength(attackerPos, defenderPos, 5))
             {
                 aggressor->LetsFight(defender);
                 return aggressor;
@@ -205,7 +205,7 @@ MapPoint nobBaseMilitary::FindAnAttackerPlace(unsigned short& ret_radius, const
 
         unsigned length = 0;
         // Gültiger Weg gefunden
-        if(world->FindHumanPath(soldierPos, node.first, 100, false, &length))
+        if(world->FindHumanPathLength(soldierPos, node.first, 100, &length))
         {
             // Kürzer als bisher kürzester Weg? --> Dann nehmen wir diesen Punkt (vorerst)
             if(length < min_length)
@@ -288,7 +288,7 @@ void nobBaseMilitary::CheckArrestedAttackers()
         {
             // Und kommt er überhaupt zur Flagge (könnte ja in der 2. Reihe stehen, sodass die
             // vor ihm ihn den Weg versperren)?
-            if(world->FindHumanPath(aggressor->GetPos(), world->GetNeighbour(pos, Direction::SouthEast), 5, false))
+            if(world->FindHumanPathLength(aggressor->GetPos(), world->GetNeighbour(pos, Direction::SouthEast), 5))
             {
                 // dann kann der zur Flagge gehen
                 aggressor->AttackFlag();
@@ -309,7 +309,7 @@ bool nobBaseMilitary::SendSuccessor(const MapPoint pt, const unsigned short radi
             if(aggressor->GetRadius() > radius)
             {
                 // Und findet er einen zu diesem Punkt?
-                if(world->FindHumanPath(aggressor->GetPos(), pt, 50, false))
+                if(world->FindHumanPathLength(aggressor->GetPos(), pt, 50))
                 {
                     // dann soll er dorthin gehen
                     aggressor->StartSucceeding(pt, radius);
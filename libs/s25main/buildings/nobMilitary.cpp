@@ -833,7 +833,7 @@ unsigned nobMilitary::GetNumSoldiersForAttack(const MapPoint dest) const
     }
 
     // und auch der Weg zu Fuß darf dann nicht so weit sein, wenn das alles bestanden ist, können wir ihn nehmen..
-    if(soldiers_count && world->FindHumanPath(pos, dest, MAX_ATTACKING_RUN_DISTANCE))
+    if(soldiers_count && world->FindHumanPathLength(pos, dest, MAX_ATTACKING_RUN_DISTANCE))
         // Soldaten davon nehmen
         return soldiers_count;
     else
@@ -945,6 +945,8 @@ void nobMilitary::Capture(const unsigned char new_owner)
     // Alten Besitzer merken
     unsigned char old_player = player;
     world->GetPlayer(old_player).RemoveBuilding(this, bldType_);
+    // The building sees for the new owner now (added when recalculating the territory)
+    world->RemoveViewer(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY, old_player);
     // neuer Spieler
     player = new_owner;
     // In der Wirtschaftsverwaltung dieses Gebäude jetzt zum neuen Spieler zählen und beim alten raushauen
@@ -957,7 +959,7 @@ void nobMilitary::Capture(const unsigned char new_owner)
     world->RecalcTerritory(*this, TerritoryChangeReason::Captured);
 
     // Sichtbarkeiten berechnen für alten Spieler
-    world->RecalcVisibilitiesAroundPoint(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY + 1, old_player, nullptr);
+    world->RecalcVisibilitiesAroundPoint(pos, GetMilitaryRadius() + VISUALRANGE_MILITARY + 1, old_player);
 
     // Grenzflagge entsprechend neu setzen von den Feinden
     LookForEnemyBuildings();
@@ -976,18 +978,22 @@ void nobMilitary::Capture(const unsigned char new_owner)
     std::array<MapPoint, 2> coords = {pos, world->GetNeighbour(pos, Direction::SouthEast)};
     for(const auto& coord : coords)
     {
+        // Collect them first as they may start walking which could change the figures
+        std::vector<noFigure*> figures;
         for(noBase& baseFigure : world->GetFigures(coord))
         {
             if(baseFigure.GetType() == NodalObjectType::Figure)
             {
                 auto& figure = static_cast<noFigure&>(baseFigure);
                 if(figure.GetCurrentRoad() == GetRoute(Direction::SouthEast) && figure.GetPlayer() != new_owner)
-                {
-                    figure.Abrogate();
-                    figure.StartWandering();
-                }
+                    figures.push_back(&figure);
             }
         }
+        for(noFigure* figure : figures)
+        {
+            figure->Abrogate();
+            figure->StartWandering();
+        }
     }
 
     // Send all allied aggressors home (we own the building now!)
@@ -1055,7 +1061,7 @@ void nobMilitary::NeedOccupyingTroops()
                 continue;
             // Und kommt er überhaupt zur Flagge (könnte ja in der 2. Reihe stehen, sodass die vor ihm ihn den Weg
             // versperren)?
-            if(world->FindHumanPath(aggressor->GetPos(), world->GetNeighbour(pos, Direction::SouthEast), 10, false))
+            if(world->FindHumanPathLength(aggressor->GetPos(), world->GetNeighbour(pos, Direction::SouthEast), 10))
             {
                 // Dann is das der bisher beste
                 best_attacker = aggressor;
@@ -1350,7 +1356,7 @@ void nobMilitary::CallNextFarAwayCapturer(nofAttacker& attacker)
             continue;
         RTTR_Assert(far_away_capturer->GetPos() != flagPos); // Impossible. This should be the current attacker
         unsigned length;
-        if(!world->FindHumanPath(far_away_capturer->GetPos(), flagPos, MAX_FAR_AWAY_CAPTURING_DISTANCE, false, &length))
+        if(!world->FindHumanPathLength(far_away_capturer->GetPos(), flagPos, MAX_FAR_AWAY_CAPTURING_DISTANCE, &length))
             continue;
         if(length < minLength)
         {
@@ -0,0 +1,61 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "dskReplaySeek.h"
+#include "Loader.h"
+#include "WindowManager.h"
+#include "controls/ctrlTimer.h"
+#include "dskGameLoader.h"
+#include "dskMainMenu.h"
+#include "files.h"
+#include "helpers/format.hpp"
+#include "ingameWindows/iwMsgbox.h"
+#include "network/GameClient.h"
+#include "ogl/FontStyle.h"
+#include <utility>
+
+dskReplaySeek::dskReplaySeek(unsigned targetGF)
+    : Desktop(LOADER.GetImageN(ResourceId(LOAD_SCREENS[rand() % LOAD_SCREENS.size()]), 0)), targetGF(targetGF)
+{
+    WINDOWMANAGER.SetCursor(Cursor::None);
+
+    // Give the window manager the chance to destroy the game interface (and hence the game) before seeking
+    using namespace std::chrono_literals;
+    AddTimer(0, 50ms);
+
+    AddText(1, DrawPoint(800 / 2, 600 - 50), helpers::format(_("Jumping to GameFrame %u..."), targetGF), COLOR_YELLOW,
+            FontStyle::CENTER, LargeFont);
+
+    GAMECLIENT.SetInterface(this);
+}
+
+dskReplaySeek::~dskReplaySeek()
+{
+    WINDOWMANAGER.SetCursor();
+    GAMECLIENT.RemoveInterface(this);
+}
+
+void dskReplaySeek::Msg_Timer(const unsigned ctrl_id)
+{
+    GetCtrl<ctrlTimer>(ctrl_id)->Stop();
+    // Errors are reported via CI_Error
+    GAMECLIENT.SeekReplay(targetGF);
+}
+
+void dskReplaySeek::CI_GameLoading(std::shared_ptr<Game> game)
+{
+    WINDOWMANAGER.Switch(std::make_unique<dskGameLoader>(std::move(game)));
+}
+
+void dskReplaySeek::CI_Error(const ClientError ce)
+{
+    WINDOWMANAGER.Show(std::make_unique<iwMsgbox>(_("Error"), ClientErrorToStr(ce), this, MsgboxButton::Ok,
+                                                  MsgboxIcon::ExclamationRed, 0));
+}
+
+void dskReplaySeek::Msg_MsgBoxResult(const unsigned /*msgbox_id*/, const MsgboxResult /*mbr*/)
+{
+    GAMECLIENT.Stop();
+    WINDOWMANAGER.Switch(std::make_unique<dskMainMenu>());
+}
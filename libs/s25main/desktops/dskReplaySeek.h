@@ -0,0 +1,27 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Desktop.h"
+#include "network/ClientInterface.h"
+#include <memory>
+
+/// Shown while jumping to a GF of the current replay that is not reachable by fast forwarding.
+/// The replay is restarted from the closest keyframe which requires the current game to be destroyed first
+class dskReplaySeek : public Desktop, public ClientInterface
+{
+public:
+    explicit dskReplaySeek(unsigned targetGF);
+    ~dskReplaySeek() override;
+
+    void CI_GameLoading(std::shared_ptr<Game> game) override;
+    void CI_Error(ClientError ce) override;
+
+private:
+    void Msg_MsgBoxResult(unsigned msgbox_id, MsgboxResult mbr) override;
+    void Msg_Timer(unsigned ctrl_id) override;
+
+    unsigned targetGF;
+};
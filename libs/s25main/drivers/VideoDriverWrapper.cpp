@@ -4,6 +4,7 @@
 
 #include "VideoDriverWrapper.h"
 #include "FrameCounter.h"
+#include "RTTR_Assert.h"
 #include "RTTR_Version.h"
 #include "WindowManager.h"
 #include "driver/VideoInterface.h"
@@ -12,6 +13,7 @@
 #include "mygettext/mygettext.h"
 #include "ogl/DummyRenderer.h"
 #include "ogl/OpenGLRenderer.h"
+#include "ogl/SpriteBatch.h"
 #include "openglCfg.hpp"
 #include "s25util/Log.h"
 #include "s25util/error.h"
@@ -30,7 +32,8 @@ using SwapIntervalExt_t = int(int);
 SwapIntervalExt_t* wglSwapIntervalEXT = nullptr;
 
 VideoDriverWrapper::VideoDriverWrapper()
-    : videodriver(nullptr, nullptr), renderer_(nullptr), enableMouseWarping(true), texture_current(0)
+    : videodriver(nullptr, nullptr), renderer_(nullptr), spriteBatch_(std::make_unique<SpriteBatch>()),
+      isBatchingSprites_(false), enableMouseWarping(true), texture_current(0)
 {}
 
 VideoDriverWrapper::~VideoDriverWrapper()
@@ -192,6 +195,29 @@ unsigned VideoDriverWrapper::GetFPS() const
     return frameCtr_->getFrameRate();
 }
 
+void VideoDriverWrapper::CountDrawCalls(unsigned count)
+{
+    frameCtr_->addDrawCalls(count);
+}
+
+unsigned VideoDriverWrapper::GetNumDrawCalls() const
+{
+    return frameCtr_->getNumDrawCalls();
+}
+
+void VideoDriverWrapper::BeginSpriteBatch()
+{
+    RTTR_Assert(!isBatchingSprites_ && spriteBatch_->empty());
+    isBatchingSprites_ = true;
+}
+
+void VideoDriverWrapper::EndSpriteBatch()
+{
+    RTTR_Assert(isBatchingSprites_);
+    isBatchingSprites_ = false;
+    spriteBatch_->flush();
+}
+
 /**
  *  Löscht alle herausgegebenen Texturen aus dem Speicher.
  */
@@ -16,6 +16,7 @@ class IVideoDriver;
 class IRenderer;
 class FrameCounter;
 class FrameLimiter;
+class SpriteBatch;
 
 ///////////////////////////////////////////////////////////////////////////////
 // DriverWrapper
@@ -50,6 +51,13 @@ public:
     void DeleteTexture(unsigned t);
 
     IRenderer* GetRenderer() { return renderer_.get(); }
+    /// Collect the sprites drawn until EndSpriteBatch and draw those with the same texture together.
+    /// Only sprites may be drawn in between
+    void BeginSpriteBatch();
+    /// Draw all collected sprites
+    void EndSpriteBatch();
+    /// Return the batch to add sprites to or nullptr if they should be drawn directly
+    SpriteBatch* GetSpriteBatch() { return isBatchingSprites_ ? spriteBatch_.get() : nullptr; }
 
     /// Swapped den Buffer
     void SwapBuffers();
@@ -86,6 +94,10 @@ public:
     /// negative for unlimited, 0 for hardware VSync
     void setTargetFramerate(int target);
     unsigned GetFPS() const;
+    /// Count draw calls issued in the current frame
+    void CountDrawCalls(unsigned count = 1);
+    /// Get the number of draw calls of the last frame
+    unsigned GetNumDrawCalls() const;
 
     std::string GetName() const;
     bool IsLoaded() const { return videodriver != nullptr; }
@@ -110,6 +122,8 @@ private:
     std::unique_ptr<IRenderer> renderer_;
     std::unique_ptr<FrameCounter> frameCtr_;
     std::unique_ptr<FrameLimiter> frameLimiter_;
+    std::unique_ptr<SpriteBatch> spriteBatch_;
+    bool isBatchingSprites_;
     bool enableMouseWarping;
 
     std::vector<unsigned> texture_list;
@@ -543,7 +543,7 @@ void noFigure::Wander()
             if(way < best_way)
             {
                 // Are we at that flag or is there a path to it?
-                if(way == 0 || world->FindHumanPath(pos, flag->GetPos(), wander_radius, false, &way))
+                if(way == 0 || world->FindHumanPathLength(pos, flag->GetPos(), wander_radius, &way))
                 {
                     // gucken, ob ein Weg zu einem Warenhaus führt
                     if(world->GetPlayer(player).FindWarehouse(*flag, FW::AcceptsFigure(job_), true, false))
@@ -911,7 +911,7 @@ void noFigure::CalcVisibilities(const MapPoint pt)
     const unsigned visualRange = GetVisualRange();
     if(visualRange)
         // An alter Position neu berechnen
-        world->RecalcVisibilitiesAroundPoint(pt, visualRange, player, nullptr);
+        world->RecalcVisibilitiesAroundPoint(pt, visualRange, player);
 }
 
 /// Informiert die Figur, dass für sie eine Schiffsreise beginnt
@@ -447,9 +447,9 @@ bool nofActiveSoldier::GetFightSpotNear(nofActiveSoldier* other, MapPoint* fight
     const auto isGoodFightingSpot = [world = this->world, pos = this->pos, this, other](MapPoint pt) {
         // Did we find a good spot?
         return world->IsValidPointForFighting(pt, *this, true)
-               && (pos == pt || world->FindHumanPath(pos, pt, MEET_FOR_FIGHT_DISTANCE * 2, false))
+               && (pos == pt || world->FindHumanPathLength(pos, pt, MEET_FOR_FIGHT_DISTANCE * 2))
                && (other->GetPos() == pt
-                   || world->FindHumanPath(other->GetPos(), pt, MEET_FOR_FIGHT_DISTANCE * 2, false));
+                   || world->FindHumanPathLength(other->GetPos(), pt, MEET_FOR_FIGHT_DISTANCE * 2));
     };
     const std::vector<MapPoint> pts =
       world->GetMatchingPointsInRadius<1>(middle, MEET_FOR_FIGHT_DISTANCE, isGoodFightingSpot, true);
@@ -197,7 +197,7 @@ bool nofFarmhand::IsPointAvailable(const MapPoint pt) const
     if(GetPointQuality(pt) != PointQuality::NotPossible)
     {
         // Gucken, ob ein Weg hinführt
-        return world->FindHumanPath(this->pos, pt, 20) != boost::none;
+        return world->FindHumanPathLength(this->pos, pt, 20);
     } else
         return false;
 }
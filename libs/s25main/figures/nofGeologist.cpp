@@ -330,7 +330,7 @@ void nofGeologist::LookForNewNodes()
 
 bool nofGeologist::IsValidTargetNode(const MapPoint pt) const
 {
-    return (IsNodeGood(pt) && !world->GetNode(pt).reserved && (pos == pt || world->FindHumanPath(pos, pt, 20)));
+    return (IsNodeGood(pt) && !world->GetNode(pt).reserved && (pos == pt || world->FindHumanPathLength(pos, pt, 20)));
 }
 
 helpers::OptionalEnum<Direction> nofGeologist::GetNextNode()
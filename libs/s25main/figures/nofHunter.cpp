@@ -156,7 +156,7 @@ void nofHunter::TryStartHunting()
                     continue;
 
                 // Und komme ich hin?
-                if(pos == animal.GetPos() || world->FindHumanPath(pos, animal.GetPos(), MAX_HUNTING_DISTANCE))
+                if(pos == animal.GetPos() || world->FindHumanPathLength(pos, animal.GetPos(), MAX_HUNTING_DISTANCE))
                 {
                     // Dann nehmen wir es
                     available_animals.push_back(&animal);
@@ -211,7 +211,7 @@ void nofHunter::WalkedDerived()
 bool nofHunter::IsShootingPointGood(const MapPoint pt)
 {
     // Punkt muss betretbar sein und man muss ihn erreichen können
-    return PathConditionHuman(*world).IsNodeOk(pt) && world->FindHumanPath(this->pos, pt, 6) != boost::none;
+    return PathConditionHuman(*world).IsNodeOk(pt) && world->FindHumanPathLength(this->pos, pt, 6);
 }
 
 void nofHunter::HandleStateChasing()
@@ -258,7 +258,7 @@ void nofHunter::HandleStateChasing()
             }
 
             MapPoint curShootingPos = world->MakeMapPoint(animalPos + delta);
-            if(curShootingPos == pos || world->FindHumanPath(pos, curShootingPos, 6))
+            if(curShootingPos == pos || world->FindHumanPathLength(pos, curShootingPos, 6))
             {
                 shootingPos = curShootingPos;
                 // Richtung, in die geschossen wird, bestimmen (natürlich die entgegengesetzte nehmen)
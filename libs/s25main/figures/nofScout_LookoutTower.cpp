@@ -31,13 +31,17 @@ void nofScout_LookoutTower::HandleDerivedEvent(const unsigned /*id*/) {}
 
 void nofScout_LookoutTower::WorkAborted()
 {
+    // The viewer is registered while the tower has a worker (nobUsual::HasWorker), which is the case in all states
+    // from reaching the tower until the work is aborted
     // Im enstprechenden Radius alles neu berechnen
-    world->RecalcVisibilitiesAroundPoint(pos, VISUALRANGE_LOOKOUTTOWER, player, workplace);
+    world->RemoveViewer(pos, VISUALRANGE_LOOKOUTTOWER, player);
+    world->RecalcVisibilitiesAroundPoint(pos, VISUALRANGE_LOOKOUTTOWER, player);
 }
 
 void nofScout_LookoutTower::WorkplaceReached()
 {
     // Im enstprechenden Radius alles sichtbar machen
+    world->AddViewer(pos, VISUALRANGE_LOOKOUTTOWER, player);
     world->MakeVisibleAroundPoint(pos, VISUALRANGE_LOOKOUTTOWER, player);
 
     // Und Post versenden
@@ -72,7 +72,7 @@ void nofShipWright::HandleDerivedEvent(const unsigned /*id*/)
                     if(obj->GetGOT() == GO_Type::Shipbuildingsite
                        && static_cast<noShipBuildingSite*>(obj)->GetPlayer() == player)
                     {
-                        if(world->FindHumanPath(flagPos, pt, SHIPWRIGHT_WALKING_DISTANCE))
+                        if(world->FindHumanPathLength(flagPos, pt, SHIPWRIGHT_WALKING_DISTANCE))
                             available_points.push_back(pt);
                     }
                 }
@@ -83,7 +83,7 @@ void nofShipWright::HandleDerivedEvent(const unsigned /*id*/)
                     for(const auto& pt : possiblePts)
                     {
                         // Dieser Punkt geeignet?
-                        if(IsPointGood(pt) && world->FindHumanPath(flagPos, pt, SHIPWRIGHT_WALKING_DISTANCE))
+                        if(IsPointGood(pt) && world->FindHumanPathLength(flagPos, pt, SHIPWRIGHT_WALKING_DISTANCE))
                             available_points.push_back(pt);
                     }
                 }
@@ -17,7 +17,8 @@ MapNode::MapNode()
     std::fill(boundary_stones.begin(), boundary_stones.end(), 0);
 }
 
-void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc) const
+void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, const FoWNode* fow,
+                        const WorldDescription& desc) const
 {
     helpers::pushContainer(sgd, roads);
     sgd.PushUnsignedChar(altitude);
@@ -28,7 +29,6 @@ void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, cons
     sgd.PushBool(reserved);
     sgd.PushUnsignedChar(owner);
     helpers::pushContainer(sgd, boundary_stones);
-    RTTR_Assert(numPlayers <= fow.size());
     for(unsigned z = 0; z < numPlayers; ++z)
         fow[z].Serialize(sgd);
     sgd.PushObject(obj);
@@ -37,8 +37,8 @@ void MapNode::Serialize(SerializedGameData& sgd, const unsigned numPlayers, cons
     sgd.PushUnsignedInt(harborId);
 }
 
-void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, const WorldDescription& desc,
-                          const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains)
+void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, FoWNode* fow,
+                          const WorldDescription& desc, const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains)
 {
     helpers::popContainer(sgd, roads);
 
@@ -67,7 +67,6 @@ void MapNode::Deserialize(SerializedGameData& sgd, const unsigned numPlayers, co
     helpers::popContainer(sgd, boundary_stones);
     if(sgd.GetGameDataVersion() < 9)
         bq = sgd.Pop<BuildingQuality>();
-    RTTR_Assert(numPlayers <= fow.size());
     for(unsigned z = 0; z < numPlayers; ++z)
         fow[z].Deserialize(sgd);
     obj = sgd.PopObject<noBase>();
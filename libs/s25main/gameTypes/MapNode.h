@@ -11,8 +11,8 @@
 #include "gameTypes/MapTypes.h"
 #include "gameData/DescIdx.h"
 #include "gameData/MaxPlayers.h"
+#include <boost/container/small_vector.hpp>
 #include <array>
-#include <list>
 #include <memory>
 #include <vector>
 
@@ -41,8 +41,6 @@ struct MapNode
     unsigned char owner;
     BoundaryStones boundary_stones;
     BuildingQuality bq;
-    /// How the players see the point in FoW
-    std::array<FoWNode, MAX_PLAYERS> fow;
 
     /// To which sea this belongs to (0=None)
     unsigned short seaId;
@@ -51,15 +49,21 @@ struct MapNode
 
     /// Objekt, welches sich dort befindet
     noBase* obj;
+    /// Storage for the figures on a node. Usually there are at most 2 (e.g. carriers meeting at a flag)
+    /// so those are stored inline avoiding allocations for figures walking from node to node.
+    /// Removing keeps the order of the other figures.
+    using FigureList = boost::container::small_vector<std::unique_ptr<noBase>, 2>;
     /// Figures or fights on this node
-    std::list<std::unique_ptr<noBase>> figures;
+    FigureList figures;
 
     MapNode();
     MapNode(const MapNode&) = delete;
     MapNode(MapNode&&) = default;
     MapNode& operator=(const MapNode&) = delete;
     MapNode& operator=(MapNode&&) = default;
-    void Serialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc) const;
-    void Deserialize(SerializedGameData& sgd, unsigned numPlayers, const WorldDescription& desc,
+    /// Serialize the node and the given FoW nodes of all players (they are stored outside the node)
+    void Serialize(SerializedGameData& sgd, unsigned numPlayers, const FoWNode* fow,
+                   const WorldDescription& desc) const;
+    void Deserialize(SerializedGameData& sgd, unsigned numPlayers, FoWNode* fow, const WorldDescription& desc,
                      const std::vector<DescIdx<TerrainDesc>>& landscapeTerrains);
 };
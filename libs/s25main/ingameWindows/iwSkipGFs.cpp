@@ -4,7 +4,9 @@
 
 #include "iwSkipGFs.h"
 #include "Loader.h"
+#include "WindowManager.h"
 #include "controls/ctrlEdit.h"
+#include "desktops/dskReplaySeek.h"
 #include "network/GameClient.h"
 #include "gameData/const_gui_ids.h"
 #include "s25util/StringConversion.h"
@@ -29,7 +31,11 @@ iwSkipGFs::iwSkipGFs(GameWorldView& gwv)
 void iwSkipGFs::SkipGFs()
 {
     int gf = s25util::fromStringClassicDef(GetCtrl<ctrlEdit>(1)->GetText(), 0);
-    GAMECLIENT.SkipGF(gf, gwv);
+    // Jumping back or far ahead in a replay is done by restarting it from a keyframe
+    if(gf >= 0 && GAMECLIENT.ShouldSeekReplay(gf))
+        WINDOWMANAGER.Switch(std::make_unique<dskReplaySeek>(gf));
+    else
+        GAMECLIENT.SkipGF(gf, gwv);
 }
 
 void iwSkipGFs::Msg_ButtonClick(const unsigned /*ctrl_id*/)
@@ -8,6 +8,7 @@
 #include "WindowManager.h"
 #include "ai/AIInterface.h"
 #include "ai/AIPlayer.h"
+#include "helpers/serializePoint.h"
 #include "ingameWindows/iwMissionStatement.h"
 #include "lua/LuaHelpers.h"
 #include "lua/LuaPlayer.h"
@@ -17,6 +18,7 @@
 #include "gameTypes/Resource.h"
 #include "s25util/Serializer.h"
 #include "s25util/strAlgos.h"
+#include <utility>
 
 LuaInterfaceGame::LuaInterfaceGame(Game& gameInstance, ILocalGameState& localGameState)
     : LuaInterfaceGameBase(localGameState), localGameState(localGameState), gw(gameInstance.world_), game(gameInstance)
@@ -184,6 +186,97 @@ LuaInterfaceGame::LuaInterfaceGame(Game& gameInstance, ILocalGameState& localGam
 
 LuaInterfaceGame::~LuaInterfaceGame() = default;
 
+void LuaInterfaceGame::SendBatchedEvents()
+{
+    for(unsigned player = 0; player < exploredPts_.size(); player++)
+    {
+        if(exploredPts_[player].empty())
+            continue;
+        // Copy first as the callback may explore more points
+        const std::vector<ExploredPt> explored = std::move(exploredPts_[player]);
+        exploredPts_[player].clear();
+        // Looked up every time as a handler might remove itself
+        kaguya::LuaRef onExploredBatch = lua["onExploredBatch"];
+        if(onExploredBatch.type() != LUA_TFUNCTION)
+            continue;
+        kaguya::LuaTable points = lua.newTable();
+        int idx = 1;
+        for(const ExploredPt& exploredPt : explored)
+        {
+            kaguya::LuaTable point = lua.newTable();
+            point["x"] = exploredPt.pt.x;
+            point["y"] = exploredPt.pt.y;
+            // No owner -> nil
+            if(exploredPt.owner != 0)
+                point["owner"] = exploredPt.owner - 1;
+            points[idx++] = point;
+        }
+        onExploredBatch.call<void>(player, points);
+    }
+    for(unsigned player = 0; player < occupiedPts_.size(); player++)
+    {
+        if(occupiedPts_[player].empty())
+            continue;
+        const std::vector<MapPoint> occupied = std::move(occupiedPts_[player]);
+        occupiedPts_[player].clear();
+        kaguya::LuaRef onOccupiedBatch = lua["onOccupiedBatch"];
+        if(onOccupiedBatch.type() != LUA_TFUNCTION)
+            continue;
+        kaguya::LuaTable points = lua.newTable();
+        int idx = 1;
+        for(const MapPoint pt : occupied)
+        {
+            kaguya::LuaTable point = lua.newTable();
+            point["x"] = pt.x;
+            point["y"] = pt.y;
+            points[idx++] = point;
+        }
+        onOccupiedBatch.call<void>(player, points);
+    }
+}
+
+void LuaInterfaceGame::SerializeBatchedEvents(Serializer& ser) const
+{
+    ser.PushUnsignedInt(exploredPts_.size());
+    for(const std::vector<ExploredPt>& explored : exploredPts_)
+    {
+        ser.PushUnsignedInt(explored.size());
+        for(const ExploredPt& exploredPt : explored)
+        {
+            helpers::pushPoint(ser, exploredPt.pt);
+            ser.PushUnsignedChar(exploredPt.owner);
+        }
+    }
+    ser.PushUnsignedInt(occupiedPts_.size());
+    for(const std::vector<MapPoint>& occupied : occupiedPts_)
+    {
+        ser.PushUnsignedInt(occupied.size());
+        for(const MapPoint pt : occupied)
+            helpers::pushPoint(ser, pt);
+    }
+}
+
+void LuaInterfaceGame::DeserializeBatchedEvents(Serializer& ser)
+{
+    exploredPts_.resize(ser.PopUnsignedInt());
+    for(std::vector<ExploredPt>& explored : exploredPts_)
+    {
+        explored.resize(ser.PopUnsignedInt());
+        for(ExploredPt& exploredPt : explored)
+        {
+            exploredPt.pt = helpers::popPoint<MapPoint>(ser);
+            exploredPt.owner = ser.PopUnsignedChar();
+        }
+    }
+    occupiedPts_.resize(ser.PopUnsignedInt());
+    for(std::vector<MapPoint>& occupied : occupiedPts_)
+    {
+        occupied.resize(ser.PopUnsignedInt());
+        for(MapPoint& pt : occupied)
+            pt = helpers::popPoint<MapPoint>(ser);
+    }
+}
+
 KAGUYA_MEMBER_FUNCTION_OVERLOADS(SetMissionGoalWrapper, LuaInterfaceGame, SetMissionGoal, 1, 2)
 
 void LuaInterfaceGame::Register(kaguya::State& state)
@@ -326,6 +419,9 @@ LuaWorld LuaInterfaceGame::GetWorld()
 
 void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigned char owner)
 {
+    if(player >= exploredPts_.size())
+        exploredPts_.resize(player + 1);
+    exploredPts_[player].push_back(ExploredPt{pt, owner});
     kaguya::LuaRef onExplored = lua["onExplored"];
     if(onExplored.type() == LUA_TFUNCTION)
     {
@@ -343,6 +439,9 @@ void LuaInterfaceGame::EventExplored(unsigned player, const MapPoint pt, unsigne
 
 void LuaInterfaceGame::EventOccupied(unsigned player, const MapPoint pt)
 {
+    if(player >= occupiedPts_.size())
+        occupiedPts_.resize(player + 1);
+    occupiedPts_[player].push_back(pt);
     kaguya::LuaRef onOccupied = lua["onOccupied"];
     if(onOccupied.type() == LUA_TFUNCTION)
         onOccupied.call<void>(player, pt.x, pt.y);
@@ -357,6 +456,7 @@ void LuaInterfaceGame::EventStart(bool isFirstStart)
 
 void LuaInterfaceGame::EventGameFrame(unsigned nr)
 {
+    SendBatchedEvents();
     kaguya::LuaRef onGameFrame = lua["onGameFrame"];
     if(onGameFrame.type() == LUA_TFUNCTION)
         onGameFrame.call<void>(nr);
@@ -9,6 +9,7 @@
 #include "gameTypes/PactTypes.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 class GameWorld;
 class LuaPlayer;
@@ -28,6 +29,9 @@ public:
 
     bool Serialize(Serializer& luaSaveState);
     bool Deserialize(Serializer& luaSaveState);
+    /// Save/Load the points not yet passed to the batch event handlers
+    void SerializeBatchedEvents(Serializer& ser) const;
+    void DeserializeBatchedEvents(Serializer& ser);
 
     void EventExplored(unsigned player, MapPoint pt, unsigned char owner);
     void EventOccupied(unsigned player, MapPoint pt);
@@ -62,6 +66,19 @@ private:
     ILocalGameState& localGameState;
     GameWorld& gw;
     Game& game;
+
+    struct ExploredPt
+    {
+        MapPoint pt;
+        unsigned char owner;
+    };
+    /// Per player: Points explored/occupied since the last GF for the batch callbacks.
+    /// Always collected, the callbacks are only looked up when delivering them
+    std::vector<std::vector<ExploredPt>> exploredPts_;
+    std::vector<std::vector<MapPoint>> occupiedPts_;
+
+    /// Call the batch callbacks with all points since the last call
+    void SendBatchedEvents();
     LuaPlayer GetPlayer(int playerIdx);
     LuaWorld GetWorld();
 };
@@ -163,6 +163,8 @@ void LuaPlayer::SetRestrictedArea(kaguya::VariadicArgType inPoints)
     } else if(pts.front() == pts.back())
         pts.pop_back();
     player.GetRestrictedArea() = pts;
+    // Existing territory is kept, the area only applies to later territory changes
+    player.GetGameWorld().RecalcMilitaryInfluence();
 }
 
 bool LuaPlayer::IsInRestrictedArea(unsigned x, unsigned y) const
@@ -52,6 +52,7 @@
 #include "s25util/utf8.h"
 #include <boost/filesystem.hpp>
 #include <helpers/chronoIO.h>
+#include <chrono>
 #include <memory>
 
 void GameClient::ClientConfig::Clear()
@@ -222,6 +223,9 @@ void GameClient::Stop()
     // clear jump target
     skiptogf = 0;
 
+    // Make sure the autosave is complete when returning to the menu
+    FinishAutosave(true);
+
     // Consistency check: No game, no lobby remaining
     RTTR_Assert(!game);
     RTTR_Assert(!gameLobby);
@@ -1329,7 +1333,11 @@ void GameClient::ExecuteGameFrame()
 
                 // GF-Ende im Replay aktualisieren
                 if(replayinfo && replayinfo->replay.IsRecording())
+                {
                     replayinfo->replay.UpdateLastGF(curGF);
+                    if(replayinfo->replay.IsKeyframeDue(GetGFNumber()))
+                        AddReplayKeyframe();
+                }
             }
 
         } catch(LuaExecutionError& e)
@@ -1373,21 +1381,76 @@ void GameClient::HandleAutosave()
     // Alle .... GF
     if(GetGFNumber() % SETTINGS.interface.autosave_interval == 0)
     {
+        // Only 1 autosave at a time as they write the same file and share the buffer
+        if(!FinishAutosave(false))
+        {
+            LOG.write("Autosave at GF %1% skipped as the previous one is still being written\n") % GetGFNumber();
+            return;
+        }
+
         std::string filename;
         if(mapinfo.title.empty())
             filename = std::string(_("Auto-Save")) + ".sav";
         else
             filename = mapinfo.title + " (" + _("Auto-Save") + ").sav";
 
-        SaveToFile(RTTRCONFIG.ExpandPath(s25::folders::save) / filename);
+        mainPlayer.sendMsg(GameMessage_Chat(GetPlayerId(), ChatDestination::System, "Saving game..."));
+
+        // Only serialize the game during the GF and let compression and writing happen in the background
+        const auto startTime = std::chrono::steady_clock::now();
+        if(!autosave_)
+            autosave_ = std::make_unique<Savegame>();
+        autosave_->ClearPlayers();
+        WritePlayerInfo(*autosave_);
+        autosave_->ggs = game->ggs_;
+        autosave_->start_gf = GetGFNumber();
+        autosave_->sgd.debugMode = SETTINGS.global.debugMode;
+        try
+        {
+            // Clears the data but keeps the buffer allocated by the last autosave
+            autosave_->sgd.MakeSnapshot(*game);
+        } catch(std::exception& e)
+        {
+            SystemChat(std::string("Error during saving: ") + e.what());
+            return;
+        }
+        const auto stallTime =
+          std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - startTime);
+        LOG.write("Autosave at GF %1%: Game serialized in %2% (%3% bytes)\n", LogTarget::File) % GetGFNumber()
+          % helpers::withUnit(stallTime) % autosave_->sgd.GetLength();
+
+        autosaveResult_ = std::async(
+          std::launch::async, [save = autosave_.get(), filepath = RTTRCONFIG.ExpandPath(s25::folders::save) / filename,
+                               mapTitle = mapinfo.title]() -> std::string {
+              try
+              {
+                  if(!save->Save(filepath, mapTitle))
+                      return "Could not open " + filepath.string();
+              } catch(std::exception& e)
+              {
+                  return e.what();
+              }
+              return std::string();
+          });
     }
 }
 
+bool GameClient::FinishAutosave(bool wait)
+{
+    if(!autosaveResult_.valid())
+        return true;
+    if(!wait && autosaveResult_.wait_for(std::chrono::seconds::zero()) != std::future_status::ready)
+        return false;
+    const std::string error = autosaveResult_.get();
+    if(!error.empty())
+        LOG.write(_("Error during autosave: %1%\n")) % error;
+    return true;
+}
+
 /// Führt notwendige Dinge für nächsten GF aus
 void GameClient::NextGF(bool wasNWF)
 {
-    for(AIPlayer& ai : game->aiPlayers_)
-        ai.RunGF(GetGFNumber(), wasNWF);
+    game->RunAIs(GetGFNumber(), wasNWF);
     game->RunGF();
 }
 
@@ -1432,6 +1495,7 @@ void GameClient::StartReplayRecording(const unsigned random_init)
     replayinfo = std::make_unique<ReplayInfo>();
     replayinfo->filename = s25util::Time::FormatTime("%Y-%m-%d_%H-%i-%s") + ".rpl";
     replayinfo->replay.random_init = random_init;
+    replayinfo->replay.SetKeyframeInterval(SETTINGS.interface.replay_keyframe_interval);
 
     WritePlayerInfo(replayinfo->replay);
     replayinfo->replay.ggs = game->ggs_;
@@ -1444,7 +1508,20 @@ void GameClient::StartReplayRecording(const unsigned random_init)
     }
 }
 
-bool GameClient::StartReplay(const boost::filesystem::path& path)
+void GameClient::AddReplayKeyframe()
+{
+    try
+    {
+        SerializedGameData sgd;
+        sgd.MakeSnapshot(*game);
+        replayinfo->replay.AddKeyframe(GetGFNumber(), RANDOM.GetCurrentState(), sgd);
+    } catch(std::exception& e)
+    {
+        LOG.write(_("Failed to add keyframe to replay: %1%\n")) % e.what();
+    }
+}
+
+bool GameClient::StartReplay(const boost::filesystem::path& path, unsigned startGF)
 {
     RTTR_Assert(state == ClientState::Stopped);
     mapinfo.Clear();
@@ -1460,6 +1537,24 @@ bool GameClient::StartReplay(const boost::filesystem::path& path)
     }
     replayinfo->filename = path.filename();
 
+    // Start from the keyframe as if it was a savegame
+    const ReplayKeyframe* keyframe = startGF ? replayinfo->replay.FindKeyframe(startGF) : nullptr;
+    UsedPRNG keyframeRngState;
+    if(keyframe)
+    {
+        auto savegame = std::make_unique<Savegame>();
+        if(!replayinfo->replay.LoadKeyframe(*keyframe, savegame->sgd, keyframeRngState))
+        {
+            LOG.write(_("Invalid Replay %1%! Reason: %2%\n")) % path % replayinfo->replay.GetLastErrorMsg();
+            OnError(ClientError::InvalidMap);
+            replayinfo.reset();
+            return false;
+        }
+        savegame->start_gf = keyframe->gf;
+        mapinfo.type = MapType::Savegame;
+        mapinfo.savegame = std::move(savegame);
+    }
+
     gameLobby = std::make_shared<GameLobby>(true, true, replayinfo->replay.GetNumPlayers());
 
     for(unsigned i = 0; i < replayinfo->replay.GetNumPlayers(); ++i)
@@ -1536,6 +1631,11 @@ bool GameClient::StartReplay(const boost::filesystem::path& path)
         return false;
     }
 
+    if(keyframe)
+    {
+        RANDOM.ResetState(keyframeRngState);
+        replayinfo->replay.SeekToKeyframe(*keyframe);
+    }
     replayinfo->replay.ReadGF(&replayinfo->next_gf);
 
     return true;
@@ -1645,6 +1745,43 @@ void GameClient::SkipGF(unsigned gf, GameWorldView& gwv)
     SetPause(true);
 }
 
+bool GameClient::ShouldSeekReplay(unsigned gf) const
+{
+    if(!replayMode)
+        return false;
+    if(gf < GetGFNumber())
+        return true;
+    const ReplayKeyframe* keyframe = replayinfo->replay.FindKeyframe(gf);
+    return keyframe && keyframe->gf > GetGFNumber();
+}
+
+bool GameClient::SeekReplay(unsigned gf)
+{
+    RTTR_Assert(replayMode && replayinfo);
+
+    const unsigned start_ticks = VIDEODRIVER.GetTickCount();
+    const boost::filesystem::path replayPath = replayinfo->replay.GetPath();
+    const bool allVisible = replayinfo->all_visible;
+    const unsigned char playerId = GetPlayerId();
+    // Only 1 game can exist, so destroy the current one before loading the replay again
+    Stop();
+    if(!StartReplay(replayPath, gf))
+        return false;
+    replayinfo->all_visible = allVisible;
+    mainPlayer.playerId = playerId;
+
+    // Run the remaining GFs (stops on async or end of replay)
+    game->Start(!!mapinfo.savegame);
+    framesinfo.isPaused = false;
+    while(!framesinfo.isPaused && GetGFNumber() < gf)
+        ExecuteGameFrame_Replay();
+    framesinfo.isPaused = true;
+
+    const unsigned ticks = VIDEODRIVER.GetTickCount() - start_ticks;
+    LOG.write(_("Jump to GF %1% finished (%2$.3g seconds).\n")) % GetGFNumber() % (ticks / 1000.0);
+    return true;
+}
+
 void GameClient::SystemChat(const std::string& text)
 {
     SystemChat(text, GetPlayerId());
@@ -1764,30 +1901,6 @@ std::unique_ptr<AIPlayer> GameClient::CreateAIPlayer(unsigned playerId, const AI
     return AIFactory::Create(aiInfo, playerId, game->world_);
 }
 
-/// Wandelt eine GF-Angabe in eine Zeitangabe um (HH:MM:SS oder MM:SS wenn Stunden = 0)
-std::string GameClient::FormatGFTime(const unsigned gf) const
-{
-    using seconds = std::chrono::duration<uint32_t, std::chrono::seconds::period>;
-    using hours = std::chrono::duration<uint32_t, std::chrono::hours::period>;
-    using minutes = std::chrono::duration<uint32_t, std::chrono::minutes::period>;
-    using std::chrono::duration_cast;
-
-    // In Sekunden umrechnen
-    seconds numSeconds = duration_cast<seconds>(gf * SPEED_GF_LENGTHS[referenceSpeed]);
-
-    // Angaben rausfiltern
-    hours numHours = duration_cast<hours>(numSeconds);
-    numSeconds -= numHours;
-    minutes numMinutes = duration_cast<minutes>(numSeconds);
-    numSeconds -= numMinutes;
-
-    // ganze Stunden mit dabei? Dann entsprechend anderes format, ansonsten ignorieren wir die einfach
-    if(numHours.count())
-        return helpers::format("%u:%02u:%02u", numHours.count(), numMinutes.count(), numSeconds.count());
-    else
-        return helpers::format("%02u:%02u", numMinutes.count(), numSeconds.count());
-}
-
 const boost::filesystem::path& GameClient::GetReplayFilename() const
 {
     static boost::filesystem::path emptyString;
@@ -19,7 +19,9 @@
 #include "gameTypes/TeamTypes.h"
 #include "gameTypes/VisualSettings.h"
 #include "s25util/Singleton.h"
+#include <future>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace AI {
@@ -36,6 +38,7 @@ class GameWorldView;
 class NWFInfo;
 class Replay;
 class SavedFile;
+class Savegame;
 enum class ConnectState;
 struct CreateServerInfo;
 struct PlayerGameCommands;
@@ -129,7 +132,8 @@ public:
     void DecreaseSpeed();
 
     /// Lädt ein Replay und startet dementsprechend das Spiel
-    bool StartReplay(const boost::filesystem::path& path);
+    /// If startGF is given the replay starts at the last keyframe before that GF
+    bool StartReplay(const boost::filesystem::path& path, unsigned startGF = 0);
 
     /// When a non-empty vector is given then an AI battle with the given AIs is started
     void SetAIBattlePlayers(std::vector<AI::Info> aiInfos);
@@ -144,8 +148,6 @@ public:
     bool IsReplayFOWDisabled() const;
     /// Gibt Replay-Ende (GF) zurück
     unsigned GetLastReplayGF() const;
-    /// Wandelt eine GF-Angabe in eine Zeitangabe um (HH:MM:SS oder MM:SS wenn Stunden = 0)
-    std::string FormatGFTime(unsigned gf) const override;
 
     /// Gibt Replay-Dateiname zurück
     const boost::filesystem::path& GetReplayFilename() const;
@@ -156,6 +158,11 @@ public:
     unsigned GetTournamentModeDuration() const;
 
     void SkipGF(unsigned gf, GameWorldView& gwv);
+    /// Return true if jumping to the GF in the replay requires or is faster by restarting it using SeekReplay
+    bool ShouldSeekReplay(unsigned gf) const;
+    /// Restart the current replay from the last keyframe before the GF and run it until that GF.
+    /// The current game must not be used anymore (e.g. by the GUI) as only one game can exist at a time
+    bool SeekReplay(unsigned gf);
 
     /// Changes the player ingame (for replay or debugging)
     void ChangePlayerIngame(unsigned char playerId1, unsigned char playerId2);
@@ -201,6 +208,9 @@ private:
     void NextGF(bool wasNWF);
     /// Checks if its time for autosaving (if enabled) and does it
     void HandleAutosave();
+    /// Check the result of the autosave written in the background (if any).
+    /// Return false if it is still running and wait is false
+    bool FinishAutosave(bool wait);
 
     //  Netzwerknachrichten
     RTTR_IGNORE_OVERLOADED_VIRTUAL
@@ -260,6 +270,8 @@ private:
 
     /// Schreibt den Header der Replaydatei
     void StartReplayRecording(unsigned random_init);
+    /// Add a keyframe with the current game state to the recorded replay
+    void AddReplayKeyframe();
     void WritePlayerInfo(SavedFile& file);
 
 public:
@@ -311,6 +323,12 @@ private:
 
     /// Configured players for an AI battle.
     std::vector<AI::Info> aiBattlePlayers_;
+
+    /// Savegame used for autosaves. Kept to reuse the buffer of the serialized game
+    std::unique_ptr<Savegame> autosave_;
+    /// Error message of the autosave written in the background (empty on success).
+    /// Must be declared after autosave_ so it is destroyed (i.e. waited for) first
+    std::future<std::string> autosaveResult_;
 };
 
 ///////////////////////////////////////////////////////////////////////////////
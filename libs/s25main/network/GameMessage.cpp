@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "GameMessage.h"
+#include "GameMessage_Batch.h"
 #include "GameMessage_GameCommand.h"
 #include "GameMessages.h"
 #include "commonDefines.h"
@@ -59,6 +60,7 @@ Message* GameMessage::create_game(unsigned short id)
         case NMS_REMOVE_LUA: msg = new GameMessage_RemoveLua(); break;
         case NMS_GET_ASYNC_LOG: msg = new GameMessage_GetAsyncLog(); break;
         case NMS_ASYNC_LOG: msg = new GameMessage_AsyncLog(); break;
+        case NMS_BATCH: msg = new GameMessage_Batch(); break;
     }
 
     return msg;
@@ -0,0 +1,73 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GameMessage_Batch.h"
+#include "GameMessageInterface.h"
+#include "GameProtocol.h"
+#include "s25util/Serializer.h"
+#include <stdexcept>
+
+GameMessage_Batch::GameMessage_Batch() : GameMessage(NMS_BATCH) {}
+
+void GameMessage_Batch::Serialize(Serializer& ser) const
+{
+    GameMessage::Serialize(ser);
+    ser.PushVarSize(msgs.size());
+    // The messages know their size, so the data is just appended
+    for(const auto& msg : msgs)
+    {
+        ser.PushUnsignedShort(msg->getId());
+        msg->Serialize(ser);
+    }
+}
+
+void GameMessage_Batch::Deserialize(Serializer& ser)
+{
+    GameMessage::Deserialize(ser);
+    msgs.clear();
+    msgs.resize(ser.PopVarSize());
+    for(auto& msg : msgs)
+    {
+        const auto id = ser.PopUnsignedShort();
+        msg.reset(create_game(id));
+        if(!msg)
+            throw std::runtime_error("Invalid message in batch");
+        msg->Deserialize(ser);
+    }
+}
+
+bool GameMessage_Batch::Run(GameMessageInterface* callback) const
+{
+    bool result = true;
+    for(const auto& msg : msgs)
+        result &= msg->run(callback, senderPlayerID);
+    return result;
+}
+
+GameMessage_Shared::GameMessage_Shared(const Message& msg) : GameMessage(msg.getId())
+{
+    auto data = std::make_shared<Serializer>();
+    msg.Serialize(*data);
+    data_ = std::move(data);
+}
+
+unsigned GameMessage_Shared::getSize() const
+{
+    return data_->GetLength();
+}
+
+void GameMessage_Shared::Serialize(Serializer& ser) const
+{
+    ser.PushRawData(data_->GetData(), data_->GetLength());
+}
+
+void GameMessage_Shared::Deserialize(Serializer&)
+{
+    throw std::logic_error("Shared messages can only be sent");
+}
+
+bool GameMessage_Shared::Run(GameMessageInterface*) const
+{
+    throw std::logic_error("Shared messages can only be sent");
+}
@@ -0,0 +1,41 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "GameMessage.h"
+#include <memory>
+#include <vector>
+
+/// Multiple messages sent as one, so they need only a single write to the socket.
+/// Running it runs all contained messages in order
+class GameMessage_Batch : public GameMessage
+{
+public:
+    std::vector<std::unique_ptr<Message>> msgs;
+
+    GameMessage_Batch();
+
+    void Serialize(Serializer& ser) const override;
+    void Deserialize(Serializer& ser) override;
+    bool Run(GameMessageInterface* callback) const override;
+};
+
+/// Message which is serialized only once on creation. Copies share the serialized data,
+/// so the message can be sent to multiple players cheaply. Can only be sent, the receiver gets the original message
+class GameMessage_Shared : public GameMessage
+{
+public:
+    explicit GameMessage_Shared(const Message& msg);
+
+    /// Size of the serialized message in bytes
+    unsigned getSize() const;
+
+    void Serialize(Serializer& ser) const override;
+    void Deserialize(Serializer& ser) override;
+    bool Run(GameMessageInterface* callback) const override;
+
+private:
+    std::shared_ptr<const Serializer> data_;
+};
@@ -55,7 +55,9 @@ enum
     NMS_REMOVE_LUA,
 
     NMS_GET_ASYNC_LOG = 0x0600,
-    NMS_ASYNC_LOG
+    NMS_ASYNC_LOG,
+
+    NMS_BATCH = 0x0700 // x messages
 };
 
 /* Hinweise:
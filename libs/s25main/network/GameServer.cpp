@@ -5,6 +5,7 @@
 #include "GameServer.h"
 #include "Debug.h"
 #include "GameMessage.h"
+#include "GameMessage_Batch.h"
 #include "GameMessage_GameCommand.h"
 #include "GameServerPlayer.h"
 #include "GlobalGameSettings.h"
@@ -397,6 +398,7 @@ void GameServer::Stop()
     // player verabschieden
     playerInfos.clear();
     networkPlayers.clear();
+    nwfScheduler.clear();
 
     // aufräumen
     framesinfo.Clear();
@@ -548,21 +550,17 @@ bool GameServer::StartGame()
     SendToAll(GameMessage_Server_Start(random_init, nwfInfo.getNextNWF(), nwfInfo.getCmdDelay()));
     LOG.writeToFile("SERVER >>> BROADCAST: NMS_SERVER_START(%d)\n") % random_init;
 
-    // Höchsten Ping ermitteln
-    unsigned highest_ping = 0;
-    for(const JoinPlayerInfo& player : playerInfos)
+    nwfScheduler.clear();
+    for(unsigned id = 0; id < playerInfos.size(); id++)
     {
-        if(player.ps == PlayerState::Occupied)
-        {
-            if(player.ping > highest_ping)
-                highest_ping = player.ping;
-        }
+        if(playerInfos[id].ps == PlayerState::Occupied)
+            nwfScheduler.setPing(id, playerInfos[id].ping);
     }
 
     framesinfo.gfLengthReq = framesinfo.gf_length = SPEED_GF_LENGTHS[ggs_.speed];
 
     // NetworkFrame-Länge bestimmen, je schlechter (also höher) die Pings, desto länger auch die Framelänge
-    framesinfo.nwf_length = CalcNWFLenght(FramesInfo::milliseconds32_t(highest_ping));
+    framesinfo.nwf_length = nwfScheduler.getRequiredNWFLength(framesinfo.gf_length);
 
     LOG.write("SERVER: Using gameframe length of %1%\n") % helpers::withUnit(framesinfo.gf_length);
     LOG.write("SERVER: Using networkframe length of %1% GFs (%2%)\n") % framesinfo.nwf_length
@@ -585,17 +583,6 @@ bool GameServer::StartGame()
     return true;
 }
 
-unsigned GameServer::CalcNWFLenght(FramesInfo::milliseconds32_t minDuration) const
-{
-    constexpr unsigned maxNumGF = 20;
-    for(unsigned i = 1; i < maxNumGF; ++i)
-    {
-        if(i * framesinfo.gf_length >= minDuration)
-            return i;
-    }
-    return maxNumGF;
-}
-
 void GameServer::SendNWFDone(const NWFServerInfo& info)
 {
     nwfInfo.addServerInfo(info);
@@ -607,11 +594,13 @@ void GameServer::SendNWFDone(const NWFServerInfo& info)
  */
 void GameServer::SendToAll(const GameMessage& msg)
 {
+    // Serialize only once, all players share the data
+    const GameMessage_Shared sharedMsg(msg);
     for(GameServerPlayer& player : networkPlayers)
     {
         // ist der Slot Belegt, dann Nachricht senden
         if(player.isActive())
-            player.sendMsgAsync(msg.clone());
+            player.sendMsgAsync(new GameMessage_Shared(sharedMsg));
     }
 }
 
@@ -627,6 +616,7 @@ void GameServer::KickPlayer(uint8_t playerId, KickReason cause, uint32_t param)
     if(!playerInfo.isUsed())
         return;
     playerInfo.ps = PlayerState::Free;
+    nwfScheduler.removePlayer(playerId);
 
     SendToAll(GameMessage_Player_Kicked(playerId, cause, param));
 
@@ -747,6 +737,7 @@ void GameServer::ExecuteNWF()
     RTTR_Assert(serverInfo.nextNWF > currentGF);
     // First save old values
     unsigned lastNWF = nwfInfo.getLastNWF();
+    unsigned lastNWFLength = nwfInfo.getLastNWFLength();
     FramesInfo::milliseconds32_t oldGFLen = framesinfo.gf_length;
     nwfInfo.execute(framesinfo);
     if(oldGFLen != framesinfo.gf_length)
@@ -754,8 +745,14 @@ void GameServer::ExecuteNWF()
         LOG.write(_("SERVER: At GF %1%: Speed changed from %2% to %3%. NWF %4%\n")) % currentGF
           % helpers::withUnit(oldGFLen) % helpers::withUnit(framesinfo.gf_length) % framesinfo.nwf_length;
     }
-    NWFServerInfo newInfo(lastNWF, framesinfo.gfLengthReq / FramesInfo::milliseconds32_t(1),
-                          lastNWF + framesinfo.nwf_length);
+    // Adapt the length to the current pings. The clients get it with the NWFDone, so they all use the same length
+    const unsigned newNWFLength = nwfScheduler.getNextNWFLength(lastNWFLength, framesinfo.gfLengthReq);
+    if(newNWFLength != lastNWFLength)
+    {
+        LOG.writeToFile("SERVER: At GF %1%: Changed networkframe length from %2% to %3% GFs (highest ping: %4%ms)\n")
+          % currentGF % lastNWFLength % newNWFLength % nwfScheduler.getHighestPing();
+    }
+    NWFServerInfo newInfo(lastNWF, framesinfo.gfLengthReq / FramesInfo::milliseconds32_t(1), lastNWF + newNWFLength);
     if(framesinfo.gfLengthReq != framesinfo.gf_length)
     {
         // Speed will change, adjust nwf length so the time will stay constant
@@ -763,7 +760,8 @@ void GameServer::ExecuteNWF()
         using MsDouble = duration<double, std::milli>;
         double newNWFLen =
           framesinfo.nwf_length * framesinfo.gf_length / duration_cast<MsDouble>(framesinfo.gfLengthReq);
-        newInfo.nextNWF = lastNWF + std::max(1l, std::lround(newNWFLen));
+        const long minNWFLen = nwfScheduler.getRequiredNWFLength(framesinfo.gfLengthReq);
+        newInfo.nextNWF = lastNWF + std::max(minNWFLen, std::lround(newNWFLen));
     }
     SendNWFDone(newInfo);
 }
@@ -899,6 +897,7 @@ bool GameServer::OnGameMessage(const GameMessage_Pong& msg)
         if(ping == 0u)
             return true;
         playerInfos[msg.senderPlayerID].ping = ping;
+        nwfScheduler.setPing(msg.senderPlayerID, ping);
         SendToAll(GameMessage_Player_Ping(msg.senderPlayerID, ping));
     }
     return true;
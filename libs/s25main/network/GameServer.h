@@ -10,6 +10,7 @@
 #include "GlobalGameSettings.h"
 #include "JoinPlayerInfo.h"
 #include "NWFInfo.h"
+#include "network/NWFScheduler.h"
 #include "gameTypes/MapInfo.h"
 #include "gameTypes/ServerType.h"
 #include "liblobby/LobbyInterface.h"
@@ -55,8 +56,6 @@ public:
 private:
     bool StartGame();
 
-    unsigned CalcNWFLenght(FramesInfo::milliseconds32_t minDuration) const;
-
     GameServerPlayer* GetNetworkPlayer(unsigned playerId);
     /// Swap players ingame or during config
     void SwapPlayer(uint8_t player1, uint8_t player2);
@@ -163,6 +162,7 @@ private:
     std::vector<JoinPlayerInfo> playerInfos;
     std::vector<GameServerPlayer> networkPlayers;
     NWFInfo nwfInfo;
+    NWFScheduler nwfScheduler;
     GlobalGameSettings ggs_;
 
     /// der Spielstartcountdown
@@ -0,0 +1,51 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "network/NWFScheduler.h"
+#include "helpers/containerUtils.h"
+#include <algorithm>
+
+constexpr unsigned NWFScheduler::minNWFLength;
+constexpr unsigned NWFScheduler::maxNWFLength;
+
+void NWFScheduler::setPing(unsigned playerId, unsigned ping)
+{
+    const auto it = helpers::find_if(pings_, [playerId](const auto& entry) { return entry.first == playerId; });
+    if(it == pings_.end())
+        pings_.emplace_back(playerId, ping);
+    else
+        it->second = ping;
+}
+
+void NWFScheduler::removePlayer(unsigned playerId)
+{
+    helpers::erase_if(pings_, [playerId](const auto& entry) { return entry.first == playerId; });
+}
+
+unsigned NWFScheduler::getHighestPing() const
+{
+    unsigned highestPing = 0;
+    for(const auto& entry : pings_)
+        highestPing = std::max(highestPing, entry.second);
+    return highestPing;
+}
+
+unsigned NWFScheduler::getRequiredNWFLength(FramesInfo::milliseconds32_t gfLength) const
+{
+    const FramesInfo::milliseconds32_t minDuration(getHighestPing());
+    for(unsigned i = minNWFLength; i < maxNWFLength; ++i)
+    {
+        if(i * gfLength >= minDuration)
+            return i;
+    }
+    return maxNWFLength;
+}
+
+unsigned NWFScheduler::getNextNWFLength(unsigned lastNWFLength, FramesInfo::milliseconds32_t gfLength) const
+{
+    const unsigned requiredLength = getRequiredNWFLength(gfLength);
+    if(requiredLength >= lastNWFLength)
+        return requiredLength;
+    return std::min(lastNWFLength - 1u, maxNWFLength);
+}
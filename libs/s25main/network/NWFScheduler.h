@@ -0,0 +1,36 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "FramesInfo.h"
+#include <utility>
+#include <vector>
+
+/// Chooses the length of the network frames (NWFs) from the round trip times (pings) of the players.
+/// Commands are sent cmdDelay NWFs in advance, so the longer the NWFs the more latency is hidden.
+/// Only the server uses this and announces each length via the NWFServerInfo, so all clients stay in sync
+class NWFScheduler
+{
+    /// Player id and ping in ms
+    std::vector<std::pair<unsigned, unsigned>> pings_;
+
+public:
+    static constexpr unsigned minNWFLength = 1;
+    static constexpr unsigned maxNWFLength = 20;
+
+    void clear() { pings_.clear(); }
+    /// Set the current ping of the player in ms
+    void setPing(unsigned playerId, unsigned ping);
+    /// Remove the player (e.g. kicked), so its ping is no longer considered
+    void removePlayer(unsigned playerId);
+    unsigned getHighestPing() const;
+
+    /// Return the minimum NWF length so a NWF lasts at least as long as the highest ping
+    unsigned getRequiredNWFLength(FramesInfo::milliseconds32_t gfLength) const;
+    /// Return the length of the NWF following one with the given length.
+    /// The length is increased at once to avoid stalls but decreased by only 1 GF per NWF so a single low ping does
+    /// not make it jump back and forth
+    unsigned getNextNWFLength(unsigned lastNWFLength, FramesInfo::milliseconds32_t gfLength) const;
+};
@@ -4,6 +4,9 @@
 
 #include "NetworkPlayer.h"
 #include "GameMessage.h"
+#include "GameMessage_Batch.h"
+#include <algorithm>
+#include <memory>
 
 NetworkPlayer::NetworkPlayer(unsigned playerId)
     : playerId(playerId), recvQueue(GameMessage::create_game), sendQueue(GameMessage::create_game)
@@ -24,9 +27,27 @@ bool NetworkPlayer::receiveMsgs()
 
 bool NetworkPlayer::sendMsgs(int maxNumMsgs)
 {
+    if(!socket.isValid())
+        return false;
+    // Send the batch directly instead of putting it back to the front of the queue.
+    // If that fails the connection is broken anyway
+    if(const auto batch = popBatch(maxNumMsgs))
+        return MessageQueue::sendMessage(socket, *batch);
     return sendQueue.send(socket, maxNumMsgs);
 }
 
+std::unique_ptr<GameMessage_Batch> NetworkPlayer::popBatch(int maxNumMsgs)
+{
+    const unsigned numMsgs = (maxNumMsgs < 0) ? sendQueue.size() : std::min<size_t>(sendQueue.size(), maxNumMsgs);
+    if(numMsgs <= 1u)
+        return nullptr;
+    auto batch = std::make_unique<GameMessage_Batch>();
+    batch->msgs.reserve(numMsgs);
+    for(unsigned i = 0; i < numMsgs; i++)
+        batch->msgs.push_back(sendQueue.pop());
+    return batch;
+}
+
 void NetworkPlayer::sendMsgAsync(Message* msg)
 {
     sendQueue.push(msg);
@@ -6,7 +6,9 @@
 
 #include "s25util/MessageQueue.h"
 #include "s25util/Socket.h"
+#include <memory>
 
+class GameMessage_Batch;
 class Message;
 class MessageInterface;
 
@@ -20,8 +22,11 @@ public:
     virtual void closeConnection();
     /// Receive all waiting messages from the socket. Return false on error
     bool receiveMsgs();
-    /// Send at most maxNumMsgs (if non-negative). Return false on error
+    /// Send at most maxNumMsgs (if non-negative) with a single write. Return false on error
     bool sendMsgs(int maxNumMsgs);
+    /// Remove the first maxNumMsgs (all if negative) queued messages and combine them into one.
+    /// Return nullptr (and keep the queue) if there are less than 2 messages
+    std::unique_ptr<GameMessage_Batch> popBatch(int maxNumMsgs);
     /// Enqueue a message to be send later
     void sendMsgAsync(Message* msg);
     /// Send a message synchronously
@@ -5,18 +5,18 @@
 #include "PlayerGameCommands.h"
 #include "s25util/Serializer.h"
 
-void PlayerGameCommands::Serialize(Serializer& ser) const
+void PlayerGameCommands::Serialize(Serializer& ser, const AsyncChecksum::Version checksumVersion) const
 {
-    checksum.Serialize(ser);
+    checksum.Serialize(ser, checksumVersion);
 
     ser.PushUnsignedInt(gcs.size());
     for(const gc::GameCommandPtr& gc : gcs)
         gc->Serialize(ser);
 }
 
-void PlayerGameCommands::Deserialize(Serializer& ser)
+void PlayerGameCommands::Deserialize(Serializer& ser, const AsyncChecksum::Version checksumVersion)
 {
-    checksum.Deserialize(ser);
+    checksum.Deserialize(ser, checksumVersion);
 
     gcs.resize(ser.PopUnsignedInt());
     for(gc::GameCommandPtr& gc : gcs)
@@ -21,6 +21,6 @@ struct PlayerGameCommands
     PlayerGameCommands(const AsyncChecksum& checksum, std::vector<gc::GameCommandPtr> gcs)
         : checksum(checksum), gcs(std::move(gcs))
     {}
-    void Serialize(Serializer& ser) const;
-    void Deserialize(Serializer& ser);
+    void Serialize(Serializer& ser, AsyncChecksum::Version checksumVersion = AsyncChecksum::currentVersion) const;
+    void Deserialize(Serializer& ser, AsyncChecksum::Version checksumVersion = AsyncChecksum::currentVersion);
 };
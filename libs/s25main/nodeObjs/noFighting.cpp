@@ -256,9 +256,8 @@ void noFighting::HandleEvent(const unsigned id)
 
                 // Sichtradius ausblenden am Ende des Kampfes, an jeweiligen Soldaten dann übergeben, welcher überlebt
                 // hat
-                world->RecalcVisibilitiesAroundPoint(pt, VISUALRANGE_SOLDIER, soldiers[player_lost]->GetPlayer(),
-                                                     nullptr);
-                world->RecalcVisibilitiesAroundPoint(pt, VISUALRANGE_SOLDIER, player_won, nullptr);
+                world->RecalcVisibilitiesAroundPoint(pt, VISUALRANGE_SOLDIER, soldiers[player_lost]->GetPlayer());
+                world->RecalcVisibilitiesAroundPoint(pt, VISUALRANGE_SOLDIER, player_won);
 
                 // Soldaten endgültig umbringen
                 world->GetPlayer(soldiers[player_lost]->GetPlayer())
@@ -7,6 +7,7 @@
 #include "GamePlayer.h"
 #include "RoadSegment.h"
 #include "SerializedGameData.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "world/GameWorld.h"
 #include "s25util/warningSuppression.h"
 
@@ -75,11 +76,14 @@ void noRoadNode::DestroyRoad(const Direction dir)
     if(!route)
         return;
     MapPoint t = route->GetF1()->GetPos();
-    for(unsigned z = 0; z < route->GetLength(); ++z)
     {
-        world->SetPointRoad(t, route->GetRoute(z), PointRoad::None);
-        world->RecalcBQForRoad(t);
-        t = world->GetNeighbour(t, route->GetRoute(z));
+        GameWorldBase::BQUpdateBatch bqBatch(*world);
+        for(unsigned z = 0; z < route->GetLength(); ++z)
+        {
+            world->SetPointRoad(t, route->GetRoute(z), PointRoad::None);
+            world->RecalcBQForRoad(t);
+            t = world->GetNeighbour(t, route->GetRoute(z));
+        }
     }
 
     noRoadNode* otherFlag;
@@ -107,6 +111,14 @@ void noRoadNode::DestroyRoad(const Direction dir)
     world->GetPlayer(player).RoadDestroyed();
 }
 
+void noRoadNode::SetRoute(const Direction dir, RoadSegment* route)
+{
+    routes[dir] = route;
+    // New connections might shorten paths
+    if(route && world)
+        world->GetRoadPathFinder().OnRoadAdded(*this, *GetNeighbour(dir), route->GetLength());
+}
+
 /// Vernichtet Alle Straße um diesen Knoten
 void noRoadNode::DestroyAllRoads()
 {
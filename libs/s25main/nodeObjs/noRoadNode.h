@@ -43,7 +43,7 @@ public:
     void Serialize(SerializedGameData& sgd) const override;
 
     RoadSegment* GetRoute(const Direction dir) const { return routes[dir]; }
-    void SetRoute(const Direction dir, RoadSegment* route) { routes[dir] = route; }
+    void SetRoute(Direction dir, RoadSegment* route);
     const auto& getRoutes() const { return routes; }
     noRoadNode* GetNeighbour(Direction dir) const;
 
@@ -291,7 +291,7 @@ void noShip::HandleEvent(const unsigned id)
                 }
 
                 // Sichtbarkeiten neu berechnen
-                world->RecalcVisibilitiesAroundPoint(pos, old_visual_range, ownerId_, nullptr);
+                world->RecalcVisibilitiesAroundPoint(pos, old_visual_range, ownerId_);
 
                 break;
             }
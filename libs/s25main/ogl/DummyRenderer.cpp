@@ -23,6 +23,9 @@ void APIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum
 void APIENTRY glClear(GLbitfield) {}
 void APIENTRY glVertexPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
 void APIENTRY glTexCoordPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
+void APIENTRY glColorPointer(GLint, GLenum, GLsizei, const GLvoid*) {}
+void APIENTRY glEnableClientState(GLenum) {}
+void APIENTRY glDisableClientState(GLenum) {}
 void APIENTRY glColor4ub(GLubyte, GLubyte, GLubyte, GLubyte) {}
 void APIENTRY glDrawArrays(GLenum, GLint, GLsizei) {}
 void APIENTRY glGetTexLevelParameteriv(GLenum, GLint, GLenum, GLint* params)
@@ -45,6 +48,9 @@ bool DummyRenderer::initOpenGL(OpenGL_Loader_Proc)
     MOCK(glClear);
     MOCK(glVertexPointer);
     MOCK(glTexCoordPointer);
+    MOCK(glColorPointer);
+    MOCK(glEnableClientState);
+    MOCK(glDisableClientState);
     MOCK(glColor4ub);
     MOCK(glDrawArrays);
     MOCK(glGetTexLevelParameteriv);
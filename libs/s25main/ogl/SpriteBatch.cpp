@@ -0,0 +1,97 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "SpriteBatch.h"
+#include "RTTR_Assert.h"
+#include "drivers/VideoDriverWrapper.h"
+#include <glad/glad.h>
+
+namespace {
+/// Number of batches searched for one with the same texture. Limits the cost of adding a quad
+constexpr unsigned maxLookBack = 8;
+
+bool overlaps(const Point<float>& min1, const Point<float>& max1, const Point<float>& min2, const Point<float>& max2)
+{
+    return min1.x < max2.x && min2.x < max1.x && min1.y < max2.y && min2.y < max1.y;
+}
+} // namespace
+
+SpriteBatch::SpriteBatch() : numBatches_(0) {}
+
+void SpriteBatch::add(unsigned texture, const Point<float>* vertices, const Point<float>* texCoords,
+                      const GL_RGBAColor* colors, unsigned numVertices)
+{
+    RTTR_Assert(numVertices > 0u && numVertices % 4u == 0u);
+    Point<float> min = vertices[0], max = vertices[0];
+    for(unsigned i = 1; i < numVertices; i++)
+    {
+        min = elMin(min, vertices[i]);
+        max = elMax(max, vertices[i]);
+    }
+
+    Batch* batch = nullptr;
+    for(unsigned i = numBatches_; i > 0u && numBatches_ - i < maxLookBack; i--)
+    {
+        Batch& curBatch = batches_[i - 1];
+        if(curBatch.texture == texture)
+        {
+            batch = &curBatch;
+            break;
+        }
+        // Quads covered by this one must be drawn first
+        if(overlaps(min, max, curBatch.min, curBatch.max))
+            break;
+    }
+    if(batch)
+    {
+        batch->min = elMin(batch->min, min);
+        batch->max = elMax(batch->max, max);
+    } else
+    {
+        if(numBatches_ == batches_.size())
+            batches_.emplace_back();
+        batch = &batches_[numBatches_++];
+        batch->texture = texture;
+        batch->min = min;
+        batch->max = max;
+        batch->vertices.clear();
+        batch->texCoords.clear();
+        batch->colors.clear();
+    }
+    batch->vertices.insert(batch->vertices.end(), vertices, vertices + numVertices);
+    batch->texCoords.insert(batch->texCoords.end(), texCoords, texCoords + numVertices);
+    batch->colors.insert(batch->colors.end(), colors, colors + numVertices);
+}
+
+void SpriteBatch::flush()
+{
+    if(empty())
+        return;
+    glEnableClientState(GL_COLOR_ARRAY);
+    for(unsigned i = 0; i < numBatches_; i++)
+    {
+        const Batch& batch = batches_[i];
+        glVertexPointer(2, GL_FLOAT, 0, batch.vertices.data());
+        glTexCoordPointer(2, GL_FLOAT, 0, batch.texCoords.data());
+        glColorPointer(4, GL_UNSIGNED_BYTE, 0, batch.colors.data());
+        VIDEODRIVER.BindTexture(batch.texture);
+        glDrawArrays(GL_QUADS, 0, batch.vertices.size());
+    }
+    glDisableClientState(GL_COLOR_ARRAY);
+    VIDEODRIVER.CountDrawCalls(numBatches_);
+    clear();
+}
+
+void SpriteBatch::clear()
+{
+    numBatches_ = 0;
+}
+
+unsigned SpriteBatch::getNumQuads() const
+{
+    unsigned numQuads = 0;
+    for(unsigned i = 0; i < numBatches_; i++)
+        numQuads += batches_[i].vertices.size() / 4u;
+    return numQuads;
+}
@@ -0,0 +1,50 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "Point.h"
+#include <cstdint>
+#include <vector>
+
+/// Color of a vertex as used by glColorPointer
+struct GL_RGBAColor
+{
+    uint8_t r, g, b, a;
+};
+
+/// Collects textured quads and draws all consecutive quads with the same texture in a single call.
+/// A quad is also added to an earlier batch with the same texture if it does not overlap any quad added after that
+/// batch. So the result is the same as drawing the quads in the order they were added
+class SpriteBatch
+{
+public:
+    SpriteBatch();
+
+    /// Add quads with 4 vertices each in GL_QUADS order
+    void add(unsigned texture, const Point<float>* vertices, const Point<float>* texCoords,
+             const GL_RGBAColor* colors, unsigned numVertices);
+    /// Draw all quads and clear the batch
+    void flush();
+    void clear();
+
+    bool empty() const { return numBatches_ == 0u; }
+    /// Return the number of draw calls required for the current quads
+    unsigned getNumBatches() const { return numBatches_; }
+    unsigned getNumQuads() const;
+
+private:
+    struct Batch
+    {
+        unsigned texture;
+        /// Bounding box of all quads
+        Point<float> min, max;
+        std::vector<Point<float>> vertices, texCoords;
+        std::vector<GL_RGBAColor> colors;
+    };
+
+    /// Only the first numBatches_ are used, the others keep their memory for the next frame
+    std::vector<Batch> batches_;
+    unsigned numBatches_;
+};
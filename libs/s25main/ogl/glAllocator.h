@@ -6,6 +6,8 @@
 
 #include "libsiedler2/StandardAllocator.h"
 
+/// Creates the GL versions of the items. Archives are decoded concurrently by the Loader,
+/// so this must stay stateless and the items must not access GL before they are used
 class GlAllocator : public libsiedler2::StandardAllocator
 {
 public:
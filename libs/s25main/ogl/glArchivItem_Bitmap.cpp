@@ -5,6 +5,7 @@
 #include "glArchivItem_Bitmap.h"
 #include "Point.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "ogl/SpriteBatch.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
 
@@ -56,11 +57,24 @@ void glArchivItem_Bitmap::Draw(Rect dstArea, Rect srcArea, unsigned color /*= CO
     texCoords[0].y = texCoords[3].y = srcOrig.y;
     texCoords[1].y = texCoords[2].y = srcEndPt.y;
 
+    if(SpriteBatch* batch = VIDEODRIVER.GetSpriteBatch())
+    {
+        std::array<GL_RGBAColor, 4> colors;
+        colors[0].r = GetRed(color);
+        colors[0].g = GetGreen(color);
+        colors[0].b = GetBlue(color);
+        colors[0].a = GetAlpha(color);
+        colors[3] = colors[2] = colors[1] = colors[0];
+        batch->add(GetTexture(), vertices.data(), texCoords.data(), colors.data(), 4);
+        return;
+    }
+
     glVertexPointer(2, GL_FLOAT, 0, vertices.data());
     glTexCoordPointer(2, GL_FLOAT, 0, texCoords.data());
     VIDEODRIVER.BindTexture(GetTexture());
     glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
     glDrawArrays(GL_QUADS, 0, 4);
+    VIDEODRIVER.CountDrawCalls();
 }
 
 void glArchivItem_Bitmap::DrawFull(const Rect& destArea, unsigned color)
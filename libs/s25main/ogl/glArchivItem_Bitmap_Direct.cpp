@@ -6,12 +6,16 @@
 #include "drivers/VideoDriverWrapper.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
+#include <algorithm>
 #include <stdexcept>
 
-glArchivItem_Bitmap_Direct::glArchivItem_Bitmap_Direct() : isUpdating_(false) {}
+constexpr unsigned glArchivItem_Bitmap_Direct::updateTileSize;
+
+glArchivItem_Bitmap_Direct::glArchivItem_Bitmap_Direct() : isUpdating_(false), numTiles_(0, 0) {}
 
 glArchivItem_Bitmap_Direct::glArchivItem_Bitmap_Direct(const glArchivItem_Bitmap_Direct& item)
-    : ArchivItem_BitmapBase(item), baseArchivItem_Bitmap(item), glArchivItem_Bitmap(item), isUpdating_(false)
+    : ArchivItem_BitmapBase(item), baseArchivItem_Bitmap(item), glArchivItem_Bitmap(item), isUpdating_(false),
+      numTiles_(0, 0)
 {}
 
 void glArchivItem_Bitmap_Direct::beginUpdate()
@@ -19,7 +23,8 @@ void glArchivItem_Bitmap_Direct::beginUpdate()
     if(isUpdating_)
         throw std::logic_error("Already updating! Forgot an endUpdate?");
     isUpdating_ = true;
-    areaToUpdate_ = Rect(0, 0, 0, 0);
+    numTiles_ = (GetSize() + Extent::all(updateTileSize - 1)) / updateTileSize;
+    dirtyTiles_.assign(prodOfComponents(numTiles_), false);
 }
 
 void glArchivItem_Bitmap_Direct::endUpdate()
@@ -27,12 +32,32 @@ void glArchivItem_Bitmap_Direct::endUpdate()
     if(!isUpdating_)
         throw std::logic_error("Already updating! Forgot an endUpdate?");
     isUpdating_ = false;
-    // Nothing to update or no texture created yet
-    if(prodOfComponents(areaToUpdate_.getSize()) == 0 || !GetTexNoCreate())
+    // No texture created yet
+    if(!GetTexNoCreate())
         return;
 
-    libsiedler2::PixelBufferBGRA buffer(areaToUpdate_.getSize().x, areaToUpdate_.getSize().y);
-    Position origin = areaToUpdate_.getOrigin();
+    // Upload each run of adjacent dirty tiles in a row of tiles as one rectangle
+    for(unsigned tileY = 0; tileY < numTiles_.y; tileY++)
+    {
+        const auto rowBegin = dirtyTiles_.begin() + tileY * numTiles_.x;
+        const auto rowEnd = rowBegin + numTiles_.x;
+        for(auto runBegin = std::find(rowBegin, rowEnd, true); runBegin != rowEnd;)
+        {
+            const auto runEnd = std::find(runBegin, rowEnd, false);
+            const unsigned left = (runBegin - rowBegin) * updateTileSize;
+            const unsigned top = tileY * updateTileSize;
+            const unsigned right = std::min<unsigned>((runEnd - rowBegin) * updateTileSize, GetSize().x);
+            const unsigned bottom = std::min(top + updateTileSize, GetSize().y);
+            uploadArea(Rect(left, top, right - left, bottom - top));
+            runBegin = std::find(runEnd, rowEnd, true);
+        }
+    }
+}
+
+void glArchivItem_Bitmap_Direct::uploadArea(const Rect& area)
+{
+    libsiedler2::PixelBufferBGRA buffer(area.getSize().x, area.getSize().y);
+    const Position origin = area.getOrigin();
     int ec = print(buffer, nullptr, 0, 0, origin.x, origin.y);
     RTTR_Assert(ec == 0);
     VIDEODRIVER.BindTexture(GetTexNoCreate());
@@ -46,19 +71,5 @@ void glArchivItem_Bitmap_Direct::updatePixel(const DrawPoint& pos, const libsied
     RTTR_Assert(pos.x >= 0 && pos.y >= 0);
     RTTR_Assert(static_cast<unsigned>(pos.x) < GetSize().x && static_cast<unsigned>(pos.y) < GetSize().y);
     setPixel(pos.x, pos.y, clr);
-    // If the area is empty, create one
-    if(areaToUpdate_.getSize().x == 0)
-        areaToUpdate_ = Rect(Position(pos), Extent(1, 1));
-    else
-    {
-        // Else resize if required
-        if(pos.x < areaToUpdate_.left)
-            areaToUpdate_.left = pos.x;
-        if(pos.x >= areaToUpdate_.right)
-            areaToUpdate_.right = pos.x + 1;
-        if(pos.y < areaToUpdate_.top)
-            areaToUpdate_.top = pos.y;
-        if(pos.y >= areaToUpdate_.bottom)
-            areaToUpdate_.bottom = pos.y + 1;
-    }
+    dirtyTiles_[(pos.y / updateTileSize) * numTiles_.x + pos.x / updateTileSize] = true;
 }
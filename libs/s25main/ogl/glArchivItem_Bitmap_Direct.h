@@ -6,6 +6,7 @@
 
 #include "Rect.h"
 #include "glArchivItem_Bitmap.h"
+#include <vector>
 
 namespace libsiedler2 {
 struct ColorBGRA;
@@ -21,7 +22,7 @@ public:
 
     /// Call before updating texture
     void beginUpdate();
-    /// Call after updating texture
+    /// Call after updating texture. Uploads only the tiles containing changed pixels
     void endUpdate();
     /// Updates a pixels color
     void updatePixel(const DrawPoint& pos, const libsiedler2::ColorBGRA& clr);
@@ -32,6 +33,16 @@ public:
     int write(std::ostream& /*file*/, const libsiedler2::ArchivItem_Palette* /*palette*/) const override { return 254; }
 
 private:
+    /// Size of the square tiles in which changed pixels are tracked.
+    /// Changes in distant parts of the texture then don't require uploading everything in between
+    static constexpr unsigned updateTileSize = 64;
+
+    /// Upload the given part of the bitmap to the texture
+    void uploadArea(const Rect& area);
+
     bool isUpdating_;
-    Rect areaToUpdate_;
+    /// Number of tiles in x and y direction
+    Extent numTiles_;
+    /// Tiles containing changed pixels (row-major)
+    std::vector<bool> dirtyTiles_;
 };
@@ -6,16 +6,10 @@
 #include "Loader.h"
 #include "Point.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "ogl/SpriteBatch.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
 
-namespace {
-struct GL_RGBAColor
-{
-    GLbyte r, g, b, a;
-};
-} // namespace
-
 Extent glArchivItem_Bitmap_Player::CalcTextureSize() const
 {
     // We have the texture 2 times: one with non-player colors and one with them
@@ -101,6 +95,12 @@ void glArchivItem_Bitmap_Player::Draw(Rect dstArea, Rect srcArea, unsigned color
     colors[4].a = GetAlpha(player_color);
     colors[7] = colors[6] = colors[5] = colors[4];
 
+    if(SpriteBatch* batch = VIDEODRIVER.GetSpriteBatch())
+    {
+        batch->add(GetTexture(), vertices.data(), texCoords.data(), colors.data(), 8);
+        return;
+    }
+
     glEnableClientState(GL_COLOR_ARRAY);
     glVertexPointer(2, GL_FLOAT, 0, vertices.data());
     glTexCoordPointer(2, GL_FLOAT, 0, texCoords.data());
@@ -108,6 +108,7 @@ void glArchivItem_Bitmap_Player::Draw(Rect dstArea, Rect srcArea, unsigned color
     VIDEODRIVER.BindTexture(GetTexture());
     glDrawArrays(GL_QUADS, 0, 8);
     glDisableClientState(GL_COLOR_ARRAY);
+    VIDEODRIVER.CountDrawCalls();
 }
 
 void glArchivItem_Bitmap_Player::FillTexture()
@@ -254,6 +254,7 @@ void glFont::Draw(DrawPoint pos, const std::string& text, FontStyle format, unsi
     VIDEODRIVER.BindTexture(texture);
     glColor4ub(GetRed(color), GetGreen(color), GetBlue(color), GetAlpha(color));
     glDrawArrays(GL_QUADS, 0, texList.vertices.size());
+    VIDEODRIVER.CountDrawCalls();
 }
 
 template<bool T_limitWidth>
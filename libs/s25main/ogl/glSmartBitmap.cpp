@@ -5,6 +5,7 @@
 #include "glSmartBitmap.h"
 #include "Loader.h"
 #include "drivers/VideoDriverWrapper.h"
+#include "ogl/SpriteBatch.h"
 #include "ogl/glBitmapItem.h"
 #include "libsiedler2/ArchivItem_Bitmap.h"
 #include "libsiedler2/ArchivItem_Bitmap_Player.h"
@@ -13,13 +14,6 @@
 #include <glad/glad.h>
 #include <limits>
 
-namespace {
-struct GL_RGBAColor
-{
-    GLbyte r, g, b, a;
-};
-} // namespace
-
 glSmartBitmap::glSmartBitmap() : origin_(0, 0), size_(0, 0), sharedTexture(false), texture(0), hasPlayer(false) {}
 
 glSmartBitmap::~glSmartBitmap()
@@ -306,6 +300,12 @@ void glSmartBitmap::drawPercent(DrawPoint drawPt, unsigned percent, unsigned col
     } else
         numQuads = 4;
 
+    if(SpriteBatch* batch = VIDEODRIVER.GetSpriteBatch())
+    {
+        batch->add(texture, vertices.data(), curTexCoords.data(), colors.data(), numQuads);
+        return;
+    }
+
     glEnableClientState(GL_COLOR_ARRAY);
     glVertexPointer(2, GL_FLOAT, 0, vertices.data());
     glTexCoordPointer(2, GL_FLOAT, 0, curTexCoords.data());
@@ -313,4 +313,5 @@ void glSmartBitmap::drawPercent(DrawPoint drawPt, unsigned percent, unsigned col
     VIDEODRIVER.BindTexture(texture);
     glDrawArrays(GL_QUADS, 0, numQuads);
     glDisableClientState(GL_COLOR_ARRAY);
+    VIDEODRIVER.CountDrawCalls();
 }
@@ -3,13 +3,19 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "glTexturePacker.h"
+#include "RTTR_Assert.h"
 #include "drivers/VideoDriverWrapper.h"
 #include "ogl/glSmartBitmap.h"
 #include "ogl/glTexturePackerNode.h"
 #include "ogl/saveBitmap.h"
 #include "libsiedler2/PixelBufferBGRA.h"
 #include <glad/glad.h>
+#include <boost/filesystem/operations.hpp>
+#include <boost/iostreams/device/mapped_file.hpp>
+#include <boost/nowide/fstream.hpp>
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <memory>
 #include <utility>
 
@@ -20,6 +26,49 @@ static bool isSizeGreater(glSmartBitmap* a, glSmartBitmap* b)
     return (sizeA.x * sizeA.y) > (sizeB.x * sizeB.y);
 }
 
+namespace {
+/// Start of a cache file, also detects a different byte order
+constexpr uint32_t cacheMagic = 0x52545843;
+/// Increase when the layout of the cache file or the drawing of the bitmaps changes
+constexpr uint32_t cacheVersion = 1;
+
+template<typename T>
+void writeValue(std::ostream& stream, const T& value)
+{
+    stream.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/// Reads from the (mapped) content of a cache file
+class CacheReader
+{
+    const char* pos_;
+    const char* const end_;
+
+public:
+    CacheReader(const char* data, size_t size) : pos_(data), end_(data + size) {}
+
+    size_t getRemaining() const { return static_cast<size_t>(end_ - pos_); }
+    template<typename T>
+    bool read(T& value)
+    {
+        if(getRemaining() < sizeof(value))
+            return false;
+        std::memcpy(&value, pos_, sizeof(value));
+        pos_ += sizeof(value);
+        return true;
+    }
+    /// Return the next numBytes bytes or nullptr if the file is too short
+    const uint8_t* readBytes(size_t numBytes)
+    {
+        if(getRemaining() < numBytes)
+            return nullptr;
+        const auto* result = reinterpret_cast<const uint8_t*>(pos_);
+        pos_ += numBytes;
+        return result;
+    }
+};
+} // namespace
+
 bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
 {
     glTexture texture;
@@ -86,6 +135,11 @@ bool glTexturePacker::packHelper(std::vector<glSmartBitmap*>& list)
             root->destroy(list.size());
             root.reset();
 
+            if(keepPixels)
+            {
+                const auto* pixels = reinterpret_cast<const uint8_t*>(buffer.getPixelPtr());
+                texturePixels.emplace_back(pixels, pixels + curSize.x * curSize.y * 4u);
+            }
             if(!texture.uploadData(buffer))
                 return false;
 
@@ -131,6 +185,150 @@ bool glTexturePacker::pack()
     return false;
 }
 
+bool glTexturePacker::pack(const bfs::path& cacheFilePath, uint32_t key)
+{
+    if(loadCache(cacheFilePath, key))
+        return true;
+
+    // Packing sorts the items, but the cache stores them in the order they were added
+    const std::vector<glSmartBitmap*> addedItems = items;
+    keepPixels = true;
+    const bool result = pack();
+    if(result)
+        saveCache(cacheFilePath, key, addedItems);
+    keepPixels = false;
+    texturePixels.clear();
+    texturePixels.shrink_to_fit();
+    return result;
+}
+
+/* Layout of the cache file (native byte order):
+ *   magic, version, key, numTextures, numItems
+ *   numTextures x (width, height)
+ *   numItems x (required width, required height, texture index, 8 x texture coordinate)
+ *   numTextures x BGRA pixels
+ **/
+bool glTexturePacker::loadCache(const bfs::path& filePath, uint32_t key)
+{
+    boost::system::error_code ec;
+    if(!bfs::exists(filePath, ec))
+        return false;
+    boost::iostreams::mapped_file_source file;
+    try
+    {
+        file.open(filePath.string());
+    } catch(const std::exception&)
+    {
+        return false;
+    }
+    CacheReader reader(file.data(), file.size());
+
+    uint32_t magic, version, fileKey, numTextures, numItems;
+    if(!reader.read(magic) || magic != cacheMagic || !reader.read(version) || version != cacheVersion
+       || !reader.read(fileKey) || fileKey != key || !reader.read(numTextures) || !reader.read(numItems)
+       || numItems != items.size() || numTextures > reader.getRemaining())
+        return false;
+
+    std::vector<Extent> textureSizes(numTextures);
+    for(Extent& size : textureSizes)
+    {
+        if(!reader.read(size.x) || !reader.read(size.y))
+            return false;
+    }
+
+    struct CachedItem
+    {
+        unsigned texture;
+        std::array<Point<float>, 8> texCoords;
+    };
+    std::vector<CachedItem> cachedItems(numItems);
+    for(unsigned i = 0; i < numItems; i++)
+    {
+        Extent requiredSize;
+        if(!reader.read(requiredSize.x) || !reader.read(requiredSize.y)
+           || requiredSize != items[i]->getRequiredTexSize() || !reader.read(cachedItems[i].texture)
+           || cachedItems[i].texture >= numTextures)
+            return false;
+        for(Point<float>& texCoord : cachedItems[i].texCoords)
+        {
+            if(!reader.read(texCoord.x) || !reader.read(texCoord.y))
+                return false;
+        }
+    }
+
+    // The pixels are uploaded directly from the mapped file
+    std::vector<glTexture> cachedTextures;
+    for(const Extent& size : textureSizes)
+    {
+        const uint8_t* pixels = reader.readBytes(size_t(size.x) * size.y * 4u);
+        glTexture texture;
+        if(!pixels || !texture.uploadData(pixels, size))
+            return false;
+        cachedTextures.emplace_back(std::move(texture));
+    }
+
+    textures = std::move(cachedTextures);
+    for(unsigned i = 0; i < numItems; i++)
+    {
+        items[i]->texCoords = cachedItems[i].texCoords;
+        items[i]->setSharedTexture(textures[cachedItems[i].texture].get());
+    }
+    return true;
+}
+
+bool glTexturePacker::saveCache(const bfs::path& filePath, uint32_t key,
+                                const std::vector<glSmartBitmap*>& addedItems) const
+{
+    RTTR_Assert(texturePixels.size() == textures.size());
+    std::vector<uint32_t> itemTextures;
+    itemTextures.reserve(addedItems.size());
+    for(const glSmartBitmap* bmp : addedItems)
+    {
+        const auto itTexture = std::find_if(textures.begin(), textures.end(), [bmp](const glTexture& texture) {
+            return texture.get() == bmp->getTexture();
+        });
+        if(itTexture == textures.end())
+            return false;
+        itemTextures.push_back(static_cast<uint32_t>(itTexture - textures.begin()));
+    }
+
+    boost::system::error_code ec;
+    bfs::create_directories(filePath.parent_path(), ec);
+    // Write to a temporary file first, so an aborted write leaves no broken cache behind
+    const bfs::path tmpFilePath = filePath.string() + ".tmp";
+    {
+        boost::nowide::ofstream file(tmpFilePath, std::ios::binary);
+        writeValue(file, cacheMagic);
+        writeValue(file, cacheVersion);
+        writeValue(file, key);
+        writeValue(file, static_cast<uint32_t>(textures.size()));
+        writeValue(file, static_cast<uint32_t>(addedItems.size()));
+        for(const glTexture& texture : textures)
+        {
+            writeValue(file, static_cast<uint32_t>(texture.getSize().x));
+            writeValue(file, static_cast<uint32_t>(texture.getSize().y));
+        }
+        for(unsigned i = 0; i < addedItems.size(); i++)
+        {
+            const Extent requiredSize = addedItems[i]->getRequiredTexSize();
+            writeValue(file, static_cast<uint32_t>(requiredSize.x));
+            writeValue(file, static_cast<uint32_t>(requiredSize.y));
+            writeValue(file, itemTextures[i]);
+            for(const Point<float>& texCoord : addedItems[i]->texCoords)
+            {
+                writeValue(file, texCoord.x);
+                writeValue(file, texCoord.y);
+            }
+        }
+        for(const std::vector<uint8_t>& pixels : texturePixels)
+            file.write(reinterpret_cast<const char*>(pixels.data()), pixels.size());
+        if(!file)
+            return false;
+    }
+    bfs::rename(tmpFilePath, filePath, ec);
+    return !ec;
+}
+
 glTexture::glTexture() : handle(VIDEODRIVER.GenerateTexture()), size(0, 0)
 {
     if(!handle)
@@ -175,13 +373,18 @@ bool glTexture::checkSize(const Extent& size) const
 }
 
 bool glTexture::uploadData(const libsiedler2::PixelBufferBGRA& buffer)
+{
+    return uploadData(reinterpret_cast<const uint8_t*>(buffer.getPixelPtr()),
+                      Extent(buffer.getWidth(), buffer.getHeight()));
+}
+
+bool glTexture::uploadData(const uint8_t* pixels, const Extent& texSize)
 {
     if(!handle)
         return false;
     VIDEODRIVER.BindTexture(handle);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, buffer.getWidth(), buffer.getHeight(), 0, GL_BGRA, GL_UNSIGNED_BYTE,
-                 buffer.getPixelPtr());
-    size = Extent(buffer.getWidth(), buffer.getHeight());
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, texSize.x, texSize.y, 0, GL_BGRA, GL_UNSIGNED_BYTE, pixels);
+    size = texSize;
     int resultWidth;
     glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &resultWidth);
     return resultWidth > 0;
@@ -5,6 +5,8 @@
 #pragma once
 
 #include "Point.h"
+#include <boost/filesystem/path.hpp>
+#include <cstdint>
 #include <vector>
 
 class glSmartBitmap;
@@ -33,6 +35,8 @@ public:
     void bind() const;
     bool checkSize(const Extent&) const;
     bool uploadData(const libsiedler2::PixelBufferBGRA&);
+    /// Upload the BGRA pixels of an image with the given size
+    bool uploadData(const uint8_t* pixels, const Extent& texSize);
 };
 
 class glTexturePacker
@@ -40,11 +44,21 @@ class glTexturePacker
 private:
     std::vector<glTexture> textures;
     std::vector<glSmartBitmap*> items;
+    /// Pixels of the packed textures. Only kept while packing for the cache
+    std::vector<std::vector<uint8_t>> texturePixels;
+    bool keepPixels = false;
 
     bool packHelper(std::vector<glSmartBitmap*>& list);
+    bool saveCache(const boost::filesystem::path& filePath, uint32_t key,
+                   const std::vector<glSmartBitmap*>& addedItems) const;
 
 public:
     bool pack();
+    /// Same as pack() but uses the cache file if possible. Otherwise it is (re)written after packing
+    bool pack(const boost::filesystem::path& cacheFilePath, uint32_t key);
+    /// Use the textures from the cache file if it was written for bitmaps of the same sizes with the same key.
+    /// The key has to identify the content of the bitmaps
+    bool loadCache(const boost::filesystem::path& filePath, uint32_t key);
     void add(glSmartBitmap& bmp) { items.push_back(&bmp); }
     const auto& getTextures() const { return textures; }
 };
@@ -0,0 +1,59 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "pathfinding/FreePathCache.h"
+#include "enum_cast.hpp"
+#include "world/RegionEpochs.h"
+#include <boost/container_hash/hash.hpp>
+#include <algorithm>
+#include <utility>
+
+constexpr unsigned FreePathCache::maxEntries;
+
+size_t FreePathCache::KeyHasher::operator()(const Key& key) const
+{
+    size_t result = 0;
+    boost::hash_combine(result, key.start.x);
+    boost::hash_combine(result, key.start.y);
+    boost::hash_combine(result, key.dest.x);
+    boost::hash_combine(result, key.dest.y);
+    boost::hash_combine(result, key.maxLength);
+    boost::hash_combine(result, rttr::enum_cast(key.startDir));
+    boost::hash_combine(result, rttr::enum_cast(key.condition));
+    return result;
+}
+
+FreePathCache::FreePathCache() : entries_(maxEntries), numHits_(0), numMisses_(0) {}
+
+const FreePathCache::Result* FreePathCache::Find(const Key& key, const RegionEpochs& regionEpochs,
+                                                 const bool needRoute)
+{
+    const Entry* entry = entries_.find(key);
+    // Results of searches for the length only are replaced by the new search
+    if(entry && (!needRoute || !entry->result.found || entry->result.hasRoute))
+    {
+        const bool isValid = std::none_of(entry->regions.begin(), entry->regions.end(), [&](unsigned region) {
+            return regionEpochs.GetEpoch(region) > entry->epoch;
+        });
+        if(isValid)
+        {
+            ++numHits_;
+            return &entry->result;
+        }
+        entries_.erase(key);
+    }
+    ++numMisses_;
+    return nullptr;
+}
+
+const FreePathCache::Result& FreePathCache::Add(const Key& key, Result result, std::vector<unsigned> regions,
+                                                unsigned epoch)
+{
+    return entries_.insert(key, Entry{std::move(result), std::move(regions), epoch}).result;
+}
+
+void FreePathCache::Clear()
+{
+    entries_.clear();
+}
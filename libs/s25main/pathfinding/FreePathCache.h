@@ -0,0 +1,80 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "helpers/LRUCache.h"
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class RegionEpochs;
+
+/// Conditions for free paths which only depend on the map (terrain, objects and roads)
+enum class FreePathCondition : uint8_t
+{
+    Human,
+    Ship
+};
+
+/// Cache for the results of the FreePathFinder.
+/// Each result stores the map regions in which the search expanded nodes. It is only used if nothing changed in those
+/// regions since then, so it is exactly the result a new search would return.
+class FreePathCache
+{
+public:
+    /// All parameters of a search which influence the result
+    struct Key
+    {
+        MapPoint start, dest;
+        unsigned maxLength;
+        Direction startDir;
+        FreePathCondition condition;
+
+        bool operator==(const Key& rhs) const
+        {
+            return start == rhs.start && dest == rhs.dest && maxLength == rhs.maxLength && startDir == rhs.startDir
+                   && condition == rhs.condition;
+        }
+    };
+    struct Result
+    {
+        bool found;
+        unsigned length;
+        /// Route if found and requested by the search
+        std::vector<Direction> route;
+        bool hasRoute;
+    };
+
+    static constexpr unsigned maxEntries = 256;
+
+    FreePathCache();
+
+    /// Return the result for the key if it is still valid (and contains the route if required) or nullptr
+    const Result* Find(const Key& key, const RegionEpochs& regionEpochs, bool needRoute);
+    /// Add the result of a search which expanded nodes in the given regions at the given epoch
+    const Result& Add(const Key& key, Result result, std::vector<unsigned> regions, unsigned epoch);
+    void Clear();
+
+    unsigned GetSize() const { return entries_.size(); }
+    unsigned GetNumHits() const { return numHits_; }
+    unsigned GetNumMisses() const { return numMisses_; }
+
+private:
+    struct Entry
+    {
+        Result result;
+        std::vector<unsigned> regions;
+        unsigned epoch;
+    };
+    struct KeyHasher
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    helpers::LRUCache<Key, Entry, KeyHasher> entries_;
+    unsigned numHits_, numMisses_;
+};
@@ -10,6 +10,7 @@
 #include "pathfinding/PathfindingPoint.h"
 #include "world/GameWorldBase.h"
 #include "s25util/Log.h"
+#include <algorithm>
 
 //////////////////////////////////////////////////////////////////////////
 /// FreePathFinder implementation
@@ -20,23 +21,32 @@ using MapNodes = std::vector<NewNode>;
 using FreePathNodes = std::vector<FreePathNode>;
 MapNodes nodes;
 FreePathNodes fpNodes;
+FreePathNodes fpNodesBackward;
 
 void FreePathFinder::Init(const MapExtent& mapSize)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     currentVisit = 0;
     size_ = Extent(mapSize);
     // Reset nodes
     nodes.clear();
     fpNodes.clear();
+    fpNodesBackward.clear();
     nodes.resize(size_.x * size_.y);
     fpNodes.resize(nodes.size());
+    fpNodesBackward.resize(nodes.size());
     RTTR_FOREACH_PT(MapPoint, size_)
     {
         const unsigned idx = gwb_.GetIdx(pt);
         nodes[idx].mapPt = pt;
         fpNodes[idx].lastVisited = 0;
         fpNodes[idx].mapPt = pt;
+        fpNodesBackward[idx].lastVisited = 0;
+        fpNodesBackward[idx].mapPt = pt;
     }
+    regionVisits_.assign(gwb_.GetRegionEpochs().GetNumRegions(), 0);
+    visitedRegions_.clear();
+    cache_.Clear();
 }
 
 void FreePathFinder::IncreaseCurrentVisit()
@@ -53,6 +63,9 @@ void FreePathFinder::IncreaseCurrentVisit()
         {
             fpNode.lastVisited = 0;
         }
+        for(auto& fpNode : fpNodesBackward)
+            fpNode.lastVisited = 0;
+        std::fill(regionVisits_.begin(), regionVisits_.end(), 0);
         currentVisit = 1;
     } else
         currentVisit++;
@@ -65,6 +78,7 @@ bool FreePathFinder::FindPathAlternatingConditions(const MapPoint start, const M
                                                    FP_Node_OK_Callback IsNodeOKAlternate,
                                                    FP_Node_OK_Callback IsNodeToDestOk, const void* param)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     if(start == dest)
     {
         // Path where start==goal should never happen
@@ -4,8 +4,10 @@
 
 #pragma once
 
+#include "pathfinding/FreePathCache.h"
 #include "gameTypes/Direction.h"
 #include "gameTypes/MapCoordinates.h"
+#include <mutex>
 #include <vector>
 
 class GameWorldBase;
@@ -21,9 +23,17 @@ class FreePathFinder
     GameWorldBase& gwb_;
     unsigned currentVisit;
     Extent size_;
+    FreePathCache cache_;
+    /// If set, FindPath stores the map regions of all expanded nodes in visitedRegions_
+    bool recordRegions_;
+    std::vector<unsigned> visitedRegions_;
+    /// Value of currentVisit when the region was added to visitedRegions_
+    std::vector<unsigned> regionVisits_;
+    /// Searches share the node data and the cache, so concurrent searches (e.g. by AIs) must be serialized
+    std::recursive_mutex mutex_;
 
 public:
-    FreePathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0), size_(0, 0) {}
+    FreePathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0), size_(0, 0), recordRegions_(false) {}
     void Init(const MapExtent& mapSize);
 
     /// Wegfindung in freiem Terrain - Template version. Users need to include FreePathFinderImpl.h
@@ -32,6 +42,21 @@ public:
     template<class TNodeChecker>
     bool FindPath(MapPoint start, MapPoint dest, bool randomRoute, unsigned maxLength, std::vector<Direction>* route,
                   unsigned* length, Direction* firstDir, const TNodeChecker& nodeChecker);
+    /// Return whether there is a path of at most maxLength and its length. Same result as FindPath but uses a
+    /// bidirectional search which is faster for long paths and unreachable goals
+    template<class TNodeChecker>
+    bool FindPathLength(MapPoint start, MapPoint dest, unsigned maxLength, unsigned* length,
+                        const TNodeChecker& nodeChecker);
+    /// Same as FindPathLength but returns cached results if possible
+    template<class TNodeChecker>
+    bool FindPathLengthCached(FreePathCondition condition, MapPoint start, MapPoint dest, unsigned maxLength,
+                              unsigned* length, const TNodeChecker& nodeChecker);
+    /// Same as FindPath but returns cached results if possible.
+    /// The result of the nodeChecker must only depend on the map as described by the condition
+    template<class TNodeChecker>
+    bool FindPathCached(FreePathCondition condition, MapPoint start, MapPoint dest, bool randomRoute,
+                        unsigned maxLength, std::vector<Direction>* route, unsigned* length, Direction* firstDir,
+                        const TNodeChecker& nodeChecker);
 
     bool FindPathAlternatingConditions(MapPoint start, MapPoint dest, bool randomRoute, unsigned maxLength,
                                        std::vector<Direction>* route, unsigned* length, Direction* firstDir,
@@ -43,6 +68,18 @@ public:
     bool CheckRoute(MapPoint start, const std::vector<Direction>& route, unsigned pos, const TNodeChecker& nodeChecker,
                     MapPoint* dest) const;
 
+    /// Return the direction in which the search starts to look at the neighbors.
+    /// For random routes it depends on the start point and the current GF
+    Direction GetStartDir(MapPoint start, bool randomRoute) const;
+
+    const FreePathCache& GetCache() const { return cache_; }
+    void ClearCache()
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        cache_.Clear();
+    }
+
 private:
     void IncreaseCurrentVisit();
+    void RecordRegion(MapPoint pt);
 };
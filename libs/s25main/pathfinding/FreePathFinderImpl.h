@@ -11,9 +11,14 @@
 #include "pathfinding/OpenListPrioQueue.h"
 #include "pathfinding/PathfindingPoint.h"
 #include "world/GameWorldBase.h"
+#include "helpers/EnumRange.h"
+#include <algorithm>
+#include <limits>
 
 using FreePathNodes = std::vector<FreePathNode>;
 extern FreePathNodes fpNodes;
+/// Nodes for the backward direction of bidirectional searches
+extern FreePathNodes fpNodesBackward;
 
 struct NodePtrCmpGreater
 {
@@ -42,6 +47,7 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
                               std::vector<Direction>* route, unsigned* length, Direction* firstDir,
                               const TNodeChecker& nodeChecker)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     RTTR_Assert(start != dest);
 
     // increase currentVisit, so we don't have to clear the visited-states at every run
@@ -63,9 +69,7 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
     todo.push(&startNode);
 
     // Bei Zufälliger Richtung anfangen (damit man nicht immer denselben Weg geht, besonders für die Soldaten wichtig)
-    // TODO confirm random: RANDOM.Rand(__FILE__, __LINE__, y_start * GetWidth() + x_start, 6);
-    const Direction startDir =
-      randomRoute ? convertToDirection(gwb_.GetIdx(start) * gwb_.GetEvMgr().GetCurrentGF()) : Direction::West;
+    const Direction startDir = GetStartDir(start, randomRoute);
 
     while(!todo.empty())
     {
@@ -103,6 +107,9 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
         if(best.curDistance >= maxLength)
             continue;
 
+        if(recordRegions_)
+            RecordRegion(best.mapPt);
+
         // Knoten in alle 6 Richtungen bilden
         const auto neighbors = gwb_.GetNeighbours(best.mapPt);
         for(const Direction dir : helpers::enumRange(startDir))
@@ -164,6 +171,172 @@ bool FreePathFinder::FindPath(const MapPoint start, const MapPoint dest, bool ra
     return false;
 }
 
+template<class TNodeChecker>
+bool FreePathFinder::FindPathCached(const FreePathCondition condition, const MapPoint start, const MapPoint dest,
+                                    bool randomRoute, unsigned maxLength, std::vector<Direction>* route,
+                                    unsigned* length, Direction* firstDir, const TNodeChecker& nodeChecker)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    const FreePathCache::Key key{start, dest, maxLength, GetStartDir(start, randomRoute), condition};
+    const FreePathCache::Result* result = cache_.Find(key, gwb_.GetRegionEpochs(), true);
+    if(!result)
+    {
+        FreePathCache::Result newResult;
+        // All nodes whose state the search depends on are at most 1 away from an expanded node.
+        // Changes mark the regions around them, so storing the regions of the expanded nodes is enough
+        recordRegions_ = true;
+        visitedRegions_.clear();
+        newResult.found =
+          FindPath(start, dest, randomRoute, maxLength, &newResult.route, nullptr, nullptr, nodeChecker);
+        newResult.length = newResult.route.size();
+        newResult.hasRoute = true;
+        recordRegions_ = false;
+        result = &cache_.Add(key, std::move(newResult), visitedRegions_, gwb_.GetRegionEpochs().GetCurrentEpoch());
+    }
+    if(!result->found)
+        return false;
+    if(route)
+        *route = result->route;
+    if(length)
+        *length = result->length;
+    if(firstDir)
+        *firstDir = result->route.front();
+    return true;
+}
+
+template<class TNodeChecker>
+bool FreePathFinder::FindPathLength(const MapPoint start, const MapPoint dest, const unsigned maxLength,
+                                    unsigned* length, const TNodeChecker& nodeChecker)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    RTTR_Assert(start != dest);
+
+    IncreaseCurrentVisit();
+
+    // Search from the start to the dest (forward) and from the dest to the start (backward).
+    // Both use the same checks as FindPath: Nodes are checked except start and dest and edges in walking direction.
+    QueueImpl todoForward, todoBackward;
+    FreePathNode& startNode = fpNodes[gwb_.GetIdx(start)];
+    FreePathNode& destNode = fpNodesBackward[gwb_.GetIdx(dest)];
+    for(FreePathNode* node : {&startNode, &destNode})
+    {
+        node->targetDistance = gwb_.CalcDistance(start, dest);
+        node->estimatedDistance = node->targetDistance;
+        node->lastVisited = currentVisit;
+        node->prev = nullptr;
+        node->curDistance = 0;
+    }
+    todoForward.push(&startNode);
+    todoBackward.push(&destNode);
+
+    // Shortest path found so far, i.e. over a node reached by both searches
+    unsigned bestLength = std::numeric_limits<unsigned>::max();
+    const auto expandBest = [&](const bool backward) {
+        QueueImpl& todo = backward ? todoBackward : todoForward;
+        FreePathNodes& curNodes = backward ? fpNodesBackward : fpNodes;
+        const FreePathNodes& otherNodes = backward ? fpNodes : fpNodesBackward;
+        const MapPoint goal = backward ? start : dest;
+
+        FreePathNode& best = *todo.pop();
+        if(recordRegions_)
+            RecordRegion(best.mapPt);
+
+        const auto neighbors = gwb_.GetNeighbours(best.mapPt);
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            const MapPoint neighbourPos = neighbors[dir];
+            const unsigned nbId = gwb_.GetIdx(neighbourPos);
+            FreePathNode& neighbour = curNodes[nbId];
+            const bool isVisited = neighbour.lastVisited == currentVisit;
+            if(isVisited)
+            {
+                if(best.curDistance + 1 >= neighbour.curDistance)
+                    continue;
+            } else if(neighbourPos != goal && !nodeChecker.IsNodeOk(neighbourPos))
+                continue;
+
+            // Backwards we come from the neighbour
+            if(backward ? !nodeChecker.IsEdgeOk(neighbourPos, dir + 3u) : !nodeChecker.IsEdgeOk(best.mapPt, dir))
+                continue;
+
+            neighbour.curDistance = best.curDistance + 1;
+            if(isVisited)
+            {
+                neighbour.estimatedDistance = neighbour.curDistance + neighbour.targetDistance;
+                todo.rearrange(&neighbour);
+            } else
+            {
+                neighbour.lastVisited = currentVisit;
+                neighbour.targetDistance = gwb_.CalcDistance(neighbourPos, goal);
+                neighbour.estimatedDistance = neighbour.curDistance + neighbour.targetDistance;
+                todo.push(&neighbour);
+            }
+
+            const FreePathNode& otherNode = otherNodes[nbId];
+            if(otherNode.lastVisited == currentVisit)
+                bestLength = std::min(bestLength, neighbour.curDistance + otherNode.curDistance);
+        }
+    };
+
+    while(!todoForward.empty() && !todoBackward.empty())
+    {
+        // As long as a search has not reached its goal the smallest estimate is a lower bound for the shortest path.
+        // Otherwise the shortest path was already found
+        const unsigned lowerBound =
+          std::max(todoForward.top()->estimatedDistance, todoBackward.top()->estimatedDistance);
+        if(lowerBound >= bestLength || lowerBound > maxLength)
+            break;
+        // Continue with the smaller search
+        expandBest(todoBackward.size() < todoForward.size());
+    }
+
+    if(bestLength > maxLength)
+        return false;
+    if(length)
+        *length = bestLength;
+    return true;
+}
+
+template<class TNodeChecker>
+bool FreePathFinder::FindPathLengthCached(const FreePathCondition condition, const MapPoint start,
+                                          const MapPoint dest, unsigned maxLength, unsigned* length,
+                                          const TNodeChecker& nodeChecker)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    // The start direction does not change the length
+    const FreePathCache::Key key{start, dest, maxLength, Direction::West, condition};
+    const FreePathCache::Result* result = cache_.Find(key, gwb_.GetRegionEpochs(), false);
+    if(!result)
+    {
+        FreePathCache::Result newResult;
+        recordRegions_ = true;
+        visitedRegions_.clear();
+        newResult.found = FindPathLength(start, dest, maxLength, &newResult.length, nodeChecker);
+        newResult.hasRoute = false;
+        recordRegions_ = false;
+        result = &cache_.Add(key, std::move(newResult), visitedRegions_, gwb_.GetRegionEpochs().GetCurrentEpoch());
+    }
+    if(result->found && length)
+        *length = result->length;
+    return result->found;
+}
+
+inline Direction FreePathFinder::GetStartDir(const MapPoint start, const bool randomRoute) const
+{
+    // TODO confirm random: RANDOM.Rand(__FILE__, __LINE__, y_start * GetWidth() + x_start, 6);
+    return randomRoute ? convertToDirection(gwb_.GetIdx(start) * gwb_.GetEvMgr().GetCurrentGF()) : Direction::West;
+}
+
+inline void FreePathFinder::RecordRegion(const MapPoint pt)
+{
+    const unsigned region = gwb_.GetRegionEpochs().GetRegionIdx(pt);
+    if(regionVisits_[region] != currentVisit)
+    {
+        regionVisits_[region] = currentVisit;
+        visitedRegions_.push_back(region);
+    }
+}
+
 /// Ermittelt, ob eine freie Route noch passierbar ist und gibt den Endpunkt der Route zurück
 template<class TNodeChecker>
 bool FreePathFinder::CheckRoute(const MapPoint start, const std::vector<Direction>& route, unsigned pos,
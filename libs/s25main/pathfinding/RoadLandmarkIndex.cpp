@@ -0,0 +1,261 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "RoadLandmarkIndex.h"
+#include "RoadSegment.h"
+#include "RttrForeachPt.h"
+#include "buildings/nobHarborBuilding.h"
+#include "world/GameWorldBase.h"
+#include "nodeObjs/noRoadNode.h"
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <utility>
+
+constexpr unsigned RoadLandmarkIndex::maxLandmarks;
+constexpr unsigned RoadLandmarkIndex::minComponentSizeForLandmark;
+constexpr unsigned RoadLandmarkIndex::unreachable;
+constexpr unsigned RoadLandmarkIndex::maxAddedNodesPercent;
+
+RoadLandmarkIndex::RoadLandmarkIndex(const GameWorldBase& world)
+    : world_(world), isValid_(false), numComponents_(0), numLandmarks_(0), numRebuiltNodes_(0), numAddedNodes_(0)
+{}
+
+unsigned RoadLandmarkIndex::GetIndex(const noRoadNode& node) const
+{
+    const unsigned mapIdx = world_.GetIdx(node.GetPos());
+    if(mapIdx >= mapIdxToNode_.size())
+        return 0;
+    const unsigned idx = mapIdxToNode_[mapIdx];
+    // The node might have been replaced by another one since the last rebuild
+    if(idx == 0 || nodes_[idx - 1] != &node)
+        return 0;
+    return idx;
+}
+
+unsigned RoadLandmarkIndex::GetLowerBound(const noRoadNode& start, const noRoadNode& goal)
+{
+    if(!isValid_)
+        Rebuild();
+    const unsigned startIdx = GetIndex(start);
+    const unsigned goalIdx = GetIndex(goal);
+    // Nodes created after the last rebuild are not connected to anything known
+    if(!startIdx || !goalIdx)
+        return 0;
+    if(componentIds_[startIdx - 1] != componentIds_[goalIdx - 1])
+        return unreachable;
+    unsigned result = 0;
+    const unsigned* startCosts = &landmarkCosts_[(startIdx - 1) * maxLandmarks];
+    const unsigned* goalCosts = &landmarkCosts_[(goalIdx - 1) * maxLandmarks];
+    for(unsigned i = 0; i < numLandmarks_; i++)
+    {
+        // Landmark in another component
+        if(startCosts[i] == unreachable)
+            continue;
+        const unsigned bound =
+          (startCosts[i] > goalCosts[i]) ? startCosts[i] - goalCosts[i] : goalCosts[i] - startCosts[i];
+        result = std::max(result, bound);
+    }
+    return result;
+}
+
+unsigned RoadLandmarkIndex::GetOrAddNode(const noRoadNode& node)
+{
+    const unsigned idx = GetIndex(node);
+    if(idx)
+        return idx - 1;
+    nodes_.push_back(&node);
+    edges_.emplace_back();
+    componentIds_.push_back(numComponents_++);
+    landmarkCosts_.resize(landmarkCosts_.size() + maxLandmarks, unreachable);
+    // A node previously at this point stays in the graph like removed roads do
+    mapIdxToNode_[world_.GetIdx(node.GetPos())] = nodes_.size();
+    ++numAddedNodes_;
+    return nodes_.size() - 1;
+}
+
+void RoadLandmarkIndex::AddRoad(const noRoadNode& node1, const noRoadNode& node2, const unsigned costs)
+{
+    // Everything gets added on the rebuild
+    if(!isValid_)
+        return;
+    const unsigned idx1 = GetOrAddNode(node1);
+    const unsigned idx2 = GetOrAddNode(node2);
+    // The landmarks were chosen for a much smaller graph, so choose new ones
+    if(numAddedNodes_ * 100u > std::max(numRebuiltNodes_, minComponentSizeForLandmark) * maxAddedNodesPercent)
+    {
+        Invalidate();
+        return;
+    }
+    // Roads are reported by both of their nodes
+    const auto isSameOrBetter = [idx2, costs](const Edge& edge) { return edge.target == idx2 && edge.cost <= costs; };
+    if(std::any_of(edges_[idx1].begin(), edges_[idx1].end(), isSameOrBetter))
+        return;
+    edges_[idx1].push_back(Edge{idx2, costs});
+    edges_[idx2].push_back(Edge{idx1, costs});
+
+    const unsigned componentId1 = componentIds_[idx1];
+    const unsigned componentId2 = componentIds_[idx2];
+    if(componentId1 != componentId2)
+        std::replace(componentIds_.begin(), componentIds_.end(), componentId2, componentId1);
+
+    // Only costs can decrease which are reached over the new road
+    for(unsigned i = 0; i < numLandmarks_; i++)
+    {
+        const unsigned costs1 = landmarkCosts_[idx1 * maxLandmarks + i];
+        const unsigned costs2 = landmarkCosts_[idx2 * maxLandmarks + i];
+        if(costs1 != unreachable && costs1 + costs < costs2)
+            DecreaseLandmarkCosts(i, idx2, costs1 + costs);
+        else if(costs2 != unreachable && costs2 + costs < costs1)
+            DecreaseLandmarkCosts(i, idx1, costs2 + costs);
+    }
+}
+
+void RoadLandmarkIndex::AddEdge(unsigned from, const noRoadNode& to, unsigned cost)
+{
+    unsigned toIdx = GetIndex(to);
+    if(!toIdx)
+    {
+        // Node not on the map (e.g. during destruction): Keep it in the graph so paths over it are considered
+        // but don't map it so there will be no bounds for it
+        nodes_.push_back(&to);
+        edges_.emplace_back();
+        toIdx = nodes_.size();
+    }
+    // Store both directions so the graph is undirected (required for the bounds)
+    edges_[from].push_back(Edge{toIdx - 1, cost});
+    edges_[toIdx - 1].push_back(Edge{from, cost});
+}
+
+void RoadLandmarkIndex::Rebuild()
+{
+    nodes_.clear();
+    mapIdxToNode_.assign(world_.GetWidth() * world_.GetHeight(), 0);
+    RTTR_FOREACH_PT(MapPoint, world_.GetSize())
+    {
+        const auto* node = world_.GetSpecObj<noRoadNode>(pt);
+        if(node)
+        {
+            nodes_.push_back(node);
+            mapIdxToNode_[world_.GetIdx(pt)] = nodes_.size();
+        }
+    }
+    edges_.clear();
+    edges_.resize(nodes_.size());
+    // Nodes might be added while iterating
+    for(unsigned i = 0; i < nodes_.size(); i++)
+    {
+        const noRoadNode& node = *nodes_[i];
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            const RoadSegment* route = node.GetRoute(dir);
+            if(route)
+                AddEdge(i, *node.GetNeighbour(dir), route->GetLength());
+        }
+        if(node.GetGOT() == GO_Type::NobHarborbuilding)
+        {
+            for(const auto& sc : static_cast<const nobHarborBuilding&>(node).GetShipConnections())
+                AddEdge(i, *sc.dest, sc.way_costs);
+        }
+    }
+
+    const unsigned numNodes = nodes_.size();
+
+    // Label connected components
+    componentIds_.assign(numNodes, unreachable);
+    std::vector<unsigned> componentSizes;
+    std::vector<unsigned> todo;
+    for(unsigned i = 0; i < numNodes; i++)
+    {
+        if(componentIds_[i] != unreachable)
+            continue;
+        const unsigned componentId = componentSizes.size();
+        componentSizes.push_back(0);
+        componentIds_[i] = componentId;
+        todo.push_back(i);
+        while(!todo.empty())
+        {
+            const unsigned cur = todo.back();
+            todo.pop_back();
+            ++componentSizes.back();
+            for(const Edge& edge : edges_[cur])
+            {
+                if(componentIds_[edge.target] == unreachable)
+                {
+                    componentIds_[edge.target] = componentId;
+                    todo.push_back(edge.target);
+                }
+            }
+        }
+    }
+
+    numComponents_ = componentSizes.size();
+
+    // Choose landmarks: Each big enough component gets one first, then the nodes farthest away from all landmarks
+    landmarkCosts_.assign(numNodes * maxLandmarks, unreachable);
+    std::vector<bool> hasLandmark(componentSizes.size(), false);
+    std::vector<unsigned> minLandmarkCosts(numNodes, unreachable);
+    numLandmarks_ = 0;
+    while(numLandmarks_ < maxLandmarks)
+    {
+        unsigned bestNode = unreachable;
+        unsigned bestComponentSize = 0;
+        unsigned bestCosts = 0;
+        for(unsigned i = 0; i < numNodes; i++)
+        {
+            const unsigned componentId = componentIds_[i];
+            if(componentSizes[componentId] < minComponentSizeForLandmark)
+                continue;
+            if(!hasLandmark[componentId])
+            {
+                // Prefer the biggest component without a landmark
+                if(componentSizes[componentId] > bestComponentSize)
+                {
+                    bestComponentSize = componentSizes[componentId];
+                    bestNode = i;
+                }
+            } else if(!bestComponentSize && minLandmarkCosts[i] > bestCosts)
+            {
+                bestCosts = minLandmarkCosts[i];
+                bestNode = i;
+            }
+        }
+        if(bestNode == unreachable)
+            break;
+        hasLandmark[componentIds_[bestNode]] = true;
+        DecreaseLandmarkCosts(numLandmarks_, bestNode, 0);
+        for(unsigned i = 0; i < numNodes; i++)
+            minLandmarkCosts[i] = std::min(minLandmarkCosts[i], landmarkCosts_[i * maxLandmarks + numLandmarks_]);
+        ++numLandmarks_;
+    }
+
+    numRebuiltNodes_ = numNodes;
+    numAddedNodes_ = 0;
+    isValid_ = true;
+}
+
+void RoadLandmarkIndex::DecreaseLandmarkCosts(unsigned landmark, unsigned nodeIdx, unsigned costs)
+{
+    using QueueEntry = std::pair<unsigned, unsigned>; // Costs, node
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> todo;
+    landmarkCosts_[nodeIdx * maxLandmarks + landmark] = costs;
+    todo.emplace(costs, nodeIdx);
+    while(!todo.empty())
+    {
+        const QueueEntry cur = todo.top();
+        todo.pop();
+        if(cur.first > landmarkCosts_[cur.second * maxLandmarks + landmark])
+            continue;
+        for(const Edge& edge : edges_[cur.second])
+        {
+            unsigned& targetCosts = landmarkCosts_[edge.target * maxLandmarks + landmark];
+            const unsigned costs = cur.first + edge.cost;
+            if(costs < targetCosts)
+            {
+                targetCosts = costs;
+                todo.emplace(costs, edge.target);
+            }
+        }
+    }
+}
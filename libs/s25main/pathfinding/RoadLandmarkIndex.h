@@ -0,0 +1,73 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <limits>
+#include <vector>
+
+class GameWorldBase;
+class noRoadNode;
+
+/// Lower bounds for the costs of paths in the road network using landmarks (ALT):
+/// For some landmark nodes L the costs to all nodes are stored. By the triangle inequality |d(L,a) - d(L,b)| <= d(a,b).
+/// Additionally the connected component of each node is stored to detect unreachable goals immediately.
+/// The graph contains all roads (incl. boat roads) and ship connections without additional costs,
+/// so the bounds hold for all paths the RoadPathFinder can find.
+/// Removing roads can only increase the path costs, hence removed roads are kept in the graph.
+/// Added roads are inserted and only the costs they decrease get updated.
+/// Once the graph grew a lot the landmarks are chosen anew by rebuilding the index on the next query.
+class RoadLandmarkIndex
+{
+public:
+    static constexpr unsigned maxLandmarks = 8;
+    /// Components with less nodes don't get a landmark as the paths in them are short anyway
+    static constexpr unsigned minComponentSizeForLandmark = 16;
+    static constexpr unsigned unreachable = std::numeric_limits<unsigned>::max();
+    /// Rebuild when the number of nodes added since the last rebuild exceeds this fraction of the nodes at that time
+    static constexpr unsigned maxAddedNodesPercent = 50;
+
+    explicit RoadLandmarkIndex(const GameWorldBase& world);
+
+    /// Mark the index as outdated. It will be rebuilt on the next query
+    void Invalidate() { isValid_ = false; }
+    bool IsValid() const { return isValid_; }
+    /// Add a road between the 2 nodes with the given costs and update the costs it decreases
+    void AddRoad(const noRoadNode& node1, const noRoadNode& node2, unsigned costs);
+
+    /// Return a lower bound for the costs of any path between the 2 nodes or unreachable if there is none
+    unsigned GetLowerBound(const noRoadNode& start, const noRoadNode& goal);
+    unsigned GetNumLandmarks() const { return numLandmarks_; }
+
+private:
+    struct Edge
+    {
+        unsigned target;
+        unsigned cost;
+    };
+
+    void Rebuild();
+    void AddEdge(unsigned from, const noRoadNode& to, unsigned cost);
+    /// Return the index of the node in nodes_ + 1 or 0 if it is not in the index
+    unsigned GetIndex(const noRoadNode& node) const;
+    /// Return the index of the node in nodes_, adding it as a new component if it is not in the index
+    unsigned GetOrAddNode(const noRoadNode& node);
+    /// Set the costs from the landmark to the node and update all nodes for which this leads to lower costs.
+    /// Used to calculate the costs to all nodes initially (costs=0 for the landmark node)
+    void DecreaseLandmarkCosts(unsigned landmark, unsigned nodeIdx, unsigned costs);
+
+    const GameWorldBase& world_;
+    bool isValid_;
+    /// Index + 1 into nodes_ per map point, 0 for points without a road node
+    std::vector<unsigned> mapIdxToNode_;
+    std::vector<const noRoadNode*> nodes_;
+    std::vector<std::vector<Edge>> edges_;
+    std::vector<unsigned> componentIds_;
+    unsigned numComponents_;
+    unsigned numLandmarks_;
+    /// Number of nodes after the last rebuild and added since then
+    unsigned numRebuiltNodes_, numAddedNodes_;
+    /// Costs from each landmark to each node: landmarkCosts_[nodeIdx * maxLandmarks + landmark]
+    std::vector<unsigned> landmarkCosts_;
+};
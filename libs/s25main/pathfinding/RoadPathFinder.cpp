@@ -12,6 +12,8 @@
 #include "nodeObjs/noRoadNode.h"
 #include "gameData/GameConsts.h"
 #include "s25util/Log.h"
+#include <algorithm>
+#include <utility>
 
 /// Comparison operator for road nodes that returns true if lhs > rhs (descending order)
 struct RoadNodeComperatorGreater
@@ -32,6 +34,8 @@ struct RoadNodeComperatorGreater
 using QueueImpl = OpenListPrioQueue<const noRoadNode*, RoadNodeComperatorGreater>;
 using VecImpl = OpenListVector<const noRoadNode*>;
 VecImpl todo;
+// The searches to many goals visit a lot more nodes, so use the heap there
+QueueImpl distancesTodo;
 
 // Namespace with all functors usable as additional cost functors
 namespace AdditonalCosts {
@@ -100,6 +104,24 @@ struct And : private T_Func1, private T_Func2
 };
 } // namespace SegmentConstraints
 
+void RoadPathFinder::IncreaseCurrentVisit()
+{
+    // increase current_visit_on_roads, so we don't have to clear the visited-states at every run
+    currentVisit++;
+
+    // if the counter reaches its maximum, tidy up
+    if(currentVisit == std::numeric_limits<unsigned>::max())
+    {
+        RTTR_FOREACH_PT(MapPoint, gwb_.GetSize())
+        {
+            auto* const node = gwb_.GetSpecObj<noRoadNode>(pt);
+            if(node)
+                node->last_visit = 0;
+        }
+        currentVisit = 1;
+    }
+}
+
 /// Wegfinden ( A* ), O(v lg v) --> Wegfindung auf Stra�en
 template<class T_AdditionalCosts, class T_SegmentConstraints>
 bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goal, const unsigned max,
@@ -124,20 +146,7 @@ bool RoadPathFinder::FindPathImpl(const noRoadNode& start, const noRoadNode& goa
         return true;
     }
 
-    // increase current_visit_on_roads, so we don't have to clear the visited-states at every run
-    currentVisit++;
-
-    // if the counter reaches its maximum, tidy up
-    if(currentVisit == std::numeric_limits<unsigned>::max())
-    {
-        RTTR_FOREACH_PT(MapPoint, gwb_.GetSize())
-        {
-            auto* const node = gwb_.GetSpecObj<noRoadNode>(pt);
-            if(node)
-                node->last_visit = 0;
-        }
-        currentVisit = 1;
-    }
+    IncreaseCurrentVisit();
 
     // Add start node
     todo.clear();
@@ -291,8 +300,12 @@ bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, c
                               const RoadSegment* const forbidden, unsigned* const length,
                               RoadPathDirection* const firstDir, MapPoint* const firstNodePos)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
     RTTR_Assert(length || firstDir || firstNodePos); // If none of them is set use the \ref PathExist function!
 
+    if(IsPathTooLong(start, goal, max))
+        return false;
+
     if(wareMode)
     {
         if(forbidden)
@@ -317,6 +330,9 @@ bool RoadPathFinder::FindPath(const noRoadNode& start, const noRoadNode& goal, c
 bool RoadPathFinder::PathExists(const noRoadNode& start, const noRoadNode& goal, const bool allowWaterRoads,
                                 const unsigned max, const RoadSegment* const forbidden)
 {
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if(IsPathTooLong(start, goal, max))
+        return false;
     if(allowWaterRoads)
     {
         if(forbidden)
@@ -334,3 +350,228 @@ bool RoadPathFinder::PathExists(const noRoadNode& start, const noRoadNode& goal,
                                 SegmentConstraints::AvoidRoadType<RoadType::Water>());
     }
 }
+
+unsigned RoadPathFinder::GetCostsLowerBound(const noRoadNode& start, const noRoadNode& goal)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if(&start == &goal)
+        return 0;
+    return landmarks_.GetLowerBound(start, goal);
+}
+
+bool RoadPathFinder::IsPathTooLong(const noRoadNode& start, const noRoadNode& goal, const unsigned max)
+{
+    // Start==goal is handled (and reported) by FindPathImpl
+    if(&start == &goal)
+        return false;
+    // Each path costs at least the bound, so FindPathImpl would not find one
+    const unsigned lowerBound = GetCostsLowerBound(start, goal);
+    return lowerBound == RoadLandmarkIndex::unreachable || lowerBound > max;
+}
+
+/// Dijkstra from start to all goals, O(v lg v)
+/// Uses the same costs and constraints as FindPathImpl, which (using a consistent heuristic) finds the optimal costs
+template<class T_AdditionalCosts, class T_SegmentConstraints>
+std::vector<unsigned> RoadPathFinder::FindDistancesImpl(const noRoadNode& start,
+                                                        const std::vector<const noRoadNode*>& goals,
+                                                        const bool reverse, unsigned max,
+                                                        const T_AdditionalCosts addCosts,
+                                                        const T_SegmentConstraints isSegmentAllowed,
+                                                        const GoalReachedCallback& onGoalReached)
+{
+    std::vector<unsigned> distances(goals.size(), std::numeric_limits<unsigned>::max());
+
+    // Goals sorted by node for fast lookup (a node may occur multiple times). Skip goals that can't be reached
+    using GoalEntry = std::pair<const noRoadNode*, unsigned>;
+    std::vector<GoalEntry> sortedGoals;
+    sortedGoals.reserve(goals.size());
+    for(unsigned i = 0; i < goals.size(); i++)
+    {
+        if(!IsPathTooLong(reverse ? *goals[i] : start, reverse ? start : *goals[i], max))
+            sortedGoals.emplace_back(goals[i], i);
+    }
+    if(sortedGoals.empty())
+        return distances;
+    std::sort(sortedGoals.begin(), sortedGoals.end());
+    const auto findGoal = [&sortedGoals](const noRoadNode* node) {
+        return std::lower_bound(sortedGoals.begin(), sortedGoals.end(), GoalEntry(node, 0u));
+    };
+    const auto isGoal = [&](const noRoadNode* node) {
+        const auto it = findGoal(node);
+        return it != sortedGoals.end() && it->first == node;
+    };
+    unsigned numGoalsLeft = sortedGoals.size();
+
+    IncreaseCurrentVisit();
+    distancesTodo.clear();
+
+    start.estimate = start.cost = 0;
+    start.last_visit = currentVisit;
+    start.prev = nullptr;
+    distancesTodo.push(&start);
+
+    // Add the node or update its costs if they are lower. Uses the estimate for ordering so it has to equal the costs
+    const auto visit = [this](const noRoadNode& node, const noRoadNode& prev, const unsigned cost) {
+        if(node.last_visit == currentVisit)
+        {
+            if(cost < node.cost)
+            {
+                node.estimate = node.cost = cost;
+                node.prev = &prev;
+                distancesTodo.rearrange(&node);
+            }
+        } else
+        {
+            node.estimate = node.cost = cost;
+            node.last_visit = currentVisit;
+            node.prev = &prev;
+            distancesTodo.push(&node);
+        }
+    };
+
+    while(!distancesTodo.empty())
+    {
+        const noRoadNode& best = *distancesTodo.pop();
+        if(best.cost > max)
+            break;
+
+        for(auto it = findGoal(&best); it != sortedGoals.end() && it->first == &best; ++it)
+        {
+            distances[it->second] = best.cost;
+            --numGoalsLeft;
+            if(onGoalReached)
+                max = std::min(max, onGoalReached(it->second, best.cost));
+        }
+        if(numGoalsLeft == 0)
+            break;
+
+        const noRoadNode* prevNode = best.prev;
+        const bool isHarbor = best.GetGOT() == GO_Type::NobHarborbuilding;
+
+        if(reverse)
+        {
+            // No paths over buildings: Besides the start only flags and harbors can be part of a path
+            if(&best != &start && best.GetGOT() != GO_Type::Flag && !isHarbor)
+                continue;
+            for(const auto dir : helpers::EnumRange<Direction>{})
+            {
+                const auto* route = best.GetRoute(dir);
+                if(!route || !isSegmentAllowed(*route))
+                    continue;
+                const noRoadNode* neighbour = route->GetF1();
+                if(neighbour == &best)
+                    neighbour = route->GetF2();
+                if(neighbour == prevNode)
+                    continue;
+                // Costs are added at the node the segment is entered from
+                unsigned cost = best.cost + route->GetLength();
+                for(const auto neighbourDir : helpers::EnumRange<Direction>{})
+                {
+                    if(neighbour->GetRoute(neighbourDir) == route)
+                    {
+                        cost += addCosts(*neighbour, neighbourDir);
+                        break;
+                    }
+                }
+                if(cost <= max)
+                    visit(*neighbour, best, cost);
+            }
+            if(!isHarbor)
+                continue;
+            // Connections are bidirectional, but the costs need to be the ones from the other harbor to this one
+            for(const auto& sc : static_cast<const nobHarborBuilding&>(best).GetShipConnections())
+            {
+                for(const auto& scBack : static_cast<const nobHarborBuilding*>(sc.dest)->GetShipConnections())
+                {
+                    if(scBack.dest != &best)
+                        continue;
+                    const unsigned cost = best.cost + scBack.way_costs;
+                    if(cost <= max)
+                        visit(*sc.dest, best, cost);
+                    break;
+                }
+            }
+        } else
+        {
+            for(const auto dir : helpers::EnumRange<Direction>{})
+            {
+                const auto* route = best.GetRoute(dir);
+                if(!route)
+                    continue;
+                const noRoadNode* neighbour = route->GetF1();
+                if(neighbour == &best)
+                    neighbour = route->GetF2();
+                if(neighbour == prevNode)
+                    continue;
+                // No paths over buildings
+                if(dir == Direction::NorthWest && !isGoal(neighbour))
+                {
+                    // Flags and harbors are allowed
+                    const GO_Type got = neighbour->GetGOT();
+                    if(got != GO_Type::Flag && got != GO_Type::NobHarborbuilding)
+                        continue;
+                }
+                if(!isSegmentAllowed(*route))
+                    continue;
+                const unsigned cost = best.cost + route->GetLength() + addCosts(best, dir);
+                if(cost <= max)
+                    visit(*neighbour, best, cost);
+            }
+            if(!isHarbor)
+                continue;
+            for(const auto& sc : static_cast<const nobHarborBuilding&>(best).GetShipConnections())
+            {
+                const unsigned cost = best.cost + sc.way_costs;
+                if(cost <= max)
+                    visit(*sc.dest, best, cost);
+            }
+        }
+    }
+    return distances;
+}
+
+std::vector<unsigned> RoadPathFinder::FindDistances(const noRoadNode& start,
+                                                    const std::vector<const noRoadNode*>& goals, const bool wareMode,
+                                                    const bool reverse, const unsigned max,
+                                                    const RoadSegment* const forbidden,
+                                                    const GoalReachedCallback& onGoalReached)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    if(wareMode)
+    {
+        if(forbidden)
+            return FindDistancesImpl(start, goals, reverse, max, AdditonalCosts::Carrier(),
+                                     SegmentConstraints::AvoidSegment(forbidden), onGoalReached);
+        else
+            return FindDistancesImpl(start, goals, reverse, max, AdditonalCosts::Carrier(),
+                                     SegmentConstraints::None(), onGoalReached);
+    } else
+    {
+        if(forbidden)
+            return FindDistancesImpl(start, goals, reverse, max, AdditonalCosts::None(),
+                                     SegmentConstraints::And<SegmentConstraints::AvoidSegment,
+                                                             SegmentConstraints::AvoidRoadType<RoadType::Water>>(
+                                       forbidden),
+                                     onGoalReached);
+        else
+            return FindDistancesImpl(start, goals, reverse, max, AdditonalCosts::None(),
+                                     SegmentConstraints::AvoidRoadType<RoadType::Water>(), onGoalReached);
+    }
+}
+
+int RoadPathFinder::FindBestGoal(const noRoadNode& start, const std::vector<const noRoadNode*>& goals,
+                                 const bool wareMode, const bool reverse, const unsigned max,
+                                 const RoadSegment* const forbidden, unsigned* const length)
+{
+    std::lock_guard<std::recursive_mutex> lock(mutex_);
+    // Goals are reached in order of their costs, so the first one is the best. But continue for goals with the same
+    // costs as the first one in the list has to be taken
+    const std::vector<unsigned> distances =
+      FindDistances(start, goals, wareMode, reverse, max, forbidden, [](unsigned, unsigned costs) { return costs; });
+    const auto itBest = std::min_element(distances.begin(), distances.end());
+    if(itBest == distances.end() || *itBest == std::numeric_limits<unsigned>::max())
+        return -1;
+    if(length)
+        *length = *itBest;
+    return static_cast<int>(itBest - distances.begin());
+}
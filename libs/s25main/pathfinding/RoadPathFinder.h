@@ -4,9 +4,13 @@
 
 #pragma once
 
+#include "pathfinding/RoadLandmarkIndex.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/RoadPathDirection.h"
+#include <functional>
 #include <limits>
+#include <mutex>
+#include <vector>
 
 class GameWorldBase;
 class noRoadNode;
@@ -16,9 +20,29 @@ class RoadPathFinder
 {
     GameWorldBase& gwb_;
     unsigned currentVisit;
+    /// Used to skip searches that can't find a path within the allowed costs
+    RoadLandmarkIndex landmarks_;
+    /// Searches store their state in the road nodes, so concurrent searches (e.g. by AIs) must be serialized
+    std::recursive_mutex mutex_;
 
 public:
-    RoadPathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0) {}
+    RoadPathFinder(GameWorldBase& gwb) : gwb_(gwb), currentVisit(0), landmarks_(gwb) {}
+
+    /// Must be called when a road was added. Removals don't need to be signaled
+    void OnRoadAdded(const noRoadNode& node1, const noRoadNode& node2, unsigned length)
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        landmarks_.AddRoad(node1, node2, length);
+    }
+    /// Must be called when ship connections were added or many roads changed at once (e.g. loading a game)
+    void OnRoadNetworkChanged()
+    {
+        std::lock_guard<std::recursive_mutex> lock(mutex_);
+        landmarks_.Invalidate();
+    }
+    const RoadLandmarkIndex& GetLandmarkIndex() const { return landmarks_; }
+    /// Lower bound for the costs of any path from start to goal or RoadLandmarkIndex::unreachable if there is none
+    unsigned GetCostsLowerBound(const noRoadNode& start, const noRoadNode& goal);
 
     /// Calculates the best path from start to goal
     /// Outputs are only valid if true is returned!
@@ -43,9 +67,47 @@ public:
     bool PathExists(const noRoadNode& start, const noRoadNode& goal, bool allowWaterRoads,
                     unsigned max = std::numeric_limits<unsigned>::max(), const RoadSegment* forbidden = nullptr);
 
+    /// Called by FindDistances when the costs for a goal are known, in order of increasing costs.
+    /// Returns the maximum costs allowed for the remaining search
+    using GoalReachedCallback = std::function<unsigned(unsigned goalIdx, unsigned costs)>;
+
+    /// Calculates the costs from start to all goals (or from all goals to start if reverse is set) in a single search.
+    /// The costs are the same FindPath would return, so results are identical to calling it for each goal.
+    /// Returns the costs per goal, goals without a path within the allowed costs get
+    /// std::numeric_limits<unsigned>::max()
+    ///
+    /// @param wareMode Same as in \ref FindPath
+    /// @param max Maximum costs allowed
+    /// @param forbidden RoadSegment that will be ignored
+    /// @param onGoalReached If set, may lower the maximum costs whenever a goal is reached to stop the search early
+    std::vector<unsigned> FindDistances(const noRoadNode& start, const std::vector<const noRoadNode*>& goals,
+                                        bool wareMode, bool reverse,
+                                        unsigned max = std::numeric_limits<unsigned>::max(),
+                                        const RoadSegment* forbidden = nullptr,
+                                        const GoalReachedCallback& onGoalReached = nullptr);
+
+    /// Find the goal with the lowest path costs from start (or to start if reverse is set)
+    /// Same result as calling FindPath for all goals in order and taking the first one with the lowest costs.
+    /// Returns the index of the goal or -1 if none was found
+    ///
+    /// @param max Maximum costs allowed
+    /// @param length If != nullptr will receive the costs to the best goal
+    int FindBestGoal(const noRoadNode& start, const std::vector<const noRoadNode*>& goals, bool wareMode,
+                     bool reverse, unsigned max = std::numeric_limits<unsigned>::max(),
+                     const RoadSegment* forbidden = nullptr, unsigned* length = nullptr);
+
 private:
+    /// Returns true if the path from start to goal certainly costs more than max
+    bool IsPathTooLong(const noRoadNode& start, const noRoadNode& goal, unsigned max);
+    /// Start a new search, so all nodes are unvisited
+    void IncreaseCurrentVisit();
     template<class T_AdditionalCosts, class T_SegmentConstraints>
     bool FindPathImpl(const noRoadNode& start, const noRoadNode& goal, unsigned max, T_AdditionalCosts addCosts,
                       T_SegmentConstraints isSegmentAllowed, unsigned* length = nullptr,
                       RoadPathDirection* firstDir = nullptr, MapPoint* firstNodePos = nullptr);
+    template<class T_AdditionalCosts, class T_SegmentConstraints>
+    std::vector<unsigned> FindDistancesImpl(const noRoadNode& start, const std::vector<const noRoadNode*>& goals,
+                                            bool reverse, unsigned max, T_AdditionalCosts addCosts,
+                                            T_SegmentConstraints isSegmentAllowed,
+                                            const GoalReachedCallback& onGoalReached);
 };
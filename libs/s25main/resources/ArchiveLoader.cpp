@@ -66,10 +66,10 @@ std::map<uint16_t, uint16_t> extractBobMapping(libsiedler2::Archiv& archive, con
 } // namespace
 
 /// Load a single file into the archive
-libsiedler2::Archiv ArchiveLoader::loadFile(const fs::path& filePath,
-                                            const libsiedler2::ArchivItem_Palette* palette) const
+libsiedler2::Archiv ArchiveLoader::loadFile(const fs::path& filePath, const libsiedler2::ArchivItem_Palette* palette,
+                                            std::string& logMsg) const
 {
-    logger_.write(_("Loading %1%: ")) % filePath;
+    logMsg += helpers::format(_("Loading %1%: "), filePath);
 
     libsiedler2::Archiv archive;
     if(int ec = libsiedler2::Load(filePath, archive, palette))
@@ -79,11 +79,12 @@ libsiedler2::Archiv ArchiveLoader::loadFile(const fs::path& filePath,
 }
 
 libsiedler2::Archiv ArchiveLoader::loadDirectory(const fs::path& filePath,
-                                                 const libsiedler2::ArchivItem_Palette* palette) const
+                                                 const libsiedler2::ArchivItem_Palette* palette,
+                                                 std::string& logMsg) const
 {
-    logger_.write(_("Loading directory %s\n")) % filePath;
+    logMsg += helpers::format(_("Loading directory %s\n"), filePath);
     std::vector<libsiedler2::FileEntry> files = libsiedler2::ReadFolderInfo(filePath);
-    logger_.write(_("  Loading %1% entries: ")) % files.size();
+    logMsg += helpers::format(_("  Loading %1% entries: "), files.size());
 
     libsiedler2::Archiv archive;
 
@@ -102,28 +103,37 @@ libsiedler2::Archiv ArchiveLoader::loadFileOrDir(const fs::path& filePath,
     if(!is_regular_file(fileStatus) && !is_directory(fileStatus))
         throw LoadError(_("Could not determine type of path %s\n"), filePath);
 
+    std::string logMsg;
     try
     {
         const Timer timer(true);
 
         libsiedler2::Archiv result;
         if(is_directory(fileStatus))
-            result = loadDirectory(filePath, palette);
+            result = loadDirectory(filePath, palette, logMsg);
         else
-            result = loadFile(filePath, palette);
+            result = loadFile(filePath, palette, logMsg);
 
         using namespace std::chrono;
         // TODO: Change translations and use chronoIO
-        logger_.write(_("done in %ums\n")) % duration_cast<milliseconds>(timer.getElapsed()).count();
+        logMsg += helpers::format(_("done in %ums\n"), duration_cast<milliseconds>(timer.getElapsed()).count());
+        writeLog(logMsg);
 
         return result;
     } catch(const LoadError& e)
     {
-        logger_.write(_("failed: %1%\n")) % e.what();
+        logMsg += helpers::format(_("failed: %1%\n"), e.what());
+        writeLog(logMsg);
         throw LoadError();
     }
 }
 
+void ArchiveLoader::writeLog(const std::string& msg) const
+{
+    std::lock_guard<std::mutex> lock(logMutex_);
+    logger_.write("%1%") % msg;
+}
+
 void ArchiveLoader::mergeArchives(libsiedler2::Archiv& targetArchiv, libsiedler2::Archiv& otherArchiv)
 {
     if(targetArchiv.size() < otherArchiv.size())
@@ -177,7 +187,7 @@ libsiedler2::Archiv ArchiveLoader::load(const ResolvedFile& file, const libsiedl
         } catch(const LoadError& e)
         {
             if(e.what() != std::string())
-                logger_.write("Exception caught: %1%\n") % e.what();
+                writeLog(helpers::format("Exception caught: %1%\n", e.what()));
             throw LoadError();
         }
     }
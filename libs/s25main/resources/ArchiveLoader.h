@@ -5,7 +5,9 @@
 #pragma once
 
 #include <boost/filesystem/path.hpp>
+#include <mutex>
 #include <stdexcept>
+#include <string>
 
 class Log;
 class ResolvedFile;
@@ -24,6 +26,7 @@ public:
     explicit LoadError(T&&... args);
 };
 
+/// Loads archives and their overrides. Different files can be loaded concurrently
 class ArchiveLoader
 {
 public:
@@ -37,12 +40,15 @@ public:
     static void mergeArchives(libsiedler2::Archiv& targetArchiv, libsiedler2::Archiv& otherArchiv);
 
 private:
-    /// Load a single file, logs a message without trailing newline on start and throws a LoadError on error.
+    /// Load a single file, adds a message without trailing newline to logMsg and throws a LoadError on error.
     libsiedler2::Archiv loadFile(const boost::filesystem::path& filePath,
-                                 const libsiedler2::ArchivItem_Palette* palette) const;
-    /// Load a single file, logs a message without trailing newline on start and throws a LoadError on error.
+                                 const libsiedler2::ArchivItem_Palette* palette, std::string& logMsg) const;
+    /// Load a directory, adds a message without trailing newline to logMsg and throws a LoadError on error.
     libsiedler2::Archiv loadDirectory(const boost::filesystem::path& filePath,
-                                      const libsiedler2::ArchivItem_Palette* palette) const;
+                                      const libsiedler2::ArchivItem_Palette* palette, std::string& logMsg) const;
+    /// Write the message as a whole, so messages of files loaded concurrently don't get mixed
+    void writeLog(const std::string& msg) const;
 
     Log& logger_;
+    mutable std::mutex logMutex_;
 };
@@ -0,0 +1,121 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "BQCalculator.h"
+#include "RttrForeachPt.h"
+#include <cstdint>
+
+namespace {
+/// Each terrain BQ is counted in its own 4 bit field, so the sum for the 6 triangles around a point contains all counts
+using TerrainBQCounts = uint16_t;
+constexpr unsigned castleShift = 0;
+constexpr unsigned mineShift = 4;
+constexpr unsigned flagShift = 8;
+constexpr unsigned dangerShift = 12;
+constexpr TerrainBQCounts countMask = 0xF;
+
+BuildingQuality getBQFromCounts(const TerrainBQCounts counts)
+{
+    const unsigned numCastle = (counts >> castleShift) & countMask;
+    const unsigned numMine = (counts >> mineShift) & countMask;
+    const unsigned numFlag = (counts >> flagShift) & countMask;
+    if((counts >> dangerShift) & countMask)
+        return BuildingQuality::Nothing;
+    if(numMine == 6)
+        return BuildingQuality::Mine;
+    if(numCastle == 6)
+        return BuildingQuality::Castle;
+    if(numFlag || numMine || numCastle)
+        return BuildingQuality::Flag;
+    return BuildingQuality::Nothing;
+}
+
+TerrainBQCounts toCount(const TerrainBQ bq)
+{
+    switch(bq)
+    {
+        case TerrainBQ::Nothing: break;
+        case TerrainBQ::Danger: return 1 << dangerShift;
+        case TerrainBQ::Flag: return 1 << flagShift;
+        case TerrainBQ::Castle: return 1 << castleShift;
+        case TerrainBQ::Mine: return 1 << mineShift;
+    }
+    return 0;
+}
+} // namespace
+
+BuildingQuality BQCalculator::GetTerrainBQ(const MapPoint pt) const
+{
+    if(terrainBQs)
+        return (*terrainBQs)[world.GetIdx(pt)];
+    const WorldDescription& desc = world.GetDescription();
+    TerrainBQCounts counts = 0;
+    for(const DescIdx<TerrainDesc> tIdx : world.GetTerrainsAround(pt))
+    {
+        const TerrainBQ bq = desc.get(tIdx).GetBQ();
+        if(bq == TerrainBQ::Danger)
+            return BuildingQuality::Nothing;
+        counts += toCount(bq);
+    }
+    return getBQFromCounts(counts);
+}
+
+std::vector<BuildingQuality> BQCalculator::CalcTerrainBQs(const World& world)
+{
+    const MapExtent size = world.GetSize();
+    const unsigned numNodes = size.x * size.y;
+    const WorldDescription& desc = world.GetDescription();
+
+    // Counts of the 2 triangles (t1, t2) below/right of each point
+    std::vector<TerrainBQCounts> t1Counts(numNodes), t2Counts(numNodes);
+    RTTR_FOREACH_PT(MapPoint, size)
+    {
+        const MapNode& node = world.GetNode(pt);
+        const unsigned idx = world.GetIdx(pt);
+        t1Counts[idx] = toCount(desc.get(node.t1).GetBQ());
+        t2Counts[idx] = toCount(desc.get(node.t2).GetBQ());
+    }
+
+    // Sum up the 6 triangles around each point, same as World::GetTerrainsAround: NW.t1, NW.t2, NE.t1, t2, t1, W.t2
+    // All neighbours of a row are in the same rows and only the offset of NW/NE depends on the row being even,
+    // so handle the wrapped first/last column separately and let the compiler vectorize the rest
+    std::vector<BuildingQuality> result(numNodes);
+    std::vector<TerrainBQCounts> rowCounts(size.x);
+    for(unsigned y = 0; y < size.y; y++)
+    {
+        const unsigned rowIdx = y * size.x;
+        const unsigned prevRowIdx = (y == 0 ? size.y - 1 : y - 1) * size.x;
+        // NW is at x - 1 for even rows and at x for odd rows, NE is at x for even rows and at x + 1 for odd rows
+        const bool isEvenRow = (y & 1) == 0;
+        const TerrainBQCounts* curT1 = &t1Counts[rowIdx];
+        const TerrainBQCounts* curT2 = &t2Counts[rowIdx];
+        const TerrainBQCounts* prevT1 = &t1Counts[prevRowIdx];
+        const TerrainBQCounts* prevT2 = &t2Counts[prevRowIdx];
+        const auto calcCounts = [&](unsigned x) {
+            const unsigned xMinus1 = (x == 0 ? size.x : x) - 1;
+            const unsigned xPlus1 = x + 1 == size.x ? 0 : x + 1;
+            const unsigned nwX = isEvenRow ? xMinus1 : x;
+            const unsigned neX = isEvenRow ? x : xPlus1;
+            return static_cast<TerrainBQCounts>(prevT1[nwX] + prevT2[nwX] + prevT1[neX] + curT2[x] + curT1[x]
+                                                + curT2[xMinus1]);
+        };
+        rowCounts[0] = calcCounts(0);
+        if(isEvenRow)
+        {
+            for(unsigned x = 1; x < size.x; x++)
+                rowCounts[x] = static_cast<TerrainBQCounts>(prevT1[x - 1] + prevT2[x - 1] + prevT1[x] + curT2[x]
+                                                            + curT1[x] + curT2[x - 1]);
+        } else
+        {
+            for(unsigned x = 1; x + 1 < size.x; x++)
+                rowCounts[x] = static_cast<TerrainBQCounts>(prevT1[x] + prevT2[x] + prevT1[x + 1] + curT2[x]
+                                                            + curT1[x] + curT2[x - 1]);
+            if(size.x > 1)
+                rowCounts[size.x - 1] = calcCounts(size.x - 1);
+        }
+        for(unsigned x = 0; x < size.x; x++)
+            result[rowIdx + x] = getBQFromCounts(rowCounts[x]);
+    }
+    return result;
+}
@@ -5,18 +5,33 @@
 #pragma once
 
 #include "World.h"
+#include "commonDefines.h"
 #include "helpers/containerUtils.h"
+#include "nodeObjs/noBase.h"
 #include "gameData/TerrainDesc.h"
+#include <vector>
 
 struct BQCalculator
 {
-    BQCalculator(const World& world) : world(world) {}
+    BQCalculator(const World& world) : world(world), terrainBQs(nullptr) {}
+    /// Use the precomputed BQs from CalcTerrainBQs. They must stay valid and up to date while this is used
+    BQCalculator(const World& world, const std::vector<BuildingQuality>& terrainBQs)
+        : world(world), terrainBQs(&terrainBQs)
+    {}
 
     template<typename T_IsOnRoad>
     BuildingQuality operator()(MapPoint pt, T_IsOnRoad isOnRoad, bool flagOnly = false) const;
 
+    /// Calculate the maximum BQ allowed by the surrounding terrain (Nothing, Flag, Mine or Castle) for each point
+    /// of the map (indexed by World::GetIdx) in a single pass, looking up the BQ of each terrain triangle only once
+    static std::vector<BuildingQuality> CalcTerrainBQs(const World& world);
+
 private:
+    /// Maximum BQ allowed by the terrain around the point
+    BuildingQuality GetTerrainBQ(MapPoint pt) const;
+
     const World& world;
+    const std::vector<BuildingQuality>* terrainBQs;
 };
 
 template<typename T_IsOnRoad>
@@ -29,51 +44,12 @@ BuildingQuality BQCalculator::operator()(const MapPoint pt, T_IsOnRoad isOnRoad,
     //////////////////////////////////////////////////////////////////////////
     // 1. Check maximum allowed BQ on terrain
 
-    unsigned building_hits = 0;
-    unsigned mine_hits = 0;
-    unsigned flag_hits = 0;
-
-    const WorldDescription& desc = world.GetDescription();
-    BuildingQuality curBQ;
+    BuildingQuality curBQ = GetTerrainBQ(pt);
+    if(curBQ == BuildingQuality::Nothing)
+        return BuildingQuality::Nothing;
+    // A flag is possible if no terrain is dangerous and any allows something
     if(flagOnly)
-    {
-        bool flagPossible = false;
-        for(const DescIdx<TerrainDesc> tIdx : world.GetTerrainsAround(pt))
-        {
-            TerrainBQ bq = desc.get(tIdx).GetBQ();
-            if(bq == TerrainBQ::Danger)
-                return BuildingQuality::Nothing;
-            else if(bq != TerrainBQ::Nothing)
-                flagPossible = true;
-        }
-        if(flagPossible)
-            curBQ = BuildingQuality::Flag;
-        else
-            return BuildingQuality::Nothing;
-    } else
-    {
-        for(const DescIdx<TerrainDesc> tIdx : world.GetTerrainsAround(pt))
-        {
-            TerrainBQ bq = desc.get(tIdx).GetBQ();
-            if(bq == TerrainBQ::Castle)
-                ++building_hits;
-            else if(bq == TerrainBQ::Mine)
-                ++mine_hits;
-            else if(bq == TerrainBQ::Flag)
-                ++flag_hits;
-            else if(bq == TerrainBQ::Danger)
-                return BuildingQuality::Nothing;
-        }
-
-        if(mine_hits == 6)
-            curBQ = BuildingQuality::Mine;
-        else if(building_hits == 6)
-            curBQ = BuildingQuality::Castle;
-        else if(flag_hits || mine_hits || building_hits)
-            curBQ = BuildingQuality::Flag;
-        else
-            return BuildingQuality::Nothing;
-    }
+        curBQ = BuildingQuality::Flag;
     RTTR_Assert(curBQ == BuildingQuality::Flag || curBQ == BuildingQuality::Mine || curBQ == BuildingQuality::Castle);
     const auto neighbours = world.GetNeighbours(pt);
 
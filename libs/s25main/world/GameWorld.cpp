@@ -15,7 +15,6 @@
 #include "buildings/nobUsual.h"
 #include "figures/nofAttacker.h"
 #include "figures/nofPassiveSoldier.h"
-#include "figures/nofScout_Free.h"
 #include "helpers/containerUtils.h"
 #include "helpers/reverse.h"
 #include "lua/LuaInterfaceGame.h"
@@ -39,7 +38,6 @@
 #include <algorithm>
 #include <cmath>
 #include <functional>
-#include <set>
 #include <stdexcept>
 
 inline std::vector<GamePlayer> CreatePlayers(const std::vector<PlayerInfo>& playerInfos, GameWorld& world)
@@ -90,6 +88,8 @@ void GameWorld::DestroyFlag(const MapPoint pt, unsigned char playerId)
     // Let's see if there is a flag
     if(GetNO(pt)->GetType() == NodalObjectType::Flag)
     {
+        // The BQ around the flag, the roads and the building is recalculated only once
+        BQUpdateBatch bqBatch(*this);
         auto* flag = GetSpecObj<noFlag>(pt);
         if(flag->GetPlayer() != playerId)
             return;
@@ -177,6 +177,7 @@ void GameWorld::DestroyBuilding(const MapPoint pt, const unsigned char player)
                 return;
         }
 
+        BQUpdateBatch bqBatch(*this);
         DestroyNO(pt);
         // Bauplätze drumrum neu berechnen
         RecalcBQAroundPointBig(pt);
@@ -244,15 +245,19 @@ void GameWorld::BuildRoad(const unsigned char playerId, const bool boat_road, co
         DestroyNO(start);
 
     MapPoint end(start);
-    for(auto i : route)
     {
-        SetPointRoad(end, i, boat_road ? PointRoad::Boat : PointRoad::Normal);
-        RecalcBQForRoad(end);
-        end = GetNeighbour(end, i);
+        // Neighbouring road points share most of their affected points
+        BQUpdateBatch bqBatch(*this);
+        for(auto i : route)
+        {
+            SetPointRoad(end, i, boat_road ? PointRoad::Boat : PointRoad::Normal);
+            RecalcBQForRoad(end);
+            end = GetNeighbour(end, i);
 
-        // Evtl Zierobjekte abreißen
-        if(HasRemovableObjForRoad(end))
-            DestroyNO(end);
+            // Evtl Zierobjekte abreißen
+            if(HasRemovableObjForRoad(end))
+                DestroyNO(end);
+        }
     }
 
     auto* rs = new RoadSegment(boat_road ? RoadType::Water : RoadType::Normal, GetSpecObj<noFlag>(start),
@@ -377,7 +382,31 @@ void GameWorld::RecalcTerritory(const noBaseBuilding& building, TerritoryChangeR
     const unsigned militaryRadius = building.GetMilitaryRadius();
     RTTR_Assert(militaryRadius > 0u);
 
-    const TerritoryRegion region = CreateTerritoryRegion(building, militaryRadius + ADD_RADIUS, reason);
+    // Update the closest buildings. Harbor building sites from sea are updated when added to or removed from the list
+    if(building.GetGOT() != GO_Type::Buildingsite)
+    {
+        if(reason == TerritoryChangeReason::Destroyed)
+            RemoveMilitaryInfluence(building);
+        else if(reason == TerritoryChangeReason::Build)
+            militaryInfluence.Add(*this, building);
+        else
+        {
+            // A captured building holds the same nodes for its new owner unless they are restricted differently
+            bool hasRestrictedArea = false;
+            for(unsigned i = 0; i < GetNumPlayers(); ++i)
+                hasRestrictedArea |= !GetPlayer(i).GetRestrictedArea().empty();
+            if(hasRestrictedArea)
+            {
+                RemoveMilitaryInfluence(building);
+                militaryInfluence.Add(*this, building);
+            }
+        }
+    }
+
+    TerritoryRegion region = CreateEmptyTerritoryRegion(building.GetPos(), militaryRadius + ADD_RADIUS);
+    RTTR_FOREACH_PT(Position, region.size)
+        region.SetOwner(pt, militaryInfluence.GetOwner(GetIdx(MakeMapPoint(pt + region.startPt))));
+    CleanTerritoryRegion(region, reason, building);
 
     std::vector<MapPoint> ptsWithChangedOwners;
     std::vector<int> sizeChanges(GetNumPlayers());
@@ -401,7 +430,8 @@ void GameWorld::RecalcTerritory(const noBaseBuilding& building, TerritoryChangeR
             sizeChanges[oldOwner - 1]--;
     }
 
-    std::set<MapPoint, MapPointLess> ptsHandled;
+    std::vector<MapPoint> ptsHandled;
+    isTerritoryPtHandled.resize(prodOfComponents(GetSize()));
     // Destroy everything from old player on all nodes where the owner has changed
     for(const MapPoint& curMapPt : ptsWithChangedOwners)
     {
@@ -411,8 +441,12 @@ void GameWorld::RecalcTerritory(const noBaseBuilding& building, TerritoryChangeR
         const uint8_t owner = GetNode(curMapPt).owner;
         for(const MapPoint neighbourPt : GetNeighbours(curMapPt))
         {
-            if(ptsHandled.insert(neighbourPt).second)
-                DestroyPlayerRests(neighbourPt, owner, &building);
+            const unsigned idx = GetIdx(neighbourPt);
+            if(isTerritoryPtHandled[idx])
+                continue;
+            isTerritoryPtHandled[idx] = true;
+            ptsHandled.push_back(neighbourPt);
+            DestroyPlayerRests(neighbourPt, owner, &building);
         }
 
         if(gi)
@@ -437,25 +471,38 @@ void GameWorld::RecalcTerritory(const noBaseBuilding& building, TerritoryChangeR
     for(const MapPoint& curMapPt : ptsWithChangedOwners)
         GetNotifications().publish(NodeNote(NodeNote::Owner, curMapPt));
 
-    for(const MapPoint& pt : ptsHandled)
     {
-        // BQ neu berechnen
-        RecalcBQ(pt);
-        // ggf den noch darüber, falls es eine Flagge war (kann ja ein Gebäude entstehen)
-        const MapPoint neighbourPt = GetNeighbour(pt, Direction::NorthWest);
-        if(GetNode(neighbourPt).bq != BuildingQuality::Nothing)
-            RecalcBQ(neighbourPt);
+        BQUpdateBatch bqBatch(*this);
+        for(const MapPoint& pt : ptsHandled)
+        {
+            isTerritoryPtHandled[GetIdx(pt)] = false;
+            // BQ neu berechnen
+            RecalcBQ(pt);
+            // ggf den noch darüber, falls es eine Flagge war (kann ja ein Gebäude entstehen)
+            const MapPoint neighbourPt = GetNeighbour(pt, Direction::NorthWest);
+            if(GetUpToDateBQ(neighbourPt) != BuildingQuality::Nothing)
+                RecalcBQ(neighbourPt);
+        }
     }
 
     RecalcBorderStones(region.startPt, region.size);
 
     // Recalc visibilities if building was destroyed
     // Otherwise just set everything to visible
+    // Harbor building sites from sea are registered as viewers when they are added to or removed from the list
     const unsigned visualRadius = militaryRadius + VISUALRANGE_MILITARY;
+    const bool isViewer = building.GetGOT() != GO_Type::Buildingsite;
     if(reason == TerritoryChangeReason::Destroyed)
-        RecalcVisibilitiesAroundPoint(building.GetPos(), visualRadius, building.GetPlayer(), &building);
-    else
+    {
+        if(isViewer)
+            RemoveViewer(building.GetPos(), visualRadius, building.GetPlayer());
+        RecalcVisibilitiesAroundPoint(building.GetPos(), visualRadius, building.GetPlayer());
+    } else
+    {
+        if(isViewer)
+            AddViewer(building.GetPos(), visualRadius, building.GetPlayer());
         MakeVisibleAroundPoint(building.GetPos(), visualRadius, building.GetPlayer());
+    }
 
     // Notify players
     for(unsigned i = 0; i < GetNumPlayers(); ++i)
@@ -520,11 +567,8 @@ bool GameWorld::DoesDestructionChangeTerritory(const noBaseBuilding& building) c
     return false;
 }
 
-TerritoryRegion GameWorld::CreateTerritoryRegion(const noBaseBuilding& building, unsigned radius,
-                                                 TerritoryChangeReason reason) const
+TerritoryRegion GameWorld::CreateEmptyTerritoryRegion(const MapPoint pt, unsigned radius) const
 {
-    const MapPoint bldPos = building.GetPos();
-
     // Span at most half the map size (assert even sizes, given due to layout)
     RTTR_Assert(GetWidth() % 2 == 0);
     RTTR_Assert(GetHeight() % 2 == 0);
@@ -532,11 +576,18 @@ TerritoryRegion GameWorld::CreateTerritoryRegion(const noBaseBuilding& building,
     Extent radius2D = elMin(Extent::all(radius), halfSize);
 
     // Koordinaten erzeugen für TerritoryRegion
-    const Position startPt = Position(bldPos) - radius2D;
+    const Position startPt = Position(pt) - radius2D;
     // If we want to check the same number of points right of bld as left we need a +1.
     // But we can't check more than the whole map.
     const Extent size = elMin(2u * radius2D + Extent(1, 1), Extent(GetSize()));
-    TerritoryRegion region(startPt, size, *this);
+    return TerritoryRegion(startPt, size, *this);
+}
+
+TerritoryRegion GameWorld::CreateTerritoryRegion(const noBaseBuilding& building, unsigned radius,
+                                                 TerritoryChangeReason reason) const
+{
+    const MapPoint bldPos = building.GetPos();
+    TerritoryRegion region = CreateEmptyTerritoryRegion(bldPos, radius);
 
     // Alle Gebäude ihr Terrain in der Nähe neu berechnen
     sortedMilitaryBlds buildings = LookForMilitaryBuildings(bldPos, 3);
@@ -693,12 +744,15 @@ void GameWorld::RoadNodeAvailable(const MapPoint pt)
         if(!IsRoadNodeForFigures(pt))
             continue;
 
-        // Figuren Bescheid sagen
+        // Figuren Bescheid sagen (collect first as they may start walking which could change the figures)
+        std::vector<noFigure*> figures;
         for(noBase& object : GetFigures(nb))
         {
             if(object.GetType() == NodalObjectType::Figure)
-                static_cast<noFigure&>(object).NodeFreed(pt);
+                figures.push_back(static_cast<noFigure*>(&object));
         }
+        for(noFigure* figure : figures)
+            figure->NodeFreed(pt);
     }
 }
 
@@ -963,7 +1017,7 @@ bool GameWorld::ValidWaitingAroundBuildingPoint(const MapPoint pt, const MapPoin
             return false;
     }
     // object wall or impassable terrain increasing my path to target length to a higher value than the direct distance?
-    return FindHumanPath(pt, center, CalcDistance(pt, center)) != boost::none;
+    return FindHumanPathLength(pt, center, CalcDistance(pt, center));
 }
 
 bool GameWorld::IsValidPointForFighting(MapPoint pt, const nofActiveSoldier& soldier,
@@ -1008,100 +1062,10 @@ bool GameWorld::IsValidPointForFighting(MapPoint pt, const nofActiveSoldier& sol
     return bm == BlockingManner::None || bm == BlockingManner::Tree || bm == BlockingManner::Flag;
 }
 
-bool GameWorld::IsPointCompletelyVisible(const MapPoint& pt, unsigned char player,
-                                         const noBaseBuilding* exception) const
-{
-    sortedMilitaryBlds buildings = LookForMilitaryBuildings(pt, 3);
-
-    // Sichtbereich von Militärgebäuden
-    for(const nobBaseMilitary* milBld : buildings)
-    {
-        if(milBld->GetPlayer() == player && milBld != exception)
-        {
-            // Prüfen, obs auch unbesetzt ist
-            if(milBld->GetGOT() == GO_Type::NobMilitary)
-            {
-                if(static_cast<const nobMilitary*>(milBld)->IsNewBuilt())
-                    continue;
-            }
-
-            if(CalcDistance(pt, milBld->GetPos()) <= unsigned(milBld->GetMilitaryRadius() + VISUALRANGE_MILITARY))
-                return true;
-        }
-    }
-
-    // Sichtbereich von Hafenbaustellen
-    for(const noBuildingSite* bldSite : harbor_building_sites_from_sea)
-    {
-        if(bldSite->GetPlayer() == player && bldSite != exception)
-        {
-            if(CalcDistance(pt, bldSite->GetPos()) <= unsigned(HARBOR_RADIUS + VISUALRANGE_MILITARY))
-                return true;
-        }
-    }
-
-    // Sichtbereich von Spähtürmen
-    for(const nobUsual* bld : GetPlayer(player).GetBuildingRegister().GetBuildings(BuildingType::LookoutTower)) //-V807
-    {
-        // Ist Späturm überhaupt besetzt?
-        if(!bld->HasWorker())
-            continue;
-
-        // Nicht die Ausnahme wählen
-        if(bld == exception)
-            continue;
-
-        // Liegt Spähturm innerhalb des Sichtradius?
-        if(CalcDistance(pt, bld->GetPos()) <= VISUALRANGE_LOOKOUTTOWER)
-            return true;
-    }
-
-    // Check scouts and soldiers
-    const unsigned range = std::max(VISUALRANGE_SCOUT, VISUALRANGE_SOLDIER);
-    if(CheckPointsInRadius(
-         pt, range,
-         [this, player](auto pt, auto distance) { return this->IsScoutingFigureOnNode(pt, player, distance); }, true))
-    {
-        return true;
-    }
-    return IsPointScoutedByShip(pt, player);
-}
-
-bool GameWorld::IsScoutingFigureOnNode(const MapPoint& pt, unsigned player, unsigned distance) const
+bool GameWorld::IsPointCompletelyVisible(const MapPoint& pt, unsigned char player) const
 {
-    static_assert(VISUALRANGE_SCOUT >= VISUALRANGE_SOLDIER, "Visual range changed. Check loop below!");
-
-    // Späher/Soldaten in der Nähe prüfen und direkt auf dem Punkt
-    for(const noBase& obj : GetFigures(pt))
-    {
-        const GO_Type got = obj.GetGOT();
-        // Check for scout. Note: no need to check for distance as scouts have higher distance than soldiers
-        if(got == GO_Type::NofScoutFree)
-        {
-            // Prüfen, ob er auch am Erkunden ist und an der Position genau und ob es vom richtigen Spieler ist
-            if(static_cast<const nofScout_Free&>(obj).GetPlayer() == player)
-                return true;
-            else
-                continue;
-        } else if(distance <= VISUALRANGE_SOLDIER)
-        {
-            // Soldaten?
-            if(got == GO_Type::NofAttacker || got == GO_Type::NofAggressivedefender)
-            {
-                if(static_cast<const nofActiveSoldier&>(obj).GetPlayer() == player)
-                    return true;
-            }
-            // Kämpfe (wo auch Soldaten drin sind)
-            else if(got == GO_Type::Fighting)
-            {
-                // Prüfen, ob da ein Soldat vom angegebenen Spieler dabei ist
-                if(static_cast<const noFighting&>(obj).IsSoldierOfPlayer(player))
-                    return true;
-            }
-        }
-    }
-
-    return false;
+    // Ships change their visual range depending on their task, so they are not registered as viewers
+    return GetNumViewers(pt, player) > 0u || IsPointScoutedByShip(pt, player);
 }
 
 bool GameWorld::IsPointScoutedByShip(const MapPoint& pt, unsigned player) const
@@ -1116,13 +1080,13 @@ bool GameWorld::IsPointScoutedByShip(const MapPoint& pt, unsigned player) const
     return false;
 }
 
-void GameWorld::RecalcVisibility(const MapPoint pt, const unsigned char player, const noBaseBuilding* const exception)
+void GameWorld::RecalcVisibility(const MapPoint pt, const unsigned char player)
 {
     /// Zustand davor merken
-    Visibility visibility_before = GetNode(pt).fow[player].visibility;
+    Visibility visibility_before = GetFoWNode(pt, player).visibility;
 
     /// Herausfinden, ob vollständig sichtbar
-    bool visible = IsPointCompletelyVisible(pt, player, exception);
+    bool visible = IsPointCompletelyVisible(pt, player);
 
     // Vollständig sichtbar --> vollständig sichtbar logischerweise
     if(visible)
@@ -1156,12 +1120,11 @@ void GameWorld::MakeVisible(const MapPoint pt, const unsigned char player)
     SetVisibility(pt, player, Visibility::Visible);
 }
 
-void GameWorld::RecalcVisibilitiesAroundPoint(const MapPoint pt, const MapCoord radius, const unsigned char player,
-                                              const noBaseBuilding* const exception)
+void GameWorld::RecalcVisibilitiesAroundPoint(const MapPoint pt, const MapCoord radius, const unsigned char player)
 {
     std::vector<MapPoint> pts = GetPointsInRadiusWithCenter(pt, radius);
     for(const MapPoint& pt : pts)
-        RecalcVisibility(pt, player, exception);
+        RecalcVisibility(pt, player);
 }
 
 /// Setzt die Sichtbarkeiten um einen Punkt auf sichtbar (aus Performancegründen Alternative zu oberem)
@@ -1193,7 +1156,7 @@ void GameWorld::RecalcMovingVisibilities(const MapPoint pt, const unsigned char
         // Sichtbarkeit und für FOW-Gebiet vorherigen Besitzer merken
         // (d.h. der dort  zuletzt war, als es für Spieler player sichtbar war)
         Visibility old_vis = CalcVisiblityWithAllies(tt, player);
-        unsigned char old_owner = GetNode(tt).fow[player].owner;
+        unsigned char old_owner = GetFoWNode(tt, player).owner;
         MakeVisible(tt, player);
         // Neues feindliches Gebiet entdeckt?
         // Muss vorher undaufgedeckt oder FOW gewesen sein, aber in dem Fall darf dort vorher noch kein
@@ -1217,7 +1180,7 @@ void GameWorld::RecalcMovingVisibilities(const MapPoint pt, const unsigned char
         // Sichtbarkeit und für FOW-Gebiet vorherigen Besitzer merken
         // (d.h. der dort  zuletzt war, als es für Spieler player sichtbar war)
         Visibility old_vis = CalcVisiblityWithAllies(tt, player);
-        unsigned char old_owner = GetNode(tt).fow[player].owner;
+        unsigned char old_owner = GetFoWNode(tt, player).owner;
         MakeVisible(tt, player);
         // Neues feindliches Gebiet entdeckt?
         // Muss vorher undaufgedeckt oder FOW gewesen sein, aber in dem Fall darf dort vorher noch kein
@@ -1240,13 +1203,13 @@ void GameWorld::RecalcMovingVisibilities(const MapPoint pt, const unsigned char
     for(MapCoord i = 0; i < radius + 1; ++i)
         t = GetNeighbour(t, anti_moving_dir);
 
-    RecalcVisibility(t, player, nullptr);
+    RecalcVisibility(t, player);
     tt = t;
     dir = anti_moving_dir + 2u;
     for(MapCoord i = 0; i < radius; ++i)
     {
         tt = GetNeighbour(tt, dir);
-        RecalcVisibility(tt, player, nullptr);
+        RecalcVisibility(tt, player);
     }
 
     tt = t;
@@ -1254,7 +1217,7 @@ void GameWorld::RecalcMovingVisibilities(const MapPoint pt, const unsigned char
     for(unsigned i = 0; i < radius; ++i)
     {
         tt = GetNeighbour(tt, dir);
-        RecalcVisibility(tt, player, nullptr);
+        RecalcVisibility(tt, player);
     }
 }
 
@@ -1362,19 +1325,33 @@ bool GameWorld::FoundColony(const unsigned harbor_point, const unsigned char pla
     if(gi)
         gi->GI_UpdateMinimap(pos);
 
-    RecalcTerritory(*bs, TerritoryChangeReason::Build);
-    // BQ neu berechnen (evtl durch RecalcTerritory noch nicht geschehen)
-    RecalcBQAroundPointBig(pos);
+    {
+        BQUpdateBatch bqBatch(*this);
+        RecalcTerritory(*bs, TerritoryChangeReason::Build);
+        // BQ neu berechnen (evtl durch RecalcTerritory noch nicht geschehen)
+        RecalcBQAroundPointBig(pos);
+    }
 
     GetNotifications().publish(ExpeditionNote(ExpeditionNote::ColonyFounded, player, pos));
 
     return true;
 }
 
+void GameWorld::AddHarborBuildingSiteFromSea(noBuildingSite* building_site)
+{
+    harbor_building_sites_from_sea.push_back(building_site);
+    militaryInfluence.Add(*this, *building_site);
+    AddViewer(building_site->GetPos(), HARBOR_RADIUS + VISUALRANGE_MILITARY, building_site->GetPlayer());
+}
+
 void GameWorld::RemoveHarborBuildingSiteFromSea(noBuildingSite* building_site)
 {
     RTTR_Assert(building_site->GetBuildingType() == BuildingType::HarborBuilding);
+    if(!helpers::contains(harbor_building_sites_from_sea, building_site))
+        return;
     harbor_building_sites_from_sea.remove(building_site);
+    RemoveMilitaryInfluence(*building_site);
+    RemoveViewer(building_site->GetPos(), HARBOR_RADIUS + VISUALRANGE_MILITARY, building_site->GetPlayer());
 }
 
 bool GameWorld::IsHarborBuildingSiteFromSea(const noBuildingSite* building_site) const
@@ -1398,9 +1375,18 @@ std::vector<unsigned> GameWorld::GetUnexploredHarborPoints(const unsigned hbIdTo
 
 MapNode& GameWorld::GetNodeWriteable(const MapPoint pt)
 {
+    RTTR_Assert_Msg(!AreAIsRunning(), "World must not be changed while the AIs run");
+    // Anything might be changed, including the terrain which affects the neighbours of the neighbours
+    regionEpochs.MarkChanged(pt, 2);
+    harborRoutes.ClearRoutes();
     return GetNodeInt(pt);
 }
 
+FoWNode& GameWorld::GetFoWNodeWriteable(const MapPoint pt, unsigned player)
+{
+    return GetFoWNodeInt(pt, player);
+}
+
 void GameWorld::VisibilityChanged(const MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis)
 {
     GameWorldBase::VisibilityChanged(pt, player, oldVis, newVis);
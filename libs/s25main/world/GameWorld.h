@@ -31,25 +31,27 @@ enum class TerritoryChangeReason
 /// "Interface-Klasse" für das Spiel
 class GameWorld : public GameWorldBase
 {
+    /// Marks points already handled by RecalcTerritory. All false outside of it
+    std::vector<bool> isTerritoryPtHandled;
+
     /// Destroys player belongings if that pint does not belong to the player anymore
     void DestroyPlayerRests(MapPoint pt, unsigned char newOwner, const noBaseBuilding* exception);
 
     /// Return if there are deco-objects that can be removed when building roads
     bool HasRemovableObjForRoad(MapPoint pt) const;
 
-    bool IsPointCompletelyVisible(const MapPoint& pt, unsigned char player, const noBaseBuilding* exception) const;
-    /// Return if there is a scout (or an attacking soldier) of this player at that node with a visual range of at most
-    /// the given distance. Excludes scouting ships!
-    bool IsScoutingFigureOnNode(const MapPoint& pt, unsigned player, unsigned distance) const;
+    /// Return true if any vision source of the player (see World::GetNumViewers) or any of its ships sees the point
+    bool IsPointCompletelyVisible(const MapPoint& pt, unsigned char player) const;
     /// Return true, if the point is explored by any ship of the player
     bool IsPointScoutedByShip(const MapPoint& pt, unsigned player) const;
-    /// Berechnet die Sichtbarkeit eines Punktes neu für den angegebenen Spieler
-    /// exception ist ein Gebäude (Spähturm, Militärgebäude), was nicht mit in die Berechnung einbezogen
-    /// werden soll, z.b. weil es abgerissen wird
-    void RecalcVisibility(MapPoint pt, unsigned char player, const noBaseBuilding* exception);
+    /// Berechnet die Sichtbarkeit eines Punktes neu für den angegebenen Spieler.
+    /// Vision sources which vanish (e.g. a destroyed building) must have been removed before
+    void RecalcVisibility(MapPoint pt, unsigned char player);
     /// Setzt Punkt auf jeden Fall auf sichtbar
     void MakeVisible(MapPoint pt, unsigned char player);
 
+    /// Creates a region without any territory around the point with the given radius
+    TerritoryRegion CreateEmptyTerritoryRegion(MapPoint pt, unsigned radius) const;
     /// Creates a region with territories marked around a building with the given radius
     TerritoryRegion CreateTerritoryRegion(const noBaseBuilding& building, unsigned radius,
                                           TerritoryChangeReason reason) const;
@@ -134,8 +136,7 @@ public:
     bool IsValidPointForFighting(MapPoint pt, const nofActiveSoldier& soldier, bool avoid_military_building_flags);
 
     /// Berechnet die Sichtbarkeiten neu um einen Punkt mit radius
-    void RecalcVisibilitiesAroundPoint(MapPoint pt, MapCoord radius, unsigned char player,
-                                       const noBaseBuilding* exception);
+    void RecalcVisibilitiesAroundPoint(MapPoint pt, MapCoord radius, unsigned char player);
     /// Setzt die Sichtbarkeiten um einen Punkt auf sichtbar (aus Performancegründen Alternative zu oberem)
     void MakeVisibleAroundPoint(MapPoint pt, MapCoord radius, unsigned char player);
     /// Bestimmt bei der Bewegung eines spähenden Objekts die Sichtbarkeiten an den Rändern neu
@@ -157,10 +158,7 @@ public:
     /// Gründet vom Schiff aus eine neue Kolonie, gibt true zurück bei Erfolg
     bool FoundColony(unsigned harbor_point, unsigned char player, unsigned short seaId);
     /// Registriert eine Baustelle eines Hafens, die vom Schiff aus gesetzt worden ist
-    void AddHarborBuildingSiteFromSea(noBuildingSite* building_site)
-    {
-        harbor_building_sites_from_sea.push_back(building_site);
-    }
+    void AddHarborBuildingSiteFromSea(noBuildingSite* building_site);
     /// Removes it. It is allowed to be called with a regular harbor building site (no-op in that case)
     void RemoveHarborBuildingSiteFromSea(noBuildingSite* building_site);
     /// Gibt zurück, ob eine bestimmte Baustellen eine Baustelle ist, die vom Schiff aus errichtet wurde
@@ -170,6 +168,7 @@ public:
 
     /// Writeable access to node. Use only for initial map setup!
     MapNode& GetNodeWriteable(MapPoint pt);
+    FoWNode& GetFoWNodeWriteable(MapPoint pt, unsigned player);
     /// Recalculates where border stones should be done after a change in the given region
     void RecalcBorderStones(Position startPt, Extent areaSize);
 
@@ -11,8 +11,10 @@
 #include "SoundManager.h"
 #include "TradePathCache.h"
 #include "addons/const_addons.h"
+#include "buildings/noBuildingSite.h"
 #include "buildings/nobHarborBuilding.h"
 #include "buildings/nobMilitary.h"
+#include "buildings/nobUsual.h"
 #include "figures/nofPassiveSoldier.h"
 #include "helpers/EnumRange.h"
 #include "helpers/containerUtils.h"
@@ -24,12 +26,14 @@
 #include "nodeObjs/noFlag.h"
 #include "gameData/BuildingProperties.h"
 #include "gameData/GameConsts.h"
+#include "gameData/MilitaryConsts.h"
 #include "gameData/TerrainDesc.h"
 #include <utility>
 
 GameWorldBase::GameWorldBase(std::vector<GamePlayer> players, const GlobalGameSettings& gameSettings, EventManager& em)
-    : roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)), players(std::move(players)),
-      gameSettings(gameSettings), em(em), soundManager(std::make_unique<SoundManager>()), lua(nullptr), gi(nullptr)
+    : World(players.size()), roadPathFinder(new RoadPathFinder(*this)), freePathFinder(new FreePathFinder(*this)),
+      players(std::move(players)), gameSettings(gameSettings), em(em), soundManager(std::make_unique<SoundManager>()),
+      lua(nullptr), bqBatchDepth(0), gi(nullptr)
 {}
 
 GameWorldBase::~GameWorldBase() = default;
@@ -39,12 +43,113 @@ void GameWorldBase::Init(const MapExtent& mapSize, DescIdx<LandscapeDesc> lt)
     RTTR_Assert(GetDescription().terrain.size() > 0); // Must have game data initialized
     World::Init(mapSize, lt);
     freePathFinder->Init(mapSize);
+    bqDirtyPts.clear();
+    isBQDirty.assign(prodOfComponents(mapSize), false);
+    militaryInfluence.Init(mapSize);
 }
 
 void GameWorldBase::InitAfterLoad()
 {
+    // Roads might have been loaded
+    roadPathFinder->OnRoadNetworkChanged();
+    // The map was changed without tracking the changes while loading
+    freePathFinder->ClearCache();
+    RecalcStateHash();
+    RecalcViewers();
+    RecalcMilitaryInfluence();
+    // Terrain is the same for all points, so calculate its part for the whole map at once
+    const std::vector<BuildingQuality> terrainBQs = BQCalculator::CalcTerrainBQs(*this);
+    BQCalculator calcBQ(*this, terrainBQs);
     RTTR_FOREACH_PT(MapPoint, GetSize())
-        RecalcBQ(pt);
+    {
+        if(SetBQ(pt, calcBQ(pt, [this](auto pt) { return this->IsOnRoad(pt); })))
+            GetNotifications().publish(NodeNote(NodeNote::BQ, pt));
+    }
+}
+
+void GameWorldBase::RecalcStateHash()
+{
+    stateHash.Reset();
+    RTTR_FOREACH_PT(MapPoint, GetSize())
+    {
+        const MapNode& node = GetNode(pt);
+        const unsigned idx = GetIdx(pt);
+        stateHash.ToggleOwner(idx, node.owner);
+        if(node.obj)
+            stateHash.ToggleObject(idx, node.obj->GetObjId());
+        for(const auto dir : helpers::EnumRange<RoadDir>{})
+            stateHash.ToggleRoad(idx, dir, node.roads[dir]);
+        for(const auto& figure : node.figures)
+            stateHash.ToggleFigure(idx, figure->GetObjId());
+    }
+    for(const GamePlayer& player : players)
+    {
+        const Inventory& inventory = player.GetInventory();
+        for(const auto good : helpers::EnumRange<GoodType>{})
+            stateHash.ToggleInventory(player.GetPlayerId(), good, inventory[good]);
+        for(const auto job : helpers::EnumRange<Job>{})
+            stateHash.ToggleInventory(player.GetPlayerId(), job, inventory[job]);
+    }
+}
+
+void GameWorldBase::RecalcViewers()
+{
+    ClearViewers();
+    RTTR_FOREACH_PT(MapPoint, GetSize())
+    {
+        const MapNode& node = GetNode(pt);
+        if(node.obj)
+        {
+            const GO_Type got = node.obj->GetGOT();
+            if(got == GO_Type::NobHq || got == GO_Type::NobHarborbuilding
+               || (got == GO_Type::NobMilitary && !static_cast<const nobMilitary*>(node.obj)->IsNewBuilt()))
+            {
+                const auto& bld = static_cast<const nobBaseMilitary&>(*node.obj);
+                AddViewer(pt, bld.GetMilitaryRadius() + VISUALRANGE_MILITARY, bld.GetPlayer());
+            } else if(got == GO_Type::NobUsual)
+            {
+                // Lookout towers see as long as they have a worker (see nofScout_LookoutTower)
+                const auto& bld = static_cast<const nobUsual&>(*node.obj);
+                if(bld.GetBuildingType() == BuildingType::LookoutTower && bld.HasWorker())
+                    AddViewer(pt, VISUALRANGE_LOOKOUTTOWER, bld.GetPlayer());
+            }
+        }
+        for(const noBase& figure : GetFigures(pt))
+            ChangeFigureViewers(pt, figure, true);
+    }
+    for(const noBuildingSite* bldSite : harbor_building_sites_from_sea)
+        AddViewer(bldSite->GetPos(), HARBOR_RADIUS + VISUALRANGE_MILITARY, bldSite->GetPlayer());
+}
+
+void GameWorldBase::RecalcMilitaryInfluence()
+{
+    militaryInfluence.Clear();
+    RTTR_FOREACH_PT(MapPoint, GetSize())
+    {
+        const noBase* obj = GetNode(pt).obj;
+        if(obj && (obj->GetGOT() == GO_Type::NobHq || obj->GetGOT() == GO_Type::NobHarborbuilding
+                   || obj->GetGOT() == GO_Type::NobMilitary))
+            militaryInfluence.Add(*this, static_cast<const nobBaseMilitary&>(*obj));
+    }
+    for(const noBuildingSite* bldSite : harbor_building_sites_from_sea)
+        militaryInfluence.Add(*this, *bldSite);
+}
+
+void GameWorldBase::RemoveMilitaryInfluence(const noBaseBuilding& building)
+{
+    if(!militaryInfluence.Remove(*this, building))
+        return;
+    // Claims of other buildings on nodes they already hold don't change anything
+    for(const nobBaseMilitary* milBld : LookForMilitaryBuildings(building.GetPos(), 3))
+    {
+        if(milBld != &building)
+            militaryInfluence.Add(*this, *milBld);
+    }
+    for(const noBuildingSite* bldSite : harbor_building_sites_from_sea)
+    {
+        if(bldSite != &building)
+            militaryInfluence.Add(*this, *bldSite);
+    }
 }
 
 GamePlayer& GameWorldBase::GetPlayer(const unsigned id)
@@ -270,6 +375,7 @@ void GameWorldBase::AltitudeChanged(const MapPoint pt)
 
 void GameWorldBase::RecalcBQAroundPoint(const MapPoint pt)
 {
+    BQUpdateBatch bqBatch(*this);
     RecalcBQ(pt);
     for(const MapPoint nb : GetNeighbours(pt))
         RecalcBQ(nb);
@@ -277,6 +383,7 @@ void GameWorldBase::RecalcBQAroundPoint(const MapPoint pt)
 
 void GameWorldBase::RecalcBQAroundPointBig(const MapPoint pt)
 {
+    BQUpdateBatch bqBatch(*this);
     // Point and radius 1
     RecalcBQAroundPoint(pt);
     // And radius 2
@@ -286,8 +393,7 @@ void GameWorldBase::RecalcBQAroundPointBig(const MapPoint pt)
 
 Visibility GameWorldBase::CalcVisiblityWithAllies(const MapPoint pt, const unsigned char player) const
 {
-    const MapNode& node = GetNode(pt);
-    Visibility best_visibility = node.fow[player].visibility;
+    Visibility best_visibility = GetFoWNode(pt, player).visibility;
 
     if(best_visibility == Visibility::Visible)
         return best_visibility;
@@ -295,15 +401,12 @@ Visibility GameWorldBase::CalcVisiblityWithAllies(const MapPoint pt, const unsig
     /// Teamsicht aktiviert?
     if(GetGGS().teamView)
     {
-        const GamePlayer& curPlayer = GetPlayer(player);
         // Dann prüfen, ob Teammitglieder evtl. eine bessere Sicht auf diesen Punkt haben
-        for(unsigned i = 0; i < GetNumPlayers(); ++i)
+        const unsigned allies = GetPlayer(player).GetAllyMask() & ~(1u << player);
+        for(unsigned i = 0; (allies >> i) != 0u && best_visibility != Visibility::Visible; ++i)
         {
-            if(i != player && curPlayer.IsAlly(i))
-            {
-                if(node.fow[i].visibility > best_visibility)
-                    best_visibility = node.fow[i].visibility;
-            }
+            if((allies & (1u << i)) && GetFoWNode(pt, i).visibility > best_visibility)
+                best_visibility = GetFoWNode(pt, i).visibility;
         }
     }
 
@@ -417,7 +520,7 @@ bool GameWorldBase::IsAHarborInSeaAttackDistance(const MapPoint pos) const
     {
         if(CalcDistance(pos, GetHarborPoint(i)) < SEAATTACK_DISTANCE)
         {
-            if(FindHumanPath(pos, GetHarborPoint(i), SEAATTACK_DISTANCE))
+            if(FindHumanPathLength(pos, GetHarborPoint(i), SEAATTACK_DISTANCE))
                 return true;
         }
     }
@@ -471,7 +574,7 @@ std::vector<unsigned> GameWorldBase::GetUsableTargetHarborsForAttack(const MapPo
 
             // Can figures reach flag from coast
             const MapPoint coastalPt = GetCoastalPoint(curHbId, seaId);
-            if((flagPt == coastalPt) || FindHumanPath(flagPt, coastalPt, SEAATTACK_DISTANCE))
+            if((flagPt == coastalPt) || FindHumanPathLength(flagPt, coastalPt, SEAATTACK_DISTANCE))
             {
                 use_seas.at(seaId - 1) = true;
                 if(!harborinlist)
@@ -534,7 +637,7 @@ std::vector<unsigned short> GameWorldBase::GetFilteredSeaIDsForAttack(const MapP
 
             // Can figures reach flag from coast
             MapPoint coastalPt = GetCoastalPoint(curHbId, seaId);
-            if((flagPt == coastalPt) || FindHumanPath(flagPt, coastalPt, SEAATTACK_DISTANCE))
+            if((flagPt == coastalPt) || FindHumanPathLength(flagPt, coastalPt, SEAATTACK_DISTANCE))
             {
                 confirmedSeaIds.push_back(seaId);
                 // all sea ids confirmed? return without changes
@@ -559,7 +662,7 @@ std::vector<unsigned> GameWorldBase::GetHarborPointsAroundMilitaryBuilding(const
         if(CalcDistance(harborPt, pt) <= SEAATTACK_DISTANCE)
         {
             // Wird ein Weg vom Militärgebäude zum Hafen gefunden bzw. Ziel = Hafen?
-            if(pt == harborPt || FindHumanPath(pt, harborPt, SEAATTACK_DISTANCE))
+            if(pt == harborPt || FindHumanPathLength(pt, harborPt, SEAATTACK_DISTANCE))
                 harbor_points.push_back(i);
         }
     }
@@ -690,6 +793,35 @@ GameWorldBase::GetSoldiersForSeaAttack(const unsigned char player_attacker, cons
 }
 
 void GameWorldBase::RecalcBQ(const MapPoint pt)
+{
+    RTTR_Assert_Msg(!AreAIsRunning(), "World must not be changed while the AIs run");
+    if(bqBatchDepth == 0)
+    {
+        UpdateBQ(pt);
+        return;
+    }
+    const unsigned idx = GetIdx(pt);
+    if(!isBQDirty[idx])
+    {
+        isBQDirty[idx] = true;
+        bqDirtyPts.push_back(pt);
+    }
+}
+
+BuildingQuality GameWorldBase::GetUpToDateBQ(const MapPoint pt)
+{
+    // Might update the BQ
+    RTTR_Assert_Msg(!AreAIsRunning(), "World must not be changed while the AIs run");
+    const unsigned idx = GetIdx(pt);
+    if(isBQDirty[idx])
+    {
+        isBQDirty[idx] = false;
+        UpdateBQ(pt);
+    }
+    return GetNode(pt).bq;
+}
+
+void GameWorldBase::UpdateBQ(const MapPoint pt)
 {
     BQCalculator calcBQ(*this);
     if(SetBQ(pt, calcBQ(pt, [this](auto pt) { return this->IsOnRoad(pt); })))
@@ -697,3 +829,18 @@ void GameWorldBase::RecalcBQ(const MapPoint pt)
         GetNotifications().publish(NodeNote(NodeNote::BQ, pt));
     }
 }
+
+void GameWorldBase::FlushBQ()
+{
+    // Points are recalculated in the order of their first recalculation request using the current state of the map
+    for(const MapPoint pt : bqDirtyPts)
+    {
+        const unsigned idx = GetIdx(pt);
+        // Might have been done already by GetUpToDateBQ
+        if(!isBQDirty[idx])
+            continue;
+        isBQDirty[idx] = false;
+        UpdateBQ(pt);
+    }
+    bqDirtyPts.clear();
+}
@@ -11,6 +11,7 @@
 #include "lua/LuaInterfaceGame.h"
 #include "notifications/NotificationManager.h"
 #include "postSystem/PostManager.h"
+#include "world/MilitaryInfluence.h"
 #include "world/World.h"
 #include <memory>
 #include <vector>
@@ -59,14 +60,38 @@ class GameWorldBase : public World
     EventManager& em;
     std::unique_ptr<SoundManager> soundManager;
     LuaInterfaceGame* lua;
+    /// Number of active BQUpdateBatch instances
+    unsigned bqBatchDepth;
+    /// Points whose BQ recalculation was deferred by a BQUpdateBatch
+    std::vector<MapPoint> bqDirtyPts;
+    std::vector<bool> isBQDirty;
 
 protected:
     /// Interface zum GUI
     GameInterface* gi;
     std::unique_ptr<EconomyModeHandler> econHandler;
     std::unique_ptr<TradePathCache> tradePathCache;
+    /// Closest territory holding building of each node
+    MilitaryInfluence militaryInfluence;
 
 public:
+    /// While an instance exists, BQ recalculations are only recorded and done once per point when the last instance is
+    /// destroyed. BQs of recorded points must not be read directly in the meantime, see GetUpToDateBQ
+    class BQUpdateBatch
+    {
+        GameWorldBase& world_;
+
+    public:
+        explicit BQUpdateBatch(GameWorldBase& world) : world_(world) { ++world_.bqBatchDepth; }
+        BQUpdateBatch(const BQUpdateBatch&) = delete;
+        BQUpdateBatch& operator=(const BQUpdateBatch&) = delete;
+        ~BQUpdateBatch()
+        {
+            if(--world_.bqBatchDepth == 0)
+                world_.FlushBQ();
+        }
+    };
+
     GameWorldBase(std::vector<GamePlayer> players, const GlobalGameSettings& gameSettings, EventManager& em);
     ~GameWorldBase() override;
 
@@ -76,6 +101,13 @@ public:
     virtual void CreateTradeGraphs() = 0;
     // Remaining initialization after loading (BQ...)
     void InitAfterLoad();
+    /// Calculate the state hash from scratch. Required after changes which are not tracked, e.g. loading
+    void RecalcStateHash();
+    /// Register all vision sources from scratch. Required after loading
+    void RecalcViewers();
+    /// Claim the territory of all buildings from scratch. Required after loading or changing restricted areas
+    void RecalcMilitaryInfluence();
+    const MilitaryInfluence& GetMilitaryInfluence() const { return militaryInfluence; }
 
     /// Setzt GameInterface
     void SetGameInterface(GameInterface* const gi) { this->gi = gi; }
@@ -109,6 +141,10 @@ public:
     helpers::OptionalEnum<Direction> FindHumanPath(MapPoint start, MapPoint dest, unsigned max_route = 0xFFFFFFFF,
                                                    bool random_route = false, unsigned* length = nullptr,
                                                    std::vector<Direction>* route = nullptr) const;
+    /// Return whether there is a path for figures and optionally its length.
+    /// Same as FindHumanPath but faster when the route itself is not required
+    bool FindHumanPathLength(MapPoint start, MapPoint dest, unsigned max_route = 0xFFFFFFFF,
+                             unsigned* length = nullptr) const;
     /// Find path for ships to a specific harbor and see. Return true on success
     bool FindShipPathToHarbor(MapPoint start, unsigned harborId, unsigned seaId, std::vector<Direction>* route,
                               unsigned* length);
@@ -206,8 +242,10 @@ public:
     unsigned GetNumSoldiersForSeaAttackAtSea(unsigned char player_attacker, unsigned short seaid,
                                              bool returnCount = true) const;
 
-    /// Recalculates the BQ for the given point
+    /// Recalculates the BQ for the given point (deferred if a BQUpdateBatch is active)
     void RecalcBQ(MapPoint pt);
+    /// Return the BQ of the point doing a deferred recalculation first if required
+    BuildingQuality GetUpToDateBQ(MapPoint pt);
 
     bool HasLua() const { return lua != nullptr; }
     LuaInterfaceGame& GetLua() const { return *lua; }
@@ -218,8 +256,15 @@ protected:
     void VisibilityChanged(MapPoint pt, unsigned player, Visibility oldVis, Visibility newVis) override;
     /// Called, when the altitude of a point was changed
     void AltitudeChanged(MapPoint pt) override;
+    /// Release the territory of the building and let all other buildings that might reach it claim it again
+    void RemoveMilitaryInfluence(const noBaseBuilding& building);
 
 private:
+    /// Calculate the BQ of the point now and notify about changes
+    void UpdateBQ(MapPoint pt);
+    /// Do all deferred BQ recalculations
+    void FlushBQ();
+
     /// Returns the harbor ID of the next matching harbor in the given direction (0 = None)
     /// T_IsHarborOk must be a predicate taking a harbor Id and returning a bool if the harbor is valid to return
     template<typename T_IsHarborOk>
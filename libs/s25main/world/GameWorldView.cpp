@@ -18,6 +18,7 @@
 #include "helpers/EnumArray.h"
 #include "helpers/containerUtils.h"
 #include "helpers/toString.h"
+#include "notifications/NodeNote.h"
 #include "ogl/FontStyle.h"
 #include "ogl/glArchivItem_Bitmap.h"
 #include "ogl/glFont.h"
@@ -36,10 +37,15 @@
 
 GameWorldView::GameWorldView(const GameWorldViewer& gwv, const Position& pos, const Extent& size)
     : selPt(0, 0), show_bq(SETTINGS.ingame.showBQ), show_names(SETTINGS.ingame.showNames),
-      show_productivity(SETTINGS.ingame.showProductivity), offset(0, 0), lastOffset(0, 0), gwv(gwv), origin_(pos),
-      size_(size), zoomFactor_(1.f), targetZoomFactor_(1.f), zoomSpeed_(0.f)
+      show_productivity(SETTINGS.ingame.showProductivity), offset(0, 0), lastOffset(0, 0), visibleNodesValid(false),
+      gwv(gwv), origin_(pos), size_(size), zoomFactor_(1.f), targetZoomFactor_(1.f), zoomSpeed_(0.f)
 {
     MoveBy({0, 0});
+    evAltitudeChanged = GetWorld().GetNotifications().subscribe<NodeNote>([this](const NodeNote& note) {
+        // Node positions and the max altitude (-> last point) change
+        if(note.type == NodeNote::Altitude)
+            CalcFxLx();
+    });
 }
 
 const GameWorldBase& GameWorldView::GetWorld() const
@@ -141,24 +147,28 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
     terrainRenderer.Draw(GetFirstPt(), GetLastPt(), gwv, water);
     glTranslatef(static_cast<GLfloat>(offset.x), static_cast<GLfloat>(offset.y), 0.0f);
 
+    UpdateVisibleNodes(terrainRenderer);
+
+    // Figuren speichern, die in der aktuellen Zeile gemalt werden müssen
+    // und sich zwischen zwei Zeilen befinden, da sie dazwischen laufen
+    std::vector<ObjectBetweenLines> between_lines;
+    // Objects and figures only consist of sprites
+    VIDEODRIVER.BeginSpriteBatch();
     for(int y = firstPt.y; y <= lastPt.y; ++y)
     {
-        // Figuren speichern, die in dieser Zeile gemalt werden müssen
-        // und sich zwischen zwei Zeilen befinden, da sie dazwischen laufen
-        std::vector<ObjectBetweenLines> between_lines;
-
+        between_lines.clear();
         for(int x = firstPt.x; x <= lastPt.x; ++x)
         {
-            Position curOffset;
-            const MapPoint curPt = terrainRenderer.ConvertCoords(Position(x, y), &curOffset);
-            DrawPoint curPos = GetWorld().GetNodePos(curPt) - offset + curOffset;
+            const VisibleNode& node = GetVisibleNode(Position(x, y));
+            const MapPoint curPt = node.pt;
+            const DrawPoint curPos = node.pos;
 
             Position mouseDist = mousePos - curPos;
             mouseDist *= mouseDist;
             if(std::abs(mouseDist.x) + std::abs(mouseDist.y) < shortestDistToMouse)
             {
                 selPt = curPt;
-                selPtOffset = curOffset;
+                selPtOffset = node.mapOffset;
                 shortestDistToMouse = std::abs(mouseDist.x) + std::abs(mouseDist.y);
             }
 
@@ -169,7 +179,7 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
             if(visibility == Visibility::Visible)
             {
                 DrawObject(curPt, curPos);
-                DrawMovingFiguresFromBelow(terrainRenderer, Position(x, y), between_lines);
+                DrawMovingFiguresFromBelow(Position(x, y), between_lines);
                 DrawFigures(curPt, curPos, between_lines);
 
                 // Construction aid mode
@@ -182,19 +192,26 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
                     fowobj->Draw(curPos);
             }
 
-            for(IDrawNodeCallback* callback : drawNodeCallbacks)
-                callback->onDraw(curPt, curPos);
+            if(!drawNodeCallbacks.empty())
+            {
+                // Callbacks may draw anything
+                VIDEODRIVER.EndSpriteBatch();
+                for(IDrawNodeCallback* callback : drawNodeCallbacks)
+                    callback->onDraw(curPt, curPos);
+                VIDEODRIVER.BeginSpriteBatch();
+            }
         }
 
         // Figuren zwischen den Zeilen zeichnen
         for(auto& between_line : between_lines)
             between_line.obj.Draw(between_line.pos);
     }
+    VIDEODRIVER.EndSpriteBatch();
 
     if(show_names || show_productivity)
-        DrawNameProductivityOverlay(terrainRenderer);
+        DrawNameProductivityOverlay();
 
-    DrawGUI(rb, terrainRenderer, selected, drawMouse);
+    DrawGUI(rb, selected, drawMouse);
 
     // Umherfliegende Katapultsteine zeichnen
     for(auto* catapult_stone : GetWorld().catapult_stones)
@@ -215,8 +232,7 @@ void GameWorldView::Draw(const RoadBuildState& rb, const MapPoint selected, bool
     glScissor(0, 0, VIDEODRIVER.GetRenderSize().x, VIDEODRIVER.GetRenderSize().y);
 }
 
-void GameWorldView::DrawGUI(const RoadBuildState& rb, const TerrainRenderer& terrainRenderer,
-                            const MapPoint& selectedPt, bool drawMouse)
+void GameWorldView::DrawGUI(const RoadBuildState& rb, const MapPoint& selectedPt, bool drawMouse)
 {
     // Falls im Straßenbaumodus: Punkte um den aktuellen Straßenbaupunkt herum ermitteln
     helpers::EnumArray<MapPoint, Direction> road_points;
@@ -236,10 +252,10 @@ void GameWorldView::DrawGUI(const RoadBuildState& rb, const TerrainRenderer& ter
     {
         for(int y = firstPt.y; y <= lastPt.y; ++y)
         {
-            // Coordinates transform
-            Position curOffset;
-            MapPoint curPt = terrainRenderer.ConvertCoords(Position(x, y), &curOffset);
-            Position curPos = GetWorld().GetNodePos(curPt) - offset + curOffset;
+            const VisibleNode& node = GetVisibleNode(Position(x, y));
+            const MapPoint curPt = node.pt;
+            const Position curOffset = node.mapOffset;
+            const Position curPos = node.pos;
 
             /// Current point indicated by Mouse
             if(drawMouse && selPt == curPt)
@@ -333,21 +349,20 @@ void GameWorldView::DrawGUI(const RoadBuildState& rb, const TerrainRenderer& ter
     }
 }
 
-void GameWorldView::DrawNameProductivityOverlay(const TerrainRenderer& terrainRenderer)
+void GameWorldView::DrawNameProductivityOverlay()
 {
     for(int x = firstPt.x; x <= lastPt.x; ++x)
     {
         for(int y = firstPt.y; y <= lastPt.y; ++y)
         {
-            // Coordinate transform
-            Position curOffset;
-            MapPoint pt = terrainRenderer.ConvertCoords(Position(x, y), &curOffset);
+            const VisibleNode& node = GetVisibleNode(Position(x, y));
+            const MapPoint pt = node.pt;
 
             const auto* no = GetWorld().GetSpecObj<noBaseBuilding>(pt);
             if(!no)
                 continue;
 
-            Position curPos = GetWorld().GetNodePos(pt) - offset + curOffset;
+            Position curPos = node.pos;
             curPos.y -= 22;
 
             // Is object not belonging to local player?
@@ -448,23 +463,19 @@ void GameWorldView::DrawFigures(const MapPoint& pt, const DrawPoint& curPos,
     }
 }
 
-void GameWorldView::DrawMovingFiguresFromBelow(const TerrainRenderer& terrainRenderer, const DrawPoint& curPos,
-                                               std::vector<ObjectBetweenLines>& between_lines)
+void GameWorldView::DrawMovingFiguresFromBelow(const DrawPoint& curPos, std::vector<ObjectBetweenLines>& between_lines)
 {
     // First draw figures moving towards this point from below
     static const std::array<Direction, 2> aboveDirs = {{Direction::NorthEast, Direction::NorthWest}};
     for(Direction dir : aboveDirs)
     {
         // Get figures opposite the current dir and check if they are moving in this dir
-        // Coordinates transform
-        Position curOffset;
-        MapPoint curPt = terrainRenderer.ConvertCoords(GetNeighbour(curPos, dir + 3u), &curOffset);
-        Position figPos = GetWorld().GetNodePos(curPt) - offset + curOffset;
+        const VisibleNode& node = GetVisibleNode(GetNeighbour(curPos, dir + 3u));
 
-        for(noBase& figure : GetWorld().GetFigures(curPt))
+        for(noBase& figure : GetWorld().GetFigures(node.pt))
         {
             if(figure.IsMoving() && static_cast<noMovable&>(figure).GetCurMoveDir() == dir)
-                between_lines.push_back(ObjectBetweenLines(figure, figPos));
+                between_lines.push_back(ObjectBetweenLines(figure, node.pos));
         }
     }
 }
@@ -613,6 +624,7 @@ void GameWorldView::RemoveDrawNodeCallback(IDrawNodeCallback* callbackToRemove)
 
 void GameWorldView::CalcFxLx()
 {
+    visibleNodesValid = false;
     // Calc first and last point in map units (with 1 extra for incomplete triangles)
     firstPt.x = offset.x / TR_W - 1;
     firstPt.y = offset.y / TR_H - 1;
@@ -637,6 +649,32 @@ void GameWorldView::CalcFxLx()
     }
 }
 
+void GameWorldView::UpdateVisibleNodes(const TerrainRenderer& terrainRenderer)
+{
+    if(visibleNodesValid)
+        return;
+    visibleNodes.clear();
+    for(int y = firstPt.y; y <= lastPt.y + 1; ++y)
+    {
+        for(int x = firstPt.x - 1; x <= lastPt.x + 1; ++x)
+        {
+            VisibleNode node;
+            node.pt = terrainRenderer.ConvertCoords(Position(x, y), &node.mapOffset);
+            node.pos = GetWorld().GetNodePos(node.pt) - offset + node.mapOffset;
+            visibleNodes.push_back(node);
+        }
+    }
+    visibleNodesValid = true;
+}
+
+const GameWorldView::VisibleNode& GameWorldView::GetVisibleNode(const Position& pt) const
+{
+    RTTR_Assert(visibleNodesValid);
+    RTTR_Assert(pt.x >= firstPt.x - 1 && pt.x <= lastPt.x + 1 && pt.y >= firstPt.y && pt.y <= lastPt.y + 1);
+    const unsigned width = lastPt.x - firstPt.x + 3;
+    return visibleNodes[(pt.y - firstPt.y) * width + (pt.x - firstPt.x + 1)];
+}
+
 void GameWorldView::Resize(const Extent& newSize)
 {
     size_ = newSize;
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "DrawPoint.h"
+#include "notifications/Subscription.h"
 #include "gameTypes/MapCoordinates.h"
 #include "gameTypes/MapTypes.h"
 #include <vector>
@@ -53,6 +54,20 @@ class GameWorldView
     /// Last drawn map point
     DrawPoint lastPt;
 
+    /// Map point and screen position of a node in the drawn area
+    struct VisibleNode
+    {
+        MapPoint pt;
+        /// Offset of the node position due to wrapping around the map
+        Position mapOffset;
+        DrawPoint pos;
+    };
+    /// Nodes from firstPt - (1, 0) to lastPt + (1, 1) row by row, including the neighbours below the drawn nodes.
+    /// Calculated on first use after the view was moved, zoomed or resized or an altitude changed
+    std::vector<VisibleNode> visibleNodes;
+    bool visibleNodesValid;
+    Subscription evAltitudeChanged;
+
     const GameWorldViewer& gwv;
 
     /// Top-Left position of the view (window)
@@ -130,17 +145,18 @@ public:
 
 private:
     void CalcFxLx();
+    void UpdateVisibleNodes(const TerrainRenderer& terrainRenderer);
+    /// Return the cached node for the point in map units (firstPt - (1, 0) to lastPt + (1, 1))
+    const VisibleNode& GetVisibleNode(const Position& pt) const;
     void DrawBoundaryStone(const MapPoint& pt, DrawPoint pos, Visibility vis);
     void DrawObject(const MapPoint& pt, const DrawPoint& curPos) const;
     void DrawConstructionAid(const MapPoint& pt, const DrawPoint& curPos);
     void DrawFigures(const MapPoint& pt, const DrawPoint& curPos, std::vector<ObjectBetweenLines>& between_lines) const;
-    void DrawMovingFiguresFromBelow(const TerrainRenderer& terrainRenderer, const DrawPoint& curPos,
-                                    std::vector<ObjectBetweenLines>& between_lines);
+    void DrawMovingFiguresFromBelow(const DrawPoint& curPos, std::vector<ObjectBetweenLines>& between_lines);
 
-    void DrawNameProductivityOverlay(const TerrainRenderer& terrainRenderer);
+    void DrawNameProductivityOverlay();
     void DrawProductivity(const noBaseBuilding& no, const DrawPoint& curPos);
-    void DrawGUI(const RoadBuildState& rb, const TerrainRenderer& terrainRenderer, const MapPoint& selectedPt,
-                 bool drawMouse);
+    void DrawGUI(const RoadBuildState& rb, const MapPoint& selectedPt, bool drawMouse);
 
     void SaveIngameSettingsValues() const;
 };
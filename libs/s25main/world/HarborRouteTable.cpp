@@ -0,0 +1,132 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "world/HarborRouteTable.h"
+#include "RTTR_Assert.h"
+#include "enum_cast.hpp"
+#include "helpers/EnumRange.h"
+#include "helpers/containerUtils.h"
+#include "world/World.h"
+#include "gameTypes/ShipDirection.h"
+#include <boost/container_hash/hash.hpp>
+#include <algorithm>
+
+namespace {
+constexpr unsigned noDistance = 0xFFFFFFFF;
+}
+
+size_t HarborRouteTable::KeyHasher::operator()(const Key& key) const
+{
+    size_t result = 0;
+    boost::hash_combine(result, key.startIdx);
+    boost::hash_combine(result, rttr::enum_cast(key.startDir));
+    boost::hash_combine(result, key.harborId);
+    boost::hash_combine(result, key.seaId);
+    return result;
+}
+
+HarborRouteTable::HarborRouteTable() : numHarbors_(0) {}
+
+void HarborRouteTable::Init(const World& world)
+{
+    Clear();
+    numHarbors_ = world.GetNumHarborPoints() + 1u;
+    distances_.resize(numHarbors_ * numHarbors_, noDistance);
+    maxDistances_.resize(numHarbors_);
+    for(unsigned harborId = 0; harborId < numHarbors_; harborId++)
+        distances_[harborId * numHarbors_ + harborId] = 0;
+
+    for(unsigned harborId = 1; harborId < numHarbors_; harborId++)
+    {
+        // Seas at which any neighbor lies
+        std::vector<unsigned> seaIds;
+        for(const auto dir : helpers::EnumRange<ShipDirection>{})
+        {
+            for(const HarborPos::Neighbor& neighbor : world.GetHarborNeighbors(harborId, dir))
+            {
+                unsigned& distance = distances_[harborId * numHarbors_ + neighbor.id];
+                if(distance == noDistance)
+                    distance = neighbor.distance;
+                for(const auto seaDir : helpers::EnumRange<Direction>{})
+                {
+                    const unsigned seaId = world.GetSeaId(neighbor.id, seaDir);
+                    if(seaId && !helpers::contains(seaIds, seaId))
+                        seaIds.push_back(seaId);
+                }
+            }
+        }
+        for(const unsigned seaId : seaIds)
+        {
+            unsigned maxDistance = 0;
+            for(const auto dir : helpers::EnumRange<ShipDirection>{})
+            {
+                for(const HarborPos::Neighbor& neighbor : world.GetHarborNeighbors(harborId, dir))
+                {
+                    if(world.IsHarborAtSea(neighbor.id, seaId))
+                        maxDistance = std::max(maxDistance, neighbor.distance);
+                }
+            }
+            maxDistances_[harborId].emplace_back(seaId, maxDistance);
+        }
+        // Ships wait at the coastal points, so routes from there are requested over and over
+        const MapPoint harborPt = world.GetHarborPoint(harborId);
+        for(const auto dir : helpers::EnumRange<Direction>{})
+        {
+            if(world.GetSeaId(harborId, dir))
+                routeStarts_.push_back(world.GetIdx(world.GetNeighbour(harborPt, dir)));
+        }
+    }
+    std::sort(routeStarts_.begin(), routeStarts_.end());
+    routeStarts_.erase(std::unique(routeStarts_.begin(), routeStarts_.end()), routeStarts_.end());
+}
+
+void HarborRouteTable::Clear()
+{
+    numHarbors_ = 0;
+    distances_.clear();
+    maxDistances_.clear();
+    routeStarts_.clear();
+    routes_.clear();
+}
+
+void HarborRouteTable::ClearRoutes()
+{
+    routes_.clear();
+}
+
+unsigned HarborRouteTable::GetDistance(unsigned harborId1, unsigned harborId2) const
+{
+    RTTR_Assert(harborId1 < numHarbors_ && harborId2 < numHarbors_);
+    return distances_[harborId1 * numHarbors_ + harborId2];
+}
+
+unsigned HarborRouteTable::GetMaxDistance(unsigned harborId, unsigned seaId) const
+{
+    RTTR_Assert(harborId < numHarbors_);
+    for(const auto& seaAndDistance : maxDistances_[harborId])
+    {
+        if(seaAndDistance.first == seaId)
+            return seaAndDistance.second;
+    }
+    return 0;
+}
+
+bool HarborRouteTable::IsRouteStart(unsigned startIdx) const
+{
+    return std::binary_search(routeStarts_.begin(), routeStarts_.end(), startIdx);
+}
+
+const HarborRouteTable::Route* HarborRouteTable::FindRoute(unsigned startIdx, Direction startDir, unsigned harborId,
+                                                           unsigned seaId) const
+{
+    const auto it = routes_.find(Key{startIdx, startDir, harborId, seaId});
+    return (it == routes_.end()) ? nullptr : &it->second;
+}
+
+const HarborRouteTable::Route& HarborRouteTable::AddRoute(unsigned startIdx, Direction startDir, unsigned harborId,
+                                                          unsigned seaId, Route route)
+{
+    RTTR_Assert(IsRouteStart(startIdx));
+    return routes_[Key{startIdx, startDir, harborId, seaId}] = std::move(route);
+}
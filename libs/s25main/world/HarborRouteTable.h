@@ -0,0 +1,78 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/Direction.h"
+#include "gameTypes/MapCoordinates.h"
+#include <cstddef>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+class World;
+
+/// Distances and ship routes between harbor points.
+/// They only depend on the terrain, so the distances are computed once from the harbor neighbors and the routes when
+/// they are first requested. Ship routes are random: The search starts in a direction depending on the GF.
+/// So routes are stored per start direction which makes them the same as a new search, also after loading a game
+class HarborRouteTable
+{
+public:
+    struct Route
+    {
+        bool found;
+        unsigned length;
+        std::vector<Direction> route;
+    };
+
+    HarborRouteTable();
+
+    /// Compute the distances from the harbor neighbors of the world and drop all routes
+    void Init(const World& world);
+    void Clear();
+    /// Drop all routes, e.g. when the terrain changed
+    void ClearRoutes();
+
+    /// Return the distance between the 2 harbor points or 0xFFFFFFFF if they are not connected
+    unsigned GetDistance(unsigned harborId1, unsigned harborId2) const;
+    /// Return the distance to the farthest harbor at the given sea of the harbor
+    unsigned GetMaxDistance(unsigned harborId, unsigned seaId) const;
+
+    /// Return true if routes from the point can be stored. That are the coastal points of the harbors
+    bool IsRouteStart(unsigned startIdx) const;
+    /// Return the stored route from the start point (map index) to the harbor at the sea for a search starting in the
+    /// given direction or nullptr
+    const Route* FindRoute(unsigned startIdx, Direction startDir, unsigned harborId, unsigned seaId) const;
+    const Route& AddRoute(unsigned startIdx, Direction startDir, unsigned harborId, unsigned seaId, Route route);
+    unsigned GetNumRoutes() const { return static_cast<unsigned>(routes_.size()); }
+
+private:
+    struct Key
+    {
+        unsigned startIdx;
+        Direction startDir;
+        unsigned harborId, seaId;
+
+        bool operator==(const Key& rhs) const
+        {
+            return startIdx == rhs.startIdx && startDir == rhs.startDir && harborId == rhs.harborId
+                   && seaId == rhs.seaId;
+        }
+    };
+    struct KeyHasher
+    {
+        size_t operator()(const Key& key) const;
+    };
+
+    /// Number of harbor ids including the dummy harbor 0
+    unsigned numHarbors_;
+    /// Distances between all harbors, numHarbors_ x numHarbors_
+    std::vector<unsigned> distances_;
+    /// Per harbor: Sea id and distance to the farthest neighbor harbor at that sea
+    std::vector<std::vector<std::pair<unsigned, unsigned>>> maxDistances_;
+    /// Sorted map indices of all coastal points
+    std::vector<unsigned> routeStarts_;
+    std::unordered_map<Key, Route, KeyHasher> routes_;
+};
@@ -119,10 +119,10 @@ void MapLoader::SetMapExplored(World& world)
     RTTR_FOREACH_PT(MapPoint, world.GetSize())
     {
         // For every player
-        for(unsigned i = 0; i < MAX_PLAYERS; ++i)
+        for(unsigned i = 0; i < world.GetNumFoWPlayers(); ++i)
         {
             // If we have FoW here, save it
-            if(world.GetNode(pt).fow[i].visibility == Visibility::FogOfWar)
+            if(world.GetFoWNode(pt, i).visibility == Visibility::FogOfWar)
                 world.SaveFOWNode(pt, i, 0);
         }
     }
@@ -198,8 +198,9 @@ bool MapLoader::InitNodes(const libsiedler2::ArchivItem_Map& map, Exploration ex
         }
 
         // FOW-Zeug initialisieren
-        for(auto& fow : node.fow)
+        for(unsigned i = 0; i < world_.GetNumFoWPlayers(); ++i)
         {
+            FoWNode& fow = world_.GetFoWNodeInt(pt, i);
             fow = FoWNode();
             fow.visibility = fowVisibility;
         }
@@ -644,6 +645,7 @@ void MapLoader::CalcHarborPosNeighbors(World& world)
             }
         }
     }
+    world.harborRoutes.Init(world);
 }
 
 /// Vermisst ein neues Weltmeer von einem Punkt aus, indem es alle mit diesem Punkt verbundenen
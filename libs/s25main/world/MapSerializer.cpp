@@ -23,9 +23,12 @@ void MapSerializer::Serialize(const GameWorldBase& world, SerializedGameData& sg
 
     // Alle Weltpunkte serialisieren
     const unsigned numPlayers = world.GetNumPlayers();
+    RTTR_Assert(numPlayers <= world.numFoWPlayers);
+    const FoWNode* fow = world.fowNodes.data();
     for(const auto& node : world.nodes)
     {
-        node.Serialize(sgd, numPlayers, world.GetDescription());
+        node.Serialize(sgd, numPlayers, fow, world.GetDescription());
+        fow += world.numFoWPlayers;
     }
 
     // Katapultsteine serialisieren
@@ -74,6 +77,7 @@ void MapSerializer::Serialize(const GameWorldBase& world, SerializedGameData& sg
         sgd.PushUnsignedInt(luaSaveState.GetLength());
         sgd.PushRawData(luaSaveState.GetData(), luaSaveState.GetLength());
         sgd.PushUnsignedInt(0xC001C0DE); // End Lua identifier
+        world.GetLua().SerializeBatchedEvents(sgd);
     }
 }
 
@@ -122,9 +126,12 @@ void MapSerializer::Deserialize(GameWorldBase& world, SerializedGameData& sgd, G
     // Alle Weltpunkte
     MapPoint curPos(0, 0);
     const unsigned numPlayers = world.GetNumPlayers();
+    RTTR_Assert(numPlayers <= world.numFoWPlayers);
+    FoWNode* fow = world.fowNodes.data();
     for(auto& node : world.nodes)
     {
-        node.Deserialize(sgd, numPlayers, world.GetDescription(), landscapeTerrains);
+        node.Deserialize(sgd, numPlayers, fow, world.GetDescription(), landscapeTerrains);
+        fow += world.numFoWPlayers;
         if(node.harborId)
         {
             HarborPos p(curPos);
@@ -171,6 +178,7 @@ void MapSerializer::Deserialize(GameWorldBase& world, SerializedGameData& sgd, G
             }
         }
     }
+    world.harborRoutes.Init(world);
 
     sgd.PopObjectContainer(world.harbor_building_sites_from_sea, GO_Type::Buildingsite);
 
@@ -201,6 +209,8 @@ void MapSerializer::Deserialize(GameWorldBase& world, SerializedGameData& sgd, G
         {
             throw SerializedGameData::Error(std::string(_("Failed to load lua state!")) + _("Error: ") + e.what());
         }
+        if(sgd.GetGameDataVersion() >= 11)
+            lua->DeserializeBatchedEvents(sgd);
         game.SetLua(std::move(lua));
     }
     world.CreateTradeGraphs();
@@ -0,0 +1,94 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "world/MilitaryInfluence.h"
+#include "GamePlayer.h"
+#include "buildings/noBaseBuilding.h"
+#include "buildings/nobMilitary.h"
+#include "world/GameWorldBase.h"
+#include "world/TerritoryRegion.h"
+#include <algorithm>
+
+void MilitaryInfluence::Init(const MapExtent& mapSize)
+{
+    nodes_.assign(prodOfComponents(mapSize), Node());
+}
+
+void MilitaryInfluence::Clear()
+{
+    std::fill(nodes_.begin(), nodes_.end(), Node());
+}
+
+bool MilitaryInfluence::HoldsTerritory(const noBaseBuilding& building)
+{
+    if(building.GetMilitaryRadius() == 0u)
+        return false;
+    // Military buildings only hold territory once occupied
+    return building.GetGOT() != GO_Type::NobMilitary || !static_cast<const nobMilitary&>(building).IsNewBuilt();
+}
+
+bool MilitaryInfluence::HasPriority(const noBaseBuilding& lhs, const noBaseBuilding& rhs)
+{
+    const bool lhsIsSite = lhs.GetGOT() == GO_Type::Buildingsite;
+    const bool rhsIsSite = rhs.GetGOT() == GO_Type::Buildingsite;
+    if(lhsIsSite != rhsIsSite)
+        return rhsIsSite;
+    // Same order as sortedMilitaryBlds resp. the list of harbor building sites from sea
+    return lhsIsSite ? lhs.GetObjId() < rhs.GetObjId() : lhs.GetObjId() > rhs.GetObjId();
+}
+
+void MilitaryInfluence::Claim(unsigned idx, const noBaseBuilding& building, unsigned distance)
+{
+    Node& node = nodes_[idx];
+    if(!node.building || distance < node.distance
+       || (distance == node.distance && node.building != &building && HasPriority(building, *node.building)))
+    {
+        node.building = &building;
+        node.distance = static_cast<uint16_t>(distance);
+    }
+}
+
+void MilitaryInfluence::Add(const GameWorldBase& world, const noBaseBuilding& building)
+{
+    if(!HoldsTerritory(building))
+        return;
+    const MapPoint bldPos = building.GetPos();
+    // No need to check the restricted area here. This point is always our territory
+    Claim(world.GetIdx(bldPos), building, 0);
+
+    const std::vector<MapPoint>& allowedArea = world.GetPlayer(building.GetPlayer()).GetRestrictedArea();
+    world.CheckPointsInRadius(
+      bldPos, building.GetMilitaryRadius(),
+      [&](const MapPoint pt, unsigned distance) {
+          if(allowedArea.empty() || TerritoryRegion::IsPointValid(world.GetSize(), allowedArea, pt))
+              Claim(world.GetIdx(pt), building, distance);
+          return false;
+      },
+      false);
+}
+
+bool MilitaryInfluence::Remove(const GameWorldBase& world, const noBaseBuilding& building)
+{
+    bool released = false;
+    world.CheckPointsInRadius(
+      building.GetPos(), building.GetMilitaryRadius(),
+      [&](const MapPoint pt, unsigned) {
+          Node& node = nodes_[world.GetIdx(pt)];
+          if(node.building == &building)
+          {
+              node = Node();
+              released = true;
+          }
+          return false;
+      },
+      true);
+    return released;
+}
+
+uint8_t MilitaryInfluence::GetOwner(unsigned idx) const
+{
+    const noBaseBuilding* building = nodes_[idx].building;
+    // The owner is not stored, so captured buildings hold their nodes for the new owner right away
+    return building ? building->GetPlayer() + 1 : 0;
+}
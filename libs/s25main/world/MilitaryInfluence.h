@@ -0,0 +1,51 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/MapCoordinates.h"
+#include <cstdint>
+#include <vector>
+
+class GameWorldBase;
+class noBaseBuilding;
+
+/// Building which holds the territory of each node before the territory rules (allied push, cosmetics) are applied.
+/// That is the closest occupied military building, HQ, harbor or harbor building site from sea.
+/// Ties are resolved like TerritoryRegion does: Military buildings with higher object ids first, then harbor building
+/// sites in the order they were founded.
+/// It is updated when a single building is added or removed, so the territory around a changed building can be read
+/// without evaluating all buildings nearby
+class MilitaryInfluence
+{
+public:
+    void Init(const MapExtent& mapSize);
+    void Clear();
+
+    /// Return true if the building holds territory on its own
+    static bool HoldsTerritory(const noBaseBuilding& building);
+
+    /// Claim the nodes in the radius of the building which are closer to it than to their current building
+    void Add(const GameWorldBase& world, const noBaseBuilding& building);
+    /// Release the nodes held by the building. Return true if there were any.
+    /// Those nodes need to be claimed again by all other buildings that might reach them
+    bool Remove(const GameWorldBase& world, const noBaseBuilding& building);
+
+    /// Return the owner (player index + 1, 0 = no owner) of the node according to the closest building
+    uint8_t GetOwner(unsigned idx) const;
+
+private:
+    struct Node
+    {
+        const noBaseBuilding* building = nullptr;
+        /// Distance to the building
+        uint16_t distance = 0;
+    };
+
+    /// Return true if the claim of lhs wins over the one of rhs at the same distance
+    static bool HasPriority(const noBaseBuilding& lhs, const noBaseBuilding& rhs);
+    void Claim(unsigned idx, const noBaseBuilding& building, unsigned distance);
+
+    std::vector<Node> nodes_;
+};
@@ -0,0 +1,69 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "world/RadiusSumMap.h"
+#include <cstdlib>
+
+void RadiusSumMap::Resize(const MapExtent& newSize)
+{
+    MapBase::Resize(newSize);
+    values_.assign(prodOfComponents(newSize), 0);
+    rowTrees_.assign(values_.size(), 0);
+    rowSums_.assign(newSize.y, 0);
+}
+
+void RadiusSumMap::Set(const MapPoint pt, const int value)
+{
+    const unsigned idx = GetIdx(pt);
+    const int diff = value - values_[idx];
+    if(!diff)
+        return;
+    values_[idx] = value;
+    rowSums_[pt.y] += diff;
+    int* tree = &rowTrees_[pt.y * GetWidth()];
+    for(unsigned i = pt.x; i < GetWidth(); i |= i + 1)
+        tree[i] += diff;
+}
+
+int RadiusSumMap::GetRowPrefixSum(const MapCoord y, unsigned count) const
+{
+    const int* tree = &rowTrees_[y * GetWidth()];
+    int result = 0;
+    for(; count > 0; count &= count - 1)
+        result += tree[count - 1];
+    return result;
+}
+
+int RadiusSumMap::GetRowSum(const MapCoord y, int x, unsigned count) const
+{
+    const int width = GetWidth();
+    // Segments covering the whole row (possible on tiny maps) count it multiple times
+    int result = static_cast<int>(count / width) * rowSums_[y];
+    count %= width;
+    x %= width;
+    if(x < 0)
+        x += width;
+    const unsigned end = x + count;
+    if(end <= static_cast<unsigned>(width))
+        return result + GetRowPrefixSum(y, end) - GetRowPrefixSum(y, x);
+    // Wraps around: [x, width) + [0, end - width)
+    return result + rowSums_[y] - GetRowPrefixSum(y, x) + GetRowPrefixSum(y, end - width);
+}
+
+int RadiusSumMap::GetSumInRadius(const MapPoint pt, const unsigned radius) const
+{
+    const int height = GetHeight();
+    const bool isEvenRow = (pt.y & 1) == 0;
+    int result = 0;
+    for(int dy = -static_cast<int>(radius); dy <= static_cast<int>(radius); dy++)
+    {
+        // The leftmost point is reached by going |dy| steps NW/SW and then W. Diagonal steps from even rows go left
+        const unsigned numDiagSteps = static_cast<unsigned>(std::abs(dy));
+        const int left = pt.x - static_cast<int>(radius - numDiagSteps)
+                         - static_cast<int>(isEvenRow ? (numDiagSteps + 1) / 2 : numDiagSteps / 2);
+        const int y = ((pt.y + dy) % height + height) % height;
+        result += GetRowSum(static_cast<MapCoord>(y), left, 2 * radius + 1 - numDiagSteps);
+    }
+    return result;
+}
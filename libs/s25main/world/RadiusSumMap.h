@@ -0,0 +1,37 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "world/MapBase.h"
+#include "gameTypes/MapCoordinates.h"
+#include <vector>
+
+/// Map of values per node which can be summed over all points in a radius.
+/// The points in a radius form one contiguous segment per row, so each row is stored as a Fenwick tree:
+/// Changing a value and summing a segment take O(log width), summing a radius r takes O(r log width)
+class RadiusSumMap final : public MapBase
+{
+public:
+    /// Resize the map and set all values to 0
+    void Resize(const MapExtent& newSize) override;
+
+    int Get(MapPoint pt) const { return values_[GetIdx(pt)]; }
+    void Set(MapPoint pt, int value);
+    /// Sum of the values of all points with a distance of at most radius to pt (including pt)
+    /// Same as summing over GetPointsInRadiusWithCenter
+    int GetSumInRadius(MapPoint pt, unsigned radius) const;
+
+private:
+    /// Sum of count values of row y starting at x (wrapping around)
+    int GetRowSum(MapCoord y, int x, unsigned count) const;
+    /// Sum of the first count values of row y
+    int GetRowPrefixSum(MapCoord y, unsigned count) const;
+
+    std::vector<int> values_;
+    /// Fenwick trees of the rows (0-based)
+    std::vector<int> rowTrees_;
+    /// Sums of all values per row
+    std::vector<int> rowSums_;
+};
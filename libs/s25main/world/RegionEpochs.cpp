@@ -0,0 +1,44 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "world/RegionEpochs.h"
+#include "RTTR_Assert.h"
+
+constexpr unsigned RegionEpochs::regionSize;
+
+RegionEpochs::RegionEpochs() : size_(MapExtent::all(0)), mapSize_(MapExtent::all(0)), curEpoch(0) {}
+
+void RegionEpochs::Init(const MapExtent& mapSize)
+{
+    RTTR_Assert(mapSize.x > 0 && mapSize.y > 0); // No empty map
+    mapSize_ = mapSize;
+    // Calculate size (rounding up)
+    size_ = MapExtent((mapSize + MapExtent::all(regionSize - 1)) / regionSize);
+    epochs.assign(size_.x * size_.y, 0);
+    curEpoch = 0;
+}
+
+void RegionEpochs::Clear()
+{
+    epochs.clear();
+    size_ = mapSize_ = MapExtent::all(0);
+    curEpoch = 0;
+}
+
+void RegionEpochs::MarkChanged(const MapPoint pt, const unsigned radius)
+{
+    if(epochs.empty())
+        return;
+    ++curEpoch;
+    // All points within the radius are inside the bounding square of it (with wrap around)
+    for(unsigned dy = 0; dy <= 2 * radius; dy++)
+    {
+        const MapCoord y = static_cast<MapCoord>((pt.y + mapSize_.y * radius + dy - radius) % mapSize_.y);
+        for(unsigned dx = 0; dx <= 2 * radius; dx++)
+        {
+            const MapCoord x = static_cast<MapCoord>((pt.x + mapSize_.x * radius + dx - radius) % mapSize_.x);
+            epochs[GetRegionIdx(MapPoint(x, y))] = curEpoch;
+        }
+    }
+}
@@ -0,0 +1,41 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "gameTypes/MapCoordinates.h"
+#include <vector>
+
+/// Tracks changes of the map (objects, roads, terrain) in square regions:
+/// Each change increases a global counter (epoch) and stores it for the affected regions.
+/// So users can check if anything in a region changed since they looked at it by comparing the epochs
+class RegionEpochs
+{
+    /// Epoch of the last change per region
+    std::vector<unsigned> epochs;
+    /// Size in regions
+    MapExtent size_;
+    MapExtent mapSize_;
+    unsigned curEpoch;
+
+public:
+    /// Width and height of a region in points
+    static constexpr unsigned regionSize = 16;
+
+    RegionEpochs();
+    void Init(const MapExtent& mapSize);
+    void Clear();
+
+    unsigned GetNumRegions() const { return epochs.size(); }
+    unsigned GetRegionIdx(const MapPoint pt) const
+    {
+        return (pt.y / regionSize) * size_.x + pt.x / regionSize;
+    }
+    /// Return the epoch of the last change in the region (0 = never changed)
+    unsigned GetEpoch(unsigned regionIdx) const { return epochs[regionIdx]; }
+    /// Return the epoch of the last change anywhere on the map
+    unsigned GetCurrentEpoch() const { return curEpoch; }
+    /// Mark all regions containing a point within the radius around pt as changed
+    void MarkChanged(MapPoint pt, unsigned radius);
+};
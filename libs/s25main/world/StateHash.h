@@ -0,0 +1,78 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "enum_cast.hpp"
+#include "gameTypes/GoodTypes.h"
+#include "gameTypes/JobTypes.h"
+#include "gameTypes/MapTypes.h"
+#include <cstdint>
+
+/// Hash of the game state maintained incrementally:
+/// Every entity (owner of a node, object, road, figure position, inventory count) contributes a hash which is XORed
+/// into the total when the entity is added and again when it is removed.
+/// So the hash only depends on the current state and each change costs O(1)
+class StateHash
+{
+    enum class EntityType : uint8_t
+    {
+        Owner,
+        Object,
+        Road,
+        Figure,
+        Goods,
+        People
+    };
+
+    unsigned value_;
+
+    static uint32_t mix(uint32_t h)
+    {
+        // Finalizer of MurmurHash3
+        h ^= h >> 16;
+        h *= 0x85ebca6bu;
+        h ^= h >> 13;
+        h *= 0xc2b2ae35u;
+        h ^= h >> 16;
+        return h;
+    }
+    void Toggle(EntityType type, unsigned a, unsigned b, unsigned c)
+    {
+        uint32_t h = mix(rttr::enum_cast(type) + 1u);
+        h = mix(h ^ a);
+        h = mix(h ^ b);
+        value_ ^= mix(h ^ c);
+    }
+
+public:
+    StateHash() : value_(0) {}
+
+    unsigned Get() const { return value_; }
+    void Reset() { value_ = 0; }
+
+    // Values which are "nothing" don't contribute to the hash, so only the non-empty parts of the state matter
+    void ToggleOwner(unsigned ptIdx, unsigned char owner)
+    {
+        if(owner)
+            Toggle(EntityType::Owner, ptIdx, owner, 0);
+    }
+    void ToggleObject(unsigned ptIdx, unsigned objId) { Toggle(EntityType::Object, ptIdx, objId, 0); }
+    void ToggleRoad(unsigned ptIdx, RoadDir dir, PointRoad type)
+    {
+        if(type != PointRoad::None)
+            Toggle(EntityType::Road, ptIdx, rttr::enum_cast(dir), rttr::enum_cast(type));
+    }
+    void ToggleFigure(unsigned ptIdx, unsigned objId) { Toggle(EntityType::Figure, ptIdx, objId, 0); }
+    void ToggleInventory(unsigned player, GoodType good, unsigned count)
+    {
+        if(count)
+            Toggle(EntityType::Goods, player, rttr::enum_cast(good), count);
+    }
+    void ToggleInventory(unsigned player, Job job, unsigned count)
+    {
+        if(count)
+            Toggle(EntityType::People, player, rttr::enum_cast(job), count);
+    }
+};
@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "world/World.h"
+#include "figures/noFigure.h"
+#include "nodeObjs/noFighting.h"
 #include "nodeObjs/noFlag.h"
 #include "nodeObjs/noNothing.h"
 #if RTTR_ENABLE_ASSERTS
@@ -14,12 +16,17 @@
 #include "helpers/containerUtils.h"
 #include "helpers/pointerContainerUtils.h"
 #include "gameTypes/ShipDirection.h"
+#include "gameData/MilitaryConsts.h"
 #include "gameData/TerrainDesc.h"
+#include <algorithm>
 #include <memory>
 #include <set>
 #include <stdexcept>
 
-World::World() : noNodeObj(nullptr) {}
+World::World(unsigned numFoWPlayers) : numFoWPlayers(numFoWPlayers), noNodeObj(nullptr), aisRunning(false)
+{
+    RTTR_Assert(numFoWPlayers <= MAX_PLAYERS);
+}
 
 World::~World()
 {
@@ -80,11 +87,19 @@ void World::Resize(const MapExtent& newSize)
 {
     MapBase::Resize(newSize);
     nodes.clear();
+    fowNodes.clear();
+    viewerCounts.clear();
     militarySquares.Clear();
+    regionEpochs.Clear();
+    harborRoutes.Clear();
+    stateHash.Reset();
     if(GetSize().x > 0)
     {
         nodes.resize(prodOfComponents(GetSize()));
+        fowNodes.resize(nodes.size() * numFoWPlayers);
+        viewerCounts.resize(fowNodes.size());
         militarySquares.Init(GetSize());
+        regionEpochs.Init(GetSize());
     }
 }
 
@@ -101,12 +116,47 @@ noBase& World::AddFigureImpl(const MapPoint pt, std::unique_ptr<noBase> fig)
 
     noBase& result = *fig;
     figures.push_back(std::move(fig));
+    stateHash.ToggleFigure(GetIdx(pt), result.GetObjId());
+    ChangeFigureViewers(pt, result, true);
     return result;
 }
 
 noBase* World::RemoveFigureImpl(const MapPoint pt, noBase& fig)
 {
-    return helpers::extractPtr(GetNodeInt(pt).figures, &fig).release();
+    noBase* result = helpers::extractPtr(GetNodeInt(pt).figures, &fig).release();
+    if(result)
+    {
+        stateHash.ToggleFigure(GetIdx(pt), result->GetObjId());
+        ChangeFigureViewers(pt, *result, false);
+    }
+    return result;
+}
+
+void World::ChangeFigureViewers(const MapPoint pt, const noBase& fig, bool add)
+{
+    const auto change = [this, pt, add](unsigned radius, unsigned char player) {
+        if(add)
+            AddViewer(pt, radius, player);
+        else
+            RemoveViewer(pt, radius, player);
+    };
+    switch(fig.GetGOT())
+    {
+        case GO_Type::NofScoutFree: change(VISUALRANGE_SCOUT, static_cast<const noFigure&>(fig).GetPlayer()); break;
+        case GO_Type::NofAttacker:
+        case GO_Type::NofAggressivedefender:
+            change(VISUALRANGE_SOLDIER, static_cast<const noFigure&>(fig).GetPlayer());
+            break;
+        case GO_Type::Fighting:
+            // The players of a fight don't change while it is on the node
+            for(unsigned char player = 0; player < numFoWPlayers; ++player)
+            {
+                if(static_cast<const noFighting&>(fig).IsSoldierOfPlayer(player))
+                    change(VISUALRANGE_SOLDIER, player);
+            }
+            break;
+        default: break;
+    }
 }
 
 noBase* World::GetNO(const MapPoint pt)
@@ -127,11 +177,19 @@ const noBase* World::GetNO(const MapPoint pt) const
 
 void World::SetNO(const MapPoint pt, noBase* obj, const bool replace /* = false*/)
 {
+    RTTR_Assert_Msg(!aisRunning, "World must not be changed while the AIs run");
     RTTR_Assert(replace || obj == nullptr || GetNode(pt).obj == nullptr);
 #if RTTR_ENABLE_ASSERTS
     RTTR_Assert(!dynamic_cast<noMovable*>(obj)); // It should be a static, non-movable object
 #endif
-    GetNodeInt(pt).obj = obj;
+    noBase*& curObj = GetNodeInt(pt).obj;
+    if(curObj)
+        stateHash.ToggleObject(GetIdx(pt), curObj->GetObjId());
+    curObj = obj;
+    if(obj)
+        stateHash.ToggleObject(GetIdx(pt), obj->GetObjId());
+    // Affects paths to and from the neighbours
+    regionEpochs.MarkChanged(pt, 1);
 }
 
 void World::DestroyNO(const MapPoint pt, const bool checkExists /* = true*/)
@@ -142,6 +200,8 @@ void World::DestroyNO(const MapPoint pt, const bool checkExists /* = true*/)
         // Destroy may remove the NO already from the map or replace it (e.g. building -> fire)
         // So remove from map, then destroy and free
         GetNodeInt(pt).obj = nullptr;
+        stateHash.ToggleObject(GetIdx(pt), obj->GetObjId());
+        regionEpochs.MarkChanged(pt, 1);
         obj->Destroy();
         deletePtr(obj);
     } else
@@ -173,7 +233,7 @@ void World::SetReserved(const MapPoint pt, const bool reserved)
 
 void World::SetVisibility(const MapPoint pt, unsigned char player, Visibility vis, unsigned fowTime)
 {
-    FoWNode& node = GetNodeInt(pt).fow[player];
+    FoWNode& node = GetFoWNodeInt(pt, player);
     Visibility oldVis = node.visibility;
     if(oldVis == vis)
         return;
@@ -186,6 +246,37 @@ void World::SetVisibility(const MapPoint pt, unsigned char player, Visibility vi
     VisibilityChanged(pt, player, oldVis, vis);
 }
 
+void World::AddViewer(const MapPoint pt, unsigned radius, unsigned char player)
+{
+    RTTR_Assert(player < numFoWPlayers);
+    CheckPointsInRadius(
+      pt, radius,
+      [this, player](const MapPoint curPt, unsigned) {
+          ++viewerCounts[GetIdx(curPt) * numFoWPlayers + player];
+          return false;
+      },
+      true);
+}
+
+void World::RemoveViewer(const MapPoint pt, unsigned radius, unsigned char player)
+{
+    RTTR_Assert(player < numFoWPlayers);
+    CheckPointsInRadius(
+      pt, radius,
+      [this, player](const MapPoint curPt, unsigned) {
+          uint16_t& count = viewerCounts[GetIdx(curPt) * numFoWPlayers + player];
+          RTTR_Assert(count > 0u);
+          --count;
+          return false;
+      },
+      true);
+}
+
+void World::ClearViewers()
+{
+    std::fill(viewerCounts.begin(), viewerCounts.end(), 0);
+}
+
 void World::ChangeAltitude(const MapPoint pt, const unsigned char altitude)
 {
     GetNodeInt(pt).altitude = altitude;
@@ -312,7 +403,7 @@ helpers::EnumArray<DescIdx<TerrainDesc>, Direction> World::GetTerrainsAround(Map
 
 void World::SaveFOWNode(const MapPoint pt, const unsigned player, unsigned curTime)
 {
-    FoWNode& fow = GetNodeInt(pt).fow[player];
+    FoWNode& fow = GetFoWNodeInt(pt, player);
     fow.last_update_time = curTime;
 
     // FOW-Objekt erzeugen
@@ -386,7 +477,7 @@ PointRoad World::GetPointRoad(MapPoint pt, Direction dir) const
 PointRoad World::GetPointFOWRoad(MapPoint pt, Direction dir, const unsigned char viewing_player) const
 {
     const RoadDir rDir = toRoadDir(pt, dir);
-    return GetNode(pt).fow[viewing_player].roads[rDir];
+    return GetFoWNode(pt, viewing_player).roads[rDir];
 }
 
 void World::AddCatapultStone(CatapultStone* cs)
@@ -418,18 +509,7 @@ const std::vector<HarborPos::Neighbor>& World::GetHarborNeighbors(const unsigned
 /// Berechnet die Entfernung zwischen 2 Hafenpunkten
 unsigned World::CalcHarborDistance(unsigned habor_id1, unsigned harborId2) const
 {
-    if(habor_id1 == harborId2) // special case: distance to self
-        return 0;
-    for(const auto dir : helpers::EnumRange<ShipDirection>{})
-    {
-        for(const HarborPos::Neighbor& n : harbor_pos[habor_id1].neighbors[dir])
-        {
-            if(n.id == harborId2)
-                return n.distance;
-        }
-    }
-
-    return 0xffffffff;
+    return harborRoutes.GetDistance(habor_id1, harborId2);
 }
 
 unsigned short World::GetSeaFromCoastalPoint(const MapPoint pt) const
@@ -457,9 +537,22 @@ unsigned short World::GetSeaFromCoastalPoint(const MapPoint pt) const
     return 0;
 }
 
+void World::SetOwner(const MapPoint pt, unsigned char newOwner)
+{
+    unsigned char& owner = GetNodeInt(pt).owner;
+    stateHash.ToggleOwner(GetIdx(pt), owner);
+    owner = newOwner;
+    stateHash.ToggleOwner(GetIdx(pt), owner);
+}
+
 void World::SetRoad(const MapPoint pt, RoadDir roadDir, PointRoad type)
 {
-    GetNodeInt(pt).roads[roadDir] = type;
+    RTTR_Assert_Msg(!aisRunning, "World must not be changed while the AIs run");
+    PointRoad& road = GetNodeInt(pt).roads[roadDir];
+    stateHash.ToggleRoad(GetIdx(pt), roadDir, road);
+    road = type;
+    stateHash.ToggleRoad(GetIdx(pt), roadDir, road);
+    regionEpochs.MarkChanged(pt, 1);
 }
 
 bool World::SetBQ(const MapPoint pt, BuildingQuality bq)
@@ -487,12 +580,9 @@ void World::RecalcShadow(const MapPoint pt)
 
 void World::MakeWholeMapVisibleForAllPlayers()
 {
-    for(auto& mapNode : nodes)
+    for(auto& fowNode : fowNodes)
     {
-        for(auto& fowNode : mapNode.fow)
-        {
-            fowNode.visibility = Visibility::Visible;
-            fowNode.object.reset();
-        }
+        fowNode.visibility = Visibility::Visible;
+        fowNode.object.reset();
     }
 }
@@ -6,8 +6,11 @@
 
 #include "enum_cast.hpp"
 #include "helpers/PtrSpan.h"
+#include "world/HarborRouteTable.h"
 #include "world/MapBase.h"
 #include "world/MilitarySquares.h"
+#include "world/RegionEpochs.h"
+#include "world/StateHash.h"
 #include "gameTypes/Direction.h"
 #include "gameTypes/GO_Type.h"
 #include "gameTypes/HarborPos.h"
@@ -15,7 +18,9 @@
 #include "gameTypes/MapNode.h"
 #include "gameTypes/MapTypes.h"
 #include "gameData/DescIdx.h"
+#include "gameData/MaxPlayers.h"
 #include "gameData/WorldDescription.h"
+#include <cstdint>
 #include <list>
 #include <memory>
 #include <vector>
@@ -52,6 +57,13 @@ class World : public MapBase
 
     /// Eigenschaften von einem Punkt auf der Map
     std::vector<MapNode> nodes;
+    /// How the players see the points. Stored apart from the nodes as it is big but rarely needed.
+    /// Contains numFoWPlayers consecutive entries per node
+    std::vector<FoWNode> fowNodes;
+    unsigned numFoWPlayers;
+    /// Number of vision sources (military buildings, lookout towers, scouts, soldiers) of each player which see the
+    /// node. Same layout as fowNodes
+    std::vector<uint16_t> viewerCounts;
 
     std::vector<Sea> seas;
 
@@ -61,6 +73,8 @@ class World : public MapBase
     WorldDescription description_;
 
     std::unique_ptr<noBase> noNodeObj;
+    /// True while the AIs run concurrently on the world, see AIRunScope
+    bool aisRunning;
     void Resize(const MapExtent& newSize) override final;
     noBase& AddFigureImpl(MapPoint pt, std::unique_ptr<noBase> fig);
     /// Implementation of RemoveFigure. Returned pointer must be wrapped in an owning pointer
@@ -69,13 +83,37 @@ class World : public MapBase
 protected:
     /// harbor building sites created by ships
     std::list<noBuildingSite*> harbor_building_sites_from_sea;
+    /// Changes of objects, roads and terrain
+    RegionEpochs regionEpochs;
+    /// Distances and ship routes between the harbor points
+    HarborRouteTable harborRoutes;
+    /// Hash of owners, objects, roads, figures and inventories
+    StateHash stateHash;
 
 public:
     /// Currently flying catapult stones
     std::list<CatapultStone*> catapult_stones;
     MilitarySquares militarySquares;
 
-    World();
+    /// While an instance exists the AIs run concurrently on the world, so it must not be changed.
+    /// Checked by the functions changing nodes (in debug builds)
+    class AIRunScope
+    {
+        World& world_;
+
+    public:
+        explicit AIRunScope(World& world) : world_(world)
+        {
+            RTTR_Assert(!world_.aisRunning);
+            world_.aisRunning = true;
+        }
+        AIRunScope(const AIRunScope&) = delete;
+        AIRunScope& operator=(const AIRunScope&) = delete;
+        ~AIRunScope() { world_.aisRunning = false; }
+    };
+
+    /// Create a world storing the FoW state for the given number of players
+    explicit World(unsigned numFoWPlayers = MAX_PLAYERS);
     virtual ~World();
 
     /// Initialize the world
@@ -93,6 +131,19 @@ public:
     const MapNode& GetNode(MapPoint pt) const;
     /// Return the neighboring node
     const MapNode& GetNeighbourNode(MapPoint pt, Direction dir) const;
+    /// Return how the player sees the point
+    const FoWNode& GetFoWNode(MapPoint pt, unsigned player) const;
+    /// Return the number of players for which the FoW state is stored
+    unsigned GetNumFoWPlayers() const { return numFoWPlayers; }
+    /// Return the number of vision sources of the player which currently see the point
+    unsigned GetNumViewers(MapPoint pt, unsigned player) const;
+    /// Return when objects, roads or terrain were changed in which part of the map
+    const RegionEpochs& GetRegionEpochs() const { return regionEpochs; }
+    /// Return whether the AIs currently run on the world, i.e. it must not be changed
+    bool AreAIsRunning() const { return aisRunning; }
+    /// Return the hash of the game state which is updated on every change
+    const StateHash& GetStateHash() const { return stateHash; }
+    StateHash& GetStateHash() { return stateHash; }
 
     // Add a figure to a node (taking ownership) and returns a reference to it
     template<typename T>
@@ -121,11 +172,18 @@ public:
     GO_Type GetGOT(MapPoint pt) const;
     void ReduceResource(MapPoint pt);
     void SetResource(const MapPoint pt, Resource newResource) { GetNodeInt(pt).resources = newResource; }
-    void SetOwner(const MapPoint pt, unsigned char newOwner) { GetNodeInt(pt).owner = newOwner; }
+    void SetOwner(MapPoint pt, unsigned char newOwner);
     void SetReserved(MapPoint pt, bool reserved);
     /// Sets the visibility and fires a Visibility Changed event if different
     /// fowTime is only used if visibility gets changed to FoW
     void SetVisibility(MapPoint pt, unsigned char player, Visibility vis, unsigned fowTime = 0);
+    /// Register a vision source of the player seeing all points within the radius.
+    /// Figures on the nodes are registered automatically
+    void AddViewer(MapPoint pt, unsigned radius, unsigned char player);
+    /// Unregister a vision source added by AddViewer. Does not change the visibilities
+    void RemoveViewer(MapPoint pt, unsigned radius, unsigned char player);
+    /// Forget all vision sources, e.g. before registering them again after loading
+    void ClearViewers();
 
     void ChangeAltitude(MapPoint pt, unsigned char altitude);
 
@@ -235,6 +293,9 @@ protected:
     /// Internal method for access to nodes with write access
     MapNode& GetNodeInt(MapPoint pt);
     MapNode& GetNeighbourNodeInt(MapPoint pt, Direction dir);
+    FoWNode& GetFoWNodeInt(MapPoint pt, unsigned player);
+    /// Add (or remove) the vision of a figure on the node if it is a scout, an attacking soldier or a fight
+    void ChangeFigureViewers(MapPoint pt, const noBase& fig, bool add);
 
     /// Notify derived classes of changed altitude
     virtual void AltitudeChanged(MapPoint pt) = 0;
@@ -264,6 +325,24 @@ inline MapNode& World::GetNodeInt(const MapPoint pt)
     return nodes[GetIdx(pt)];
 }
 
+inline const FoWNode& World::GetFoWNode(const MapPoint pt, unsigned player) const
+{
+    RTTR_Assert(player < numFoWPlayers);
+    return fowNodes[GetIdx(pt) * numFoWPlayers + player];
+}
+
+inline FoWNode& World::GetFoWNodeInt(const MapPoint pt, unsigned player)
+{
+    RTTR_Assert(player < numFoWPlayers);
+    return fowNodes[GetIdx(pt) * numFoWPlayers + player];
+}
+
+inline unsigned World::GetNumViewers(const MapPoint pt, unsigned player) const
+{
+    RTTR_Assert(player < numFoWPlayers);
+    return viewerCounts[GetIdx(pt) * numFoWPlayers + player];
+}
+
 inline const MapNode& World::GetNeighbourNode(const MapPoint pt, Direction dir) const
 {
     return GetNode(GetNeighbour(pt, dir));
@@ -0,0 +1,63 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/LRUCache.h"
+#include <boost/test/unit_test.hpp>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(LRUCacheTests)
+
+BOOST_AUTO_TEST_CASE(InsertAndFind)
+{
+    helpers::LRUCache<int, std::string> cache(3);
+    BOOST_TEST(cache.size() == 0u);
+    BOOST_TEST(cache.max_size() == 3u);
+    BOOST_TEST(!cache.find(1));
+
+    cache.insert(1, "1");
+    cache.insert(2, "2");
+    BOOST_TEST(cache.size() == 2u);
+    BOOST_TEST_REQUIRE(cache.find(1));
+    BOOST_TEST(*cache.find(1) == "1");
+    BOOST_TEST_REQUIRE(cache.find(2));
+    BOOST_TEST(*cache.find(2) == "2");
+    // Replace existing
+    BOOST_TEST(cache.insert(1, "one") == "one");
+    BOOST_TEST(cache.size() == 2u);
+    BOOST_TEST(*cache.find(1) == "one");
+
+    cache.erase(1);
+    BOOST_TEST(cache.size() == 1u);
+    BOOST_TEST(!cache.find(1));
+    // Erasing non-existing entries is fine
+    cache.erase(1);
+    BOOST_TEST(cache.size() == 1u);
+
+    cache.clear();
+    BOOST_TEST(cache.size() == 0u);
+    BOOST_TEST(!cache.find(2));
+}
+
+BOOST_AUTO_TEST_CASE(ReplacesLeastRecentlyUsed)
+{
+    helpers::LRUCache<int, int> cache(3);
+    cache.insert(1, 1);
+    cache.insert(2, 2);
+    cache.insert(3, 3);
+    // Use 1 so 2 is the oldest
+    BOOST_TEST(cache.find(1));
+    cache.insert(4, 4);
+    BOOST_TEST(cache.size() == 3u);
+    BOOST_TEST(!cache.find(2));
+    BOOST_TEST(cache.find(1));
+    BOOST_TEST(cache.find(3));
+    BOOST_TEST(cache.find(4));
+    // Replacing a value also counts as use: Now 1 is the oldest
+    cache.insert(3, 30);
+    cache.insert(5, 5);
+    BOOST_TEST(!cache.find(1));
+    BOOST_TEST(*cache.find(3) == 30);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
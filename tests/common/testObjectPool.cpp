@@ -0,0 +1,73 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "helpers/ObjectPool.h"
+#include <boost/test/unit_test.hpp>
+#include <set>
+#include <stdexcept>
+
+namespace {
+struct Counted
+{
+    static int numAlive;
+    int value;
+    explicit Counted(int value) : value(value)
+    {
+        if(value < 0)
+            throw std::runtime_error("Invalid");
+        ++numAlive;
+    }
+    ~Counted() { --numAlive; }
+};
+int Counted::numAlive = 0;
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ObjectPoolTests)
+
+BOOST_AUTO_TEST_CASE(CreateAndDestroy)
+{
+    helpers::ObjectPool<Counted, 4> pool;
+    BOOST_TEST(pool.size() == 0u);
+    BOOST_TEST(pool.capacity() == 0u);
+    std::vector<Counted*> objs;
+    for(int i = 0; i < 6; i++)
+        objs.push_back(pool.create(i));
+    BOOST_TEST(pool.size() == 6u);
+    BOOST_TEST(pool.capacity() == 8u);
+    BOOST_TEST(Counted::numAlive == 6);
+    // All distinct and correctly constructed
+    BOOST_TEST(std::set<Counted*>(objs.begin(), objs.end()).size() == objs.size());
+    for(int i = 0; i < 6; i++)
+        BOOST_TEST(objs[i]->value == i);
+    pool.destroy(objs[2]);
+    pool.destroy(objs[4]);
+    BOOST_TEST(pool.size() == 4u);
+    BOOST_TEST(Counted::numAlive == 4);
+    // Freed slots are reused first (LIFO)
+    BOOST_TEST(pool.create(10) == objs[4]);
+    BOOST_TEST(pool.create(11) == objs[2]);
+    BOOST_TEST(pool.capacity() == 8u);
+    pool.destroy(nullptr);
+    BOOST_TEST(pool.size() == 6u);
+    for(Counted* obj : objs)
+        pool.destroy(obj);
+    BOOST_TEST(pool.size() == 0u);
+    BOOST_TEST(Counted::numAlive == 0);
+}
+
+BOOST_AUTO_TEST_CASE(ThrowingCtor)
+{
+    helpers::ObjectPool<Counted, 2> pool;
+    Counted* obj = pool.create(1);
+    BOOST_CHECK_THROW(pool.create(-1), std::runtime_error);
+    BOOST_TEST(pool.size() == 1u);
+    // The slot of the failed object is not lost
+    Counted* obj2 = pool.create(2);
+    BOOST_TEST(pool.capacity() == 2u);
+    pool.destroy(obj);
+    pool.destroy(obj2);
+    BOOST_TEST(Counted::numAlive == 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,139 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "RectOutput.h"
+#include "ogl/glArchivItem_Bitmap_Direct.h"
+#include "uiHelper/uiHelpers.hpp"
+#include <rttr/test/stubFunction.hpp>
+#include <s25util/warningSuppression.h>
+#include <glad/glad.h>
+#include <libsiedler2/ColorBGRA.h>
+#include <boost/test/unit_test.hpp>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace rttrOglMock4 {
+RTTR_IGNORE_DIAGNOSTIC("-Wmissing-declarations")
+
+std::vector<Rect> uploadedRects;
+std::vector<std::vector<uint8_t>> uploadedData;
+
+void APIENTRY glTexSubImage2D(GLenum, GLint, GLint xoffset, GLint yoffset, GLsizei width, GLsizei height, GLenum,
+                              GLenum, const void* pixels)
+{
+    uploadedRects.push_back(Rect(xoffset, yoffset, width, height));
+    const auto* data = static_cast<const uint8_t*>(pixels);
+    uploadedData.emplace_back(data, data + width * height * 4u);
+}
+
+RTTR_POP_DIAGNOSTIC
+} // namespace rttrOglMock4
+
+using rttrOglMock4::uploadedData;
+using rttrOglMock4::uploadedRects;
+
+namespace {
+/// 4x3 tiles with the last column and row only partially used
+constexpr Extent bmpSize(200, 130);
+
+struct BitmapDirectFixture : uiHelper::Fixture
+{
+    glArchivItem_Bitmap_Direct bmp;
+    BitmapDirectFixture()
+    {
+        bmp.init(bmpSize.x, bmpSize.y, libsiedler2::TextureFormat::BGRA);
+        uploadedRects.clear();
+        uploadedData.clear();
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(BitmapDirect, BitmapDirectFixture)
+
+BOOST_AUTO_TEST_CASE(UpdateMustBeStartedOnce)
+{
+    BOOST_CHECK_THROW(bmp.endUpdate(), std::logic_error);
+    bmp.beginUpdate();
+    BOOST_CHECK_THROW(bmp.beginUpdate(), std::logic_error);
+    bmp.endUpdate();
+    BOOST_CHECK_THROW(bmp.endUpdate(), std::logic_error);
+}
+
+BOOST_AUTO_TEST_CASE(NothingUploadedWithoutTexture)
+{
+    RTTR_STUB_FUNCTION(glTexSubImage2D, rttrOglMock4::glTexSubImage2D);
+    const libsiedler2::ColorBGRA color(1, 2, 3, 4);
+    bmp.beginUpdate();
+    bmp.updatePixel(DrawPoint(70, 10), color);
+    bmp.endUpdate();
+    BOOST_TEST(uploadedRects.empty());
+    // The pixel is still changed and used when the texture gets created
+    BOOST_TEST(bmp.getPixel(70, 10).asValue() == color.asValue());
+}
+
+BOOST_AUTO_TEST_CASE(OnlyDirtyTilesAreUploaded)
+{
+    RTTR_STUB_FUNCTION(glTexSubImage2D, rttrOglMock4::glTexSubImage2D);
+    BOOST_TEST_REQUIRE(bmp.GetTexture() != 0u);
+
+    // No changes -> Nothing to upload
+    bmp.beginUpdate();
+    bmp.endUpdate();
+    BOOST_TEST(uploadedRects.empty());
+
+    // Single pixel -> Its tile only
+    const libsiedler2::ColorBGRA color(1, 2, 3, 4);
+    bmp.beginUpdate();
+    bmp.updatePixel(DrawPoint(70, 10), color);
+    bmp.endUpdate();
+    BOOST_TEST_REQUIRE(uploadedRects.size() == 1u);
+    BOOST_TEST(uploadedRects[0] == Rect(64, 0, 64, 64));
+    // Pixel (6, 10) in the uploaded area
+    const auto* uploadedPixel = &uploadedData[0][(10 * 64 + 6) * 4];
+    BOOST_TEST(libsiedler2::ColorBGRA(uploadedPixel[0], uploadedPixel[1], uploadedPixel[2], uploadedPixel[3]).asValue()
+               == color.asValue());
+
+    // Tiles are cleared for the next update
+    uploadedRects.clear();
+    bmp.beginUpdate();
+    bmp.updatePixel(DrawPoint(10, 70), color);
+    bmp.endUpdate();
+    BOOST_TEST_REQUIRE(uploadedRects.size() == 1u);
+    BOOST_TEST(uploadedRects[0] == Rect(0, 64, 64, 64));
+}
+
+BOOST_AUTO_TEST_CASE(UploadIsClippedToBitmap)
+{
+    RTTR_STUB_FUNCTION(glTexSubImage2D, rttrOglMock4::glTexSubImage2D);
+    BOOST_TEST_REQUIRE(bmp.GetTexture() != 0u);
+
+    bmp.beginUpdate();
+    bmp.updatePixel(DrawPoint(bmpSize.x - 1, bmpSize.y - 1), libsiedler2::ColorBGRA(1, 2, 3, 4));
+    bmp.endUpdate();
+    BOOST_TEST_REQUIRE(uploadedRects.size() == 1u);
+    BOOST_TEST(uploadedRects[0] == Rect(192, 128, 8, 2));
+    BOOST_TEST(uploadedData[0].size() == 8u * 2u * 4u);
+}
+
+BOOST_AUTO_TEST_CASE(AdjacentTilesAreMerged)
+{
+    RTTR_STUB_FUNCTION(glTexSubImage2D, rttrOglMock4::glTexSubImage2D);
+    BOOST_TEST_REQUIRE(bmp.GetTexture() != 0u);
+
+    const libsiedler2::ColorBGRA color(1, 2, 3, 4);
+    bmp.beginUpdate();
+    // First row: Tiles 0, 1 and 3
+    bmp.updatePixel(DrawPoint(10, 10), color);
+    bmp.updatePixel(DrawPoint(63, 63), color);
+    bmp.updatePixel(DrawPoint(64, 0), color);
+    bmp.updatePixel(DrawPoint(199, 5), color);
+    // Last row: Tile 2
+    bmp.updatePixel(DrawPoint(130, 129), color);
+    bmp.endUpdate();
+    const std::vector<Rect> expectedRects{Rect(0, 0, 128, 64), Rect(192, 0, 8, 64), Rect(128, 128, 64, 2)};
+    BOOST_TEST(uploadedRects == expectedRects, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "drivers/VideoDriverWrapper.h"
+#include "ogl/SpriteBatch.h"
+#include "uiHelper/uiHelpers.hpp"
+#include <rttr/test/stubFunction.hpp>
+#include <s25util/warningSuppression.h>
+#include <glad/glad.h>
+#include <boost/test/unit_test.hpp>
+#include <array>
+#include <vector>
+
+namespace rttrOglMock3 {
+RTTR_IGNORE_DIAGNOSTIC("-Wmissing-declarations")
+
+std::vector<GLsizei> numDrawnVertices;
+
+void APIENTRY glDrawArrays(GLenum, GLint, GLsizei count)
+{
+    numDrawnVertices.push_back(count);
+}
+
+RTTR_POP_DIAGNOSTIC
+} // namespace rttrOglMock3
+
+namespace {
+void addQuad(SpriteBatch& batch, unsigned texture, const Point<float>& pos)
+{
+    const std::array<Point<float>, 4> vertices = {pos, pos + Point<float>(0, 10), pos + Point<float>(10, 10),
+                                                  pos + Point<float>(10, 0)};
+    std::array<GL_RGBAColor, 4> colors;
+    colors.fill(GL_RGBAColor{0xFF, 0xFF, 0xFF, 0xFF});
+    batch.add(texture, vertices.data(), vertices.data(), colors.data(), 4);
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_SUITE(SpriteBatchTests, uiHelper::Fixture)
+
+BOOST_AUTO_TEST_CASE(QuadsAreBatchedByTexture)
+{
+    SpriteBatch batch;
+    BOOST_TEST(batch.empty());
+    addQuad(batch, 1, {0, 0});
+    addQuad(batch, 1, {20, 0});
+    BOOST_TEST(batch.getNumBatches() == 1u);
+    addQuad(batch, 2, {40, 0});
+    BOOST_TEST(batch.getNumBatches() == 2u);
+    // Does not overlap the quad with texture 2 -> Can be drawn before it
+    addQuad(batch, 1, {60, 0});
+    BOOST_TEST(batch.getNumBatches() == 2u);
+    // Overlaps it -> Must be drawn after it
+    addQuad(batch, 1, {45, 5});
+    BOOST_TEST(batch.getNumBatches() == 3u);
+    addQuad(batch, 2, {100, 0});
+    BOOST_TEST(batch.getNumBatches() == 3u);
+    BOOST_TEST(batch.getNumQuads() == 6u);
+
+    RTTR_STUB_FUNCTION(glDrawArrays, rttrOglMock3::glDrawArrays);
+    rttrOglMock3::numDrawnVertices.clear();
+    batch.flush();
+    BOOST_TEST(batch.empty());
+    const std::vector<GLsizei> expectedNumVertices = {3 * 4, 2 * 4, 1 * 4};
+    BOOST_TEST(rttrOglMock3::numDrawnVertices == expectedNumVertices, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(DrawCallsAreCounted)
+{
+    BOOST_TEST(!VIDEODRIVER.GetSpriteBatch());
+    VIDEODRIVER.BeginSpriteBatch();
+    SpriteBatch* batch = VIDEODRIVER.GetSpriteBatch();
+    BOOST_TEST_REQUIRE(batch);
+    for(unsigned i = 0; i < 10; i++)
+        addQuad(*batch, 1 + i % 2, {i * 20.f, 0});
+    BOOST_TEST(batch->getNumBatches() == 2u);
+    VIDEODRIVER.EndSpriteBatch();
+    BOOST_TEST(!VIDEODRIVER.GetSpriteBatch());
+
+    VIDEODRIVER.SwapBuffers();
+    BOOST_TEST(VIDEODRIVER.GetNumDrawCalls() == 2u);
+    // Nothing drawn in the next frame
+    VIDEODRIVER.SwapBuffers();
+    BOOST_TEST(VIDEODRIVER.GetNumDrawCalls() == 0u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -8,6 +8,8 @@
 #include "uiHelper/uiHelpers.hpp"
 #include "libsiedler2/ArchivItem_Bitmap_Raw.h"
 #include "libsiedler2/PixelBufferBGRA.h"
+#include "rttr/test/TmpFolder.hpp"
+#include <boost/filesystem/operations.hpp>
 #include <boost/test/unit_test.hpp>
 #include <Rect.h>
 #include <array>
@@ -61,4 +63,68 @@ BOOST_AUTO_TEST_CASE(SizeAndPosCorrect)
     }
 }
 
+BOOST_AUTO_TEST_CASE(CacheIsUsedForSameBitmaps)
+{
+    rttr::test::TmpFolder tmpFolder;
+    const boost::filesystem::path cacheFilePath = tmpFolder.get() / "textures.dat";
+    std::array<libsiedler2::ArchivItem_Bitmap_Raw, 4> bmps;
+    for(unsigned i = 0; i < bmps.size(); ++i)
+    {
+        libsiedler2::PixelBufferBGRA buffer(5 + i, 11 + i * 3, libsiedler2::ColorBGRA(0xFFFFFFFF));
+        bmps[i].create(buffer);
+    }
+    const auto addBmps = [&bmps](glTexturePacker& packer, std::array<glSmartBitmap, 3>& smartBmps,
+                                 unsigned firstBmp = 0) {
+        for(unsigned i = 0; i < smartBmps.size(); ++i)
+        {
+            smartBmps[i].add(&bmps[firstBmp + i]);
+            packer.add(smartBmps[i]);
+        }
+    };
+
+    std::array<glSmartBitmap, 3> smartBmps;
+    glTexturePacker packer;
+    addBmps(packer, smartBmps);
+    BOOST_TEST(!packer.loadCache(cacheFilePath, 42));
+    BOOST_TEST_REQUIRE(packer.pack(cacheFilePath, 42));
+    BOOST_TEST_REQUIRE(boost::filesystem::exists(cacheFilePath));
+
+    // Same bitmaps and key -> Textures and positions from the cache
+    {
+        std::array<glSmartBitmap, 3> cachedSmartBmps;
+        glTexturePacker cachedPacker;
+        addBmps(cachedPacker, cachedSmartBmps);
+        BOOST_TEST_REQUIRE(cachedPacker.loadCache(cacheFilePath, 42));
+        BOOST_TEST_REQUIRE(cachedPacker.getTextures().size() == packer.getTextures().size());
+        BOOST_TEST((cachedPacker.getTextures()[0].getSize() == packer.getTextures()[0].getSize()));
+        for(unsigned i = 0; i < smartBmps.size(); ++i)
+        {
+            BOOST_TEST(cachedSmartBmps[i].getTexture() == cachedPacker.getTextures()[0].get());
+            BOOST_TEST((cachedSmartBmps[i].texCoords == smartBmps[i].texCoords));
+        }
+    }
+    // Different key -> Not used
+    {
+        std::array<glSmartBitmap, 3> otherSmartBmps;
+        glTexturePacker otherPacker;
+        addBmps(otherPacker, otherSmartBmps);
+        BOOST_TEST(!otherPacker.loadCache(cacheFilePath, 43));
+        BOOST_TEST(!otherSmartBmps[0].isGenerated());
+    }
+    // Different bitmaps -> Not used, but overwritten after packing
+    {
+        std::array<glSmartBitmap, 3> otherSmartBmps;
+        glTexturePacker otherPacker;
+        addBmps(otherPacker, otherSmartBmps, 1);
+        BOOST_TEST(!otherPacker.loadCache(cacheFilePath, 42));
+        BOOST_TEST_REQUIRE(otherPacker.pack(cacheFilePath, 42));
+    }
+    {
+        std::array<glSmartBitmap, 3> otherSmartBmps;
+        glTexturePacker otherPacker;
+        addBmps(otherPacker, otherSmartBmps, 1);
+        BOOST_TEST(otherPacker.loadCache(cacheFilePath, 42));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,98 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Game.h"
+#include "GamePlayer.h"
+#include "PlayerInfo.h"
+#include "RttrForeachPt.h"
+#include "ai/AIPlayer.h"
+#include "ai/aijh/AIPlayerJH.h"
+#include "factories/AIFactory.h"
+#include "world/GameWorld.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "nodeObjs/noGranite.h"
+#include "nodeObjs/noTree.h"
+#include "gameTypes/AIInfo.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <array>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+constexpr MapExtent mapSize(256, 256);
+constexpr unsigned searchRadius = 15;
+
+/// Create a world with 1 player and trees and granite spread over the whole map
+std::shared_ptr<Game> createWorld()
+{
+    PlayerInfo player;
+    player.ps = PlayerState::Occupied;
+    auto game = std::make_shared<Game>(GlobalGameSettings(), 0, std::vector<PlayerInfo>(1, player));
+    GameWorld& world = game->world_;
+    if(!CreateEmptyWorld(mapSize)(world))
+        throw std::runtime_error("Could not create world"); // LCOV_EXCL_LINE
+    RTTR_FOREACH_PT(MapPoint, mapSize)
+    {
+        if(world.GetNode(pt).obj || world.GetNode(pt).owner)
+            continue;
+        if((pt.x * 7u + pt.y * 13u) % 23u < 3u)
+            world.SetNO(pt, new noTree(pt, 0, 3));
+        else if((pt.x * 5u + pt.y * 11u) % 31u == 0u)
+            world.SetNO(pt, new noGranite(GraniteType::One, 5));
+    }
+    world.InitAfterLoad();
+    return game;
+}
+
+std::vector<MapPoint> getSearchPoints()
+{
+    std::vector<MapPoint> result;
+    for(MapCoord y = 8; y < mapSize.y; y += 32)
+    {
+        for(MapCoord x = 8; x < mapSize.x; x += 32)
+            result.emplace_back(x, y);
+    }
+    return result;
+}
+
+constexpr std::array<AIResource, 4> searchedResources = {
+  {AIResource::Wood, AIResource::Stones, AIResource::Plantspace, AIResource::Borderland}};
+} // namespace
+
+/// Create the AI including its resource maps
+static void BM_AIPositionSearchInit(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    auto game = createWorld();
+    for(auto _ : state)
+    {
+        auto ai = AIFactory::Create(AI::Info(AI::Type::Default, AI::Level::Hard), 0, game->world_);
+        benchmark::DoNotOptimize(ai);
+    }
+}
+BENCHMARK(BM_AIPositionSearchInit)->Unit(benchmark::kMillisecond);
+
+/// Position search (including updating the resource map) spread over the whole map
+static void BM_AIPositionSearch(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    auto game = createWorld();
+    auto ai = AIFactory::Create(AI::Info(AI::Type::Default, AI::Level::Hard), 0, game->world_);
+    auto& aijh = static_cast<AIJH::AIPlayerJH&>(*ai);
+    const AIResource res = searchedResources[static_cast<size_t>(state.range())];
+    const std::vector<MapPoint> searchPts = getSearchPoints();
+    // Include the HQ where the player owns land, so positions can actually be found
+    const MapPoint hqPos = game->world_.GetPlayer(0).GetHQPos();
+
+    for(auto _ : state)
+    {
+        for(const MapPoint pt : searchPts)
+            benchmark::DoNotOptimize(aijh.FindBestPosition(pt, res, BuildingQuality::Hut, searchRadius));
+        benchmark::DoNotOptimize(aijh.FindBestPosition(hqPos, res, BuildingQuality::Hut, searchRadius));
+    }
+    state.SetItemsProcessed(state.iterations() * (searchPts.size() + 1u));
+}
+BENCHMARK(BM_AIPositionSearch)->DenseRange(0, searchedResources.size() - 1);
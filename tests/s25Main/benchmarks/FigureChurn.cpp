@@ -0,0 +1,82 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Game.h"
+#include "PlayerInfo.h"
+#include "nodeObjs/noAnimal.h"
+#include "world/MapLoader.h"
+#include "rttr/test/random.hpp"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <test/testConfig.h>
+#include <vector>
+
+namespace {
+struct WalkingFigure
+{
+    noAnimal* figure;
+    MapPoint pos;
+};
+} // namespace
+
+/// Simulates lots of figures walking around on a loaded map by moving each figure to a neighbour node per step.
+/// Figures start in a few clusters so (as for carriers at flags) multiple figures share nodes
+static void BM_WalkingFigureChurn(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+
+    std::vector<PlayerInfo> players(2);
+    for(auto& player : players)
+        player.ps = PlayerState::Occupied;
+    auto game = std::make_shared<Game>(GlobalGameSettings(), 0, players);
+    GameWorld& world = game->world_;
+    MapLoader loader(world);
+    if(!loader.Load(rttr::test::rttrBaseDir / "data/RTTR/MAPS/NEW/AM_FANGDERZEIT.SWD"))
+        state.SkipWithError("Map failed to load");
+
+    const auto numFigures = static_cast<unsigned>(state.range(0));
+    constexpr unsigned numClusters = 20;
+    constexpr unsigned numSteps = 20;
+    std::vector<MapPoint> clusterCenters;
+    for(unsigned i = 0; i < numClusters; i++)
+        clusterCenters.push_back(world.MakeMapPoint(rttr::test::randomPoint<Position>(0, world.GetWidth() - 1)));
+
+    std::vector<WalkingFigure> figures;
+    figures.reserve(numFigures);
+    for(unsigned i = 0; i < numFigures; i++)
+    {
+        const MapPoint center = clusterCenters[i % numClusters];
+        const MapPoint pos = world.MakeMapPoint(Position(center) + rttr::test::randomPoint<Position>(-5, 5));
+        auto& figure = world.AddFigure(pos, std::make_unique<noAnimal>(Species::Sheep, pos));
+        figures.push_back(WalkingFigure{&figure, pos});
+    }
+    // Same sequence of directions for every iteration
+    std::vector<Direction> directions(numFigures * numSteps);
+    for(Direction& dir : directions)
+        dir = rttr::test::randomEnum<Direction>();
+
+    for(auto _ : state)
+    {
+        auto itDir = directions.begin();
+        for(unsigned step = 0; step < numSteps; step++)
+        {
+            for(WalkingFigure& fig : figures)
+            {
+                auto figure = world.RemoveFigure(fig.pos, *fig.figure);
+                fig.pos = world.GetNeighbour(fig.pos, *itDir++);
+                world.AddFigure(fig.pos, std::move(figure));
+                // Figures usually check the other figures on the node they arrive at
+                unsigned numFiguresOnNode = 0;
+                for(const noBase& other : world.GetFigures(fig.pos))
+                {
+                    if(other.GetType() == NodalObjectType::Animal)
+                        ++numFiguresOnNode;
+                }
+                benchmark::DoNotOptimize(numFiguresOnNode);
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numFigures * numSteps);
+}
+BENCHMARK(BM_WalkingFigureChurn)->Arg(500)->Arg(2000)->Arg(10000);
@@ -0,0 +1,138 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Game.h"
+#include "PlayerInfo.h"
+#include "RttrForeachPt.h"
+#include "lua/GameDataLoader.h"
+#include "pathfinding/FreePathFinder.h"
+#include "world/GameWorld.h"
+#include "nodeObjs/noGranite.h"
+#include "gameData/TerrainDesc.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <array>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace {
+constexpr MapExtent mapSize(256, 256);
+constexpr unsigned wallDistance = 32;
+
+DescIdx<TerrainDesc> findTerrain(const WorldDescription& desc, ETerrain property, TerrainKind kind)
+{
+    DescIdx<TerrainDesc> t(0);
+    for(; t.value < desc.terrain.size(); t.value++)
+    {
+        if(desc.get(t).Is(property) && desc.get(t).kind == kind)
+            break;
+    }
+    return t;
+}
+
+bool isWall(MapPoint pt)
+{
+    // Vertical walls with a gap alternating at the top and the bottom so cross-map routes have to wind through
+    if(pt.x % wallDistance != wallDistance / 2)
+        return false;
+    const bool gapAtTop = (pt.x / wallDistance) % 2u == 0u;
+    return gapAtTop ? pt.y >= 8u : pt.y < mapSize.y - 8u;
+}
+
+/// Create a 256x256 world without players. For land the walls are granite, for water they are land
+std::shared_ptr<Game> createWorld(bool water)
+{
+    auto game = std::make_shared<Game>(GlobalGameSettings(), 0, std::vector<PlayerInfo>());
+    GameWorld& world = game->world_;
+    loadGameData(world.GetDescriptionWriteable());
+    world.Init(mapSize);
+    const WorldDescription& desc = world.GetDescription();
+    const DescIdx<TerrainDesc> land = findTerrain(desc, ETerrain::Buildable, TerrainKind::Land);
+    const DescIdx<TerrainDesc> sea = findTerrain(desc, ETerrain::Shippable, TerrainKind::Water);
+    RTTR_FOREACH_PT(MapPoint, mapSize)
+    {
+        MapNode& node = world.GetNodeWriteable(pt);
+        node.t1 = node.t2 = (water && !isWall(pt)) ? sea : land;
+    }
+    if(!water)
+    {
+        RTTR_FOREACH_PT(MapPoint, mapSize)
+        {
+            if(isWall(pt))
+                world.SetNO(pt, new noGranite(GraniteType::One, 5));
+        }
+        // Enclose a single point so it is unreachable
+        const MapPoint enclosed(200, 128);
+        for(const MapPoint nb : world.GetNeighbours(enclosed))
+            world.SetNO(nb, new noGranite(GraniteType::One, 5));
+    }
+    world.InitAfterLoad();
+    return game;
+}
+
+constexpr std::array<std::tuple<const char*, MapPoint, MapPoint>, 4> routes = {{{"Short", {10, 128}, {30, 140}},
+                                                                                {"Cross map", {2, 128}, {250, 120}},
+                                                                                {"Diagonal", {2, 2}, {250, 250}},
+                                                                                {"Unreachable", {2, 128}, {200, 128}}}};
+} // namespace
+
+/// Search for the route to walk
+static void BM_FreePathHumanRoute(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    auto game = createWorld(false);
+    GameWorld& world = game->world_;
+    const auto& curValues = routes[static_cast<size_t>(state.range())];
+    state.SetLabel(std::get<0>(curValues));
+
+    for(auto _ : state)
+    {
+        // Measure the search, not the cache
+        world.GetFreePathFinder().ClearCache();
+        const bool result = world.FindHumanPath(std::get<1>(curValues), std::get<2>(curValues)).has_value();
+        benchmark::DoNotOptimize(result);
+    }
+}
+BENCHMARK(BM_FreePathHumanRoute)->DenseRange(0, routes.size() - 1);
+
+/// Search for the existence and length of a route only
+static void BM_FreePathHumanLength(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    auto game = createWorld(false);
+    GameWorld& world = game->world_;
+    const auto& curValues = routes[static_cast<size_t>(state.range())];
+    state.SetLabel(std::get<0>(curValues));
+
+    for(auto _ : state)
+    {
+        world.GetFreePathFinder().ClearCache();
+        unsigned length;
+        const bool result =
+          world.FindHumanPathLength(std::get<1>(curValues), std::get<2>(curValues), 0xFFFFFFFF, &length);
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(length);
+    }
+}
+BENCHMARK(BM_FreePathHumanLength)->DenseRange(0, routes.size() - 1);
+
+static void BM_FreePathShip(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    auto game = createWorld(true);
+    GameWorld& world = game->world_;
+    const auto& curValues = routes[static_cast<size_t>(state.range())];
+    state.SetLabel(std::get<0>(curValues));
+
+    for(auto _ : state)
+    {
+        world.GetFreePathFinder().ClearCache();
+        const bool result =
+          world.FindShipPath(std::get<1>(curValues), std::get<2>(curValues), 0xFFFFFFFF, nullptr, nullptr);
+        benchmark::DoNotOptimize(result);
+    }
+}
+// The goal is only enclosed on land, so skip the unreachable case
+BENCHMARK(BM_FreePathShip)->DenseRange(0, routes.size() - 2);
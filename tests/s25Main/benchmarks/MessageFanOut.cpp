@@ -0,0 +1,114 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AsyncChecksum.h"
+#include "network/GameMessage_Batch.h"
+#include "network/GameMessage_GameCommand.h"
+#include "network/GameMessages.h"
+#include "network/NetworkPlayer.h"
+#include "s25util/Serializer.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+namespace {
+constexpr unsigned numPlayers = 8;
+
+struct LoopbackStats
+{
+    unsigned numWrites = 0;
+    unsigned numBytes = 0;
+};
+
+/// Messages the server sends to every player in one NWF: The commands of all players and the NWFDone
+std::vector<std::unique_ptr<GameMessage>> createNWFMessages()
+{
+    std::vector<std::unique_ptr<GameMessage>> msgs;
+    for(unsigned id = 0; id < numPlayers; id++)
+    {
+        AsyncChecksum checksum(id, 1000, 2000, 3000, 4000, 5000);
+        msgs.push_back(std::make_unique<GameMessage_GameCommand>(id, checksum, std::vector<gc::GameCommandPtr>()));
+    }
+    msgs.push_back(std::make_unique<GameMessage_Server_NWFDone>(100, 50, 105));
+    return msgs;
+}
+
+/// Loopback connection: Write the message to a buffer (1 write like the socket) and parse it as the client would
+void sendAndReceive(const Message& msg, LoopbackStats& stats)
+{
+    Serializer sent;
+    sent.PushUnsignedShort(msg.getId());
+    msg.Serialize(sent);
+    stats.numWrites++;
+    stats.numBytes += sent.GetLength();
+
+    Serializer received(sent.GetData(), sent.GetLength());
+    std::unique_ptr<Message> receivedMsg(GameMessage::create_game(received.PopUnsignedShort()));
+    receivedMsg->Deserialize(received);
+    benchmark::DoNotOptimize(receivedMsg);
+}
+
+/// Send each queued message on its own
+void sendAndReceive(NetworkPlayer& player, LoopbackStats& stats)
+{
+    while(!player.sendQueue.empty())
+        sendAndReceive(*player.sendQueue.pop(), stats);
+}
+
+void setCounters(benchmark::State& state, const LoopbackStats& stats)
+{
+    state.counters["writes/NWF"] = benchmark::Counter(stats.numWrites, benchmark::Counter::kAvgIterations);
+    state.counters["bytes/NWF"] = benchmark::Counter(stats.numBytes, benchmark::Counter::kAvgIterations);
+}
+} // namespace
+
+/// Each message is copied for each player and sent on its own
+static void BM_FanOutCloned(benchmark::State& state)
+{
+    std::vector<NetworkPlayer> players;
+    for(unsigned id = 0; id < numPlayers; id++)
+        players.emplace_back(id);
+    const auto msgs = createNWFMessages();
+    LoopbackStats stats;
+
+    for(auto _ : state)
+    {
+        for(const auto& msg : msgs)
+        {
+            for(NetworkPlayer& player : players)
+                player.sendMsgAsync(msg->clone());
+        }
+        for(NetworkPlayer& player : players)
+            sendAndReceive(player, stats);
+    }
+    setCounters(state, stats);
+}
+BENCHMARK(BM_FanOutCloned);
+
+/// Each message is serialized once and the messages of each player are sent in a single write
+static void BM_FanOutSharedBatched(benchmark::State& state)
+{
+    std::vector<NetworkPlayer> players;
+    for(unsigned id = 0; id < numPlayers; id++)
+        players.emplace_back(id);
+    const auto msgs = createNWFMessages();
+    LoopbackStats stats;
+
+    for(auto _ : state)
+    {
+        for(const auto& msg : msgs)
+        {
+            const GameMessage_Shared sharedMsg(*msg);
+            for(NetworkPlayer& player : players)
+                player.sendMsgAsync(new GameMessage_Shared(sharedMsg));
+        }
+        for(NetworkPlayer& player : players)
+        {
+            const auto batch = player.popBatch(-1);
+            sendAndReceive(*batch, stats);
+        }
+    }
+    setCounters(state, stats);
+}
+BENCHMARK(BM_FanOutSharedBatched);
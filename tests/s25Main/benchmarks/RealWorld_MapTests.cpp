@@ -6,6 +6,7 @@
 #include "PlayerInfo.h"
 #include "network/GameClient.h"
 #include "ogl/glAllocator.h"
+#include "pathfinding/FreePathFinder.h"
 #include "world/MapLoader.h"
 #include "libsiedler2/libsiedler2.h"
 #include <rttr/test/Fixture.hpp>
@@ -43,6 +44,8 @@ static void BM_PathFinding(benchmark::State& state)
 
     for(auto _ : state)
     {
+        // Measure the search, not the cache
+        world.GetFreePathFinder().ClearCache();
         const bool result = state.range() < 6 ? world.FindHumanPath(start, goal).has_value() :
                                                 world.FindShipPath(start, goal, 600, nullptr, nullptr);
         benchmark::DoNotOptimize(result);
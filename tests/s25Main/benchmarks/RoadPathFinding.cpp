@@ -0,0 +1,110 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "Game.h"
+#include "PlayerInfo.h"
+#include "RttrForeachPt.h"
+#include "pathfinding/RoadPathFinder.h"
+#include "world/GameWorld.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "nodeObjs/noFlag.h"
+#include <rttr/test/Fixture.hpp>
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+constexpr MapExtent mapSize(128, 128);
+/// Area of the road grid, away from the HQ in the middle of the map
+constexpr MapCoord gridStartX = 4, gridEndX = 124, gridStartY = 8, gridEndY = 48;
+const std::vector<Direction> down{Direction::SouthEast, Direction::SouthWest};
+
+/// Create a world with 1 player owning the whole map and a grid of roads with flags every 2 nodes (1800 flags)
+std::shared_ptr<Game> createWorld()
+{
+    PlayerInfo player;
+    player.ps = PlayerState::Occupied;
+    auto game = std::make_shared<Game>(GlobalGameSettings(), 0, std::vector<PlayerInfo>(1, player));
+    GameWorld& world = game->world_;
+    if(!CreateEmptyWorld(mapSize)(world))
+        throw std::runtime_error("Could not create world"); // LCOV_EXCL_LINE
+    RTTR_FOREACH_PT(MapPoint, mapSize)
+        world.SetOwner(pt, 1);
+    world.SetFlag(MapPoint(gridStartX, gridStartY), 0);
+    for(MapCoord y = gridStartY; y < gridEndY; y += 2)
+    {
+        for(MapCoord x = gridStartX; x < gridEndX; x += 2)
+        {
+            const MapPoint pt(x, y);
+            if(x + 2 < gridEndX)
+                world.BuildRoad(0, false, pt, {2, Direction::East});
+            if(y + 2 < gridEndY)
+                world.BuildRoad(0, false, pt, down);
+        }
+    }
+    if(!world.GetSpecObj<noFlag>(MapPoint(gridEndX - 2, gridEndY - 2)))
+        throw std::runtime_error("Could not build roads"); // LCOV_EXCL_LINE
+    return game;
+}
+
+/// Flags spread over the grid, e.g. warehouses
+std::vector<const noRoadNode*> getGoals(const GameWorld& world)
+{
+    std::vector<const noRoadNode*> result;
+    for(MapCoord y = gridStartY + 2; y < gridEndY; y += 16)
+    {
+        for(MapCoord x = gridStartX + 2; x < gridEndX; x += 20)
+            result.push_back(world.GetSpecObj<noRoadNode>(MapPoint(x, y)));
+    }
+    return result;
+}
+} // namespace
+
+/// Search the nearest of some goals from flags all over the grid (like finding the nearest warehouse)
+static void BM_RoadFindBestGoal(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    auto game = createWorld();
+    RoadPathFinder& pathFinder = game->world_.GetRoadPathFinder();
+    const std::vector<const noRoadNode*> goals = getGoals(game->world_);
+    std::vector<const noRoadNode*> starts;
+    for(MapCoord y = gridStartY; y < gridEndY; y += 10)
+    {
+        for(MapCoord x = gridStartX; x < gridEndX; x += 14)
+            starts.push_back(game->world_.GetSpecObj<noRoadNode>(MapPoint(x, y)));
+    }
+
+    for(auto _ : state)
+    {
+        for(const noRoadNode* start : starts)
+            benchmark::DoNotOptimize(pathFinder.FindBestGoal(*start, goals, true, false));
+    }
+    state.SetItemsProcessed(state.iterations() * starts.size());
+}
+BENCHMARK(BM_RoadFindBestGoal)->Unit(benchmark::kMillisecond);
+
+/// Build a road to a new flag and query a bound afterwards, which updates the index for the new road
+static void BM_RoadAddRoadAndQuery(benchmark::State& state)
+{
+    rttr::test::Fixture f;
+    auto game = createWorld();
+    GameWorld& world = game->world_;
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const noRoadNode& start = *world.GetSpecObj<noRoadNode>(MapPoint(gridStartX, gridStartY));
+    const MapPoint roadStart(gridStartX, gridEndY - 2);
+    const MapPoint newFlagPt(gridStartX, gridEndY);
+    // Build the index
+    benchmark::DoNotOptimize(pathFinder.GetCostsLowerBound(start, *world.GetSpecObj<noRoadNode>(roadStart)));
+
+    for(auto _ : state)
+    {
+        world.BuildRoad(0, false, roadStart, down);
+        benchmark::DoNotOptimize(pathFinder.GetCostsLowerBound(start, *world.GetSpecObj<noRoadNode>(newFlagPt)));
+        state.PauseTiming();
+        world.DestroyFlag(newFlagPt, 0);
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_RoadAddRoadAndQuery)->Unit(benchmark::kMicrosecond);
@@ -107,6 +107,62 @@ BOOST_AUTO_TEST_CASE(MultipleEvents)
     BOOST_TEST_REQUIRE(obj.handledEventIds[2] == 44u);
 }
 
+BOOST_AUTO_TEST_CASE(LongEventsKeepOrder)
+{
+    // Events for the same GF added at different times must be executed in the order they were added
+    // no matter how far in the future they were when added
+    const unsigned targetGF = 3000000;
+    TestEventManager evMgr(0);
+    TestEventHandler obj;
+    evMgr.AddEvent(&obj, targetGF, 1);
+    evMgr.AddEvent(&obj, targetGF + 1, 10);
+    evMgr.AddEvent(&obj, 5, 0);
+    BOOST_TEST_REQUIRE(evMgr.ExecuteNextEvent() == 5u);
+    BOOST_TEST_REQUIRE(obj.handledEventIds == std::vector<unsigned>{0});
+    evMgr.AddEvent(&obj, targetGF - evMgr.GetCurrentGF(), 2);
+    BOOST_TEST_REQUIRE(evMgr.ExecuteNextEvent(targetGF - 2000) == targetGF - 2005);
+    evMgr.AddEvent(&obj, 2000, 3);
+    BOOST_TEST_REQUIRE(evMgr.ExecuteNextEvent(targetGF - 1) == 1999u);
+    evMgr.AddEvent(&obj, 1, 4);
+    const std::vector<const GameEvent*> events = evMgr.GetEvents();
+    BOOST_TEST_REQUIRE(events.size() == 5u);
+    for(unsigned i = 0; i < 4; i++)
+    {
+        BOOST_TEST(events[i]->id == i + 1);
+        BOOST_TEST(events[i]->GetTargetGF() == targetGF);
+    }
+    BOOST_TEST(events[4]->id == 10u);
+    evMgr.ExecuteNextGF();
+    BOOST_TEST_REQUIRE(obj.handledEventIds == (std::vector<unsigned>{0, 1, 2, 3, 4}));
+    evMgr.ExecuteNextGF();
+    BOOST_TEST_REQUIRE(obj.handledEventIds.size() == 6u);
+    BOOST_TEST(!evMgr.ObjectHasEvents(obj));
+}
+
+BOOST_AUTO_TEST_CASE(ObjectEvents)
+{
+    TestEventManager evMgr(0);
+    TestEventHandler obj, obj2;
+    const GameEvent* ev1 = evMgr.AddEvent(&obj, 5, 1);
+    const GameEvent* ev2 = evMgr.AddEvent(&obj, 2, 2);
+    const GameEvent* ev3 = evMgr.AddEvent(&obj2, 3, 3);
+    const GameEvent* ev4 = evMgr.AddEvent(&obj, 5, 4);
+    BOOST_TEST(evMgr.ObjectHasEvents(obj));
+    BOOST_TEST(evMgr.ObjectHasEvents(obj2));
+    // In execution order
+    BOOST_TEST(evMgr.GetObjEvents(obj) == (std::vector<const GameEvent*>{ev2, ev1, ev4}));
+    BOOST_TEST(evMgr.GetObjEvents(obj2) == std::vector<const GameEvent*>{ev3});
+    evMgr.RemoveEvent(ev1);
+    BOOST_TEST(evMgr.GetObjEvents(obj) == (std::vector<const GameEvent*>{ev2, ev4}));
+    evMgr.RemoveEvent(ev3);
+    BOOST_TEST(!evMgr.ObjectHasEvents(obj2));
+    BOOST_TEST(evMgr.ExecuteNextEvent() == 2u);
+    BOOST_TEST(evMgr.GetObjEvents(obj) == std::vector<const GameEvent*>{ev4});
+    BOOST_TEST(evMgr.ExecuteNextEvent() == 3u);
+    BOOST_TEST(!evMgr.ObjectHasEvents(obj));
+    BOOST_TEST(obj.handledEventIds == (std::vector<unsigned>{2, 4}));
+}
+
 BOOST_AUTO_TEST_CASE(Reschedule)
 {
     TestEventManager evMgr(0);
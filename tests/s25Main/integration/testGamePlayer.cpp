@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: GPL-2.0-or-later
 
 #include "GamePlayer.h"
+#include "Ware.h"
 #include "buildings/nobBaseWarehouse.h"
 #include "buildings/nobMilitary.h"
 #include "buildings/nobUsual.h"
@@ -11,11 +12,14 @@
 #include "ingameWindows/iwBuildingProductivities.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
+#include "nodeObjs/noFlag.h"
 #include "gameData/BuildingProperties.h"
 #include "rttr/test/random.hpp"
 #include "s25util/warningSuppression.h"
 #include <boost/test/unit_test.hpp>
+#include <memory>
 #include <numeric>
+#include <vector>
 
 using WorldFixtureEmpty2P = WorldFixture<CreateEmptyWorld, 2>;
 
@@ -111,3 +115,27 @@ BOOST_FIXTURE_TEST_CASE(ProductivityStats, WorldFixtureEmpty1P)
     BOOST_TEST(buildingRegister.CalcProductivities() == expectedProductivity, per_element());
     BOOST_TEST(buildingRegister.CalcAverageProductivity() == avgProd);
 }
+
+using WorldFixtureDefault1P = WorldFixture<CreateEmptyWorld, 1>;
+BOOST_FIXTURE_TEST_CASE(ClientForWareIsNotAtWareLocation, WorldFixtureDefault1P)
+{
+    GamePlayer& player = world.GetPlayer(0);
+    const MapPoint hqFlagPos = world.GetNeighbour(player.GetHQPos(), Direction::SouthEast);
+    // 2 sawmills east of the HQ connected by roads
+    const MapPoint flag1Pos = world.MakeMapPoint(hqFlagPos + Position(4, 0));
+    const MapPoint flag2Pos = world.MakeMapPoint(hqFlagPos + Position(8, 0));
+    const MapPoint bld1Pos = world.GetNeighbour(flag1Pos, Direction::NorthWest);
+    const MapPoint bld2Pos = world.GetNeighbour(flag2Pos, Direction::NorthWest);
+    auto* sawmill1 = BuildingFactory::CreateBuilding(world, BuildingType::Sawmill, bld1Pos, 0, Nation::Romans);
+    auto* sawmill2 = BuildingFactory::CreateBuilding(world, BuildingType::Sawmill, bld2Pos, 0, Nation::Romans);
+    BOOST_TEST_REQUIRE(sawmill1);
+    BOOST_TEST_REQUIRE(sawmill2);
+    world.BuildRoad(0, false, hqFlagPos, std::vector<Direction>(4, Direction::East));
+    world.BuildRoad(0, false, flag1Pos, std::vector<Direction>(4, Direction::East));
+    BOOST_TEST_REQUIRE(world.GetSpecObj<noFlag>(flag2Pos)->GetRoute(Direction::West));
+
+    // A ware in the first sawmill is not delivered to it, but to the other one
+    auto ware = std::make_unique<Ware>(GoodType::Wood, nullptr, sawmill1);
+    BOOST_TEST(player.FindClientForWare(*ware) == sawmill2);
+    player.RemoveWare(*ware);
+}
@@ -0,0 +1,80 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "GamePlayer.h"
+#include "IngameMinimap.h"
+#include "RttrForeachPt.h"
+#include "worldFixtures/CreateEmptyWorld.h"
+#include "worldFixtures/WorldFixture.h"
+#include "world/GameWorldViewer.h"
+#include "nodeObjs/noTree.h"
+#include "gameTypes/GameTypesOutput.h"
+#include "gameData/MinimapConsts.h"
+#include <libsiedler2/ColorBGRA.h>
+#include <boost/test/unit_test.hpp>
+#include <vector>
+
+namespace {
+using EmptyWorldFixture1P = WorldFixture<CreateEmptyWorld, 1>;
+
+/// Gives access to the pixels of the minimap
+class TestMinimap : public IngameMinimap
+{
+public:
+    using IngameMinimap::IngameMinimap;
+
+    unsigned getColor(const MapPoint pt, const unsigned t) const
+    {
+        return map.getPixel((pt.x * 2 + t + (pt.y & 1)) % (GetMapSize().x * 2), pt.y).asValue();
+    }
+    std::vector<unsigned> getColors() const
+    {
+        std::vector<unsigned> result;
+        RTTR_FOREACH_PT(MapPoint, GetMapSize())
+        {
+            for(unsigned t = 0; t < 2; ++t)
+                result.push_back(getColor(pt, t));
+        }
+        return result;
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(ToggledLayersAreRecomposedFromStoredColors, EmptyWorldFixture1P)
+{
+    const MapPoint hqPos = world.GetPlayer(0).GetHQPos();
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    const MapPoint roadPos = world.GetNeighbour(hqFlagPos, Direction::East);
+    const MapPoint treePos = world.MakeMapPoint(hqPos - Position(3, 0));
+    world.BuildRoad(0, false, hqFlagPos, std::vector<Direction>(2, Direction::East));
+    BOOST_TEST_REQUIRE(world.GetPointRoad(hqFlagPos, Direction::East) == PointRoad::Normal);
+    world.SetNO(treePos, new noTree(treePos, 0, 3));
+
+    GameWorldViewer gwv(0, world);
+    TestMinimap minimap(gwv);
+    const std::vector<unsigned> origColors = minimap.getColors();
+    BOOST_TEST(minimap.getColor(hqPos, 0) == BUILDING_COLOR);
+    BOOST_TEST(minimap.getColor(roadPos, 0) == ROAD_COLOR);
+    const unsigned origTreeColor = minimap.getColor(treePos, 0);
+
+    // Hiding a layer shows the one below
+    minimap.ToggleHouses();
+    BOOST_TEST(minimap.getColor(hqPos, 0) != BUILDING_COLOR);
+    BOOST_TEST(minimap.getColor(roadPos, 0) == ROAD_COLOR);
+    minimap.ToggleRoads();
+    BOOST_TEST(minimap.getColor(roadPos, 0) != ROAD_COLOR);
+    const unsigned roadTerritoryColor = minimap.getColor(roadPos, 0);
+    minimap.ToggleTerritory();
+    BOOST_TEST(minimap.getColor(roadPos, 0) != roadTerritoryColor);
+    // The varied brightness of the tree is kept, only the player color is removed
+    BOOST_TEST(minimap.getColor(treePos, 0) != origTreeColor);
+    minimap.ToggleTerritory();
+    BOOST_TEST(minimap.getColor(treePos, 0) == origTreeColor);
+    BOOST_TEST(minimap.getColor(roadPos, 0) == roadTerritoryColor);
+
+    // Showing all layers again restores the original minimap exactly
+    minimap.ToggleRoads();
+    minimap.ToggleHouses();
+    BOOST_TEST(minimap.getColors() == origColors, boost::test_tools::per_element());
+}
@@ -2,10 +2,14 @@
 //
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "GamePlayer.h"
 #include "RttrForeachPt.h"
 #include "helpers/OptionalIO.h"
+#include "pathfinding/FreePathFinder.h"
+#include "pathfinding/RoadPathFinder.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/WorldFixture.h"
+#include "nodeObjs/noFlag.h"
 #include "nodeObjs/noGranite.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "gameData/GameConsts.h"
@@ -24,6 +28,8 @@ BOOST_AUTO_TEST_SUITE(PathfindingSuite)
 namespace {
 using WorldFixtureEmpty0P = WorldFixture<CreateEmptyWorld, 0>;
 using WorldFixtureEmpty1P = WorldFixture<CreateEmptyWorld, 1>;
+using WorldFixtureEmpty0PBig = WorldFixture<CreateEmptyWorld, 0, 64, 64>;
+using WorldFixtureEmpty1PBig = WorldFixture<CreateEmptyWorld, 1, 40, 32>;
 
 /// Sets all terrain to the given terrain
 void clearWorld(GameWorld& world, DescIdx<TerrainDesc> terrain)
@@ -290,4 +296,235 @@ BOOST_FIXTURE_TEST_CASE(BlockedPaths, WorldFixtureEmpty0P)
     BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, surroundingPts2[0]));
 }
 
+BOOST_FIXTURE_TEST_CASE(CachedFreePaths, WorldFixtureEmpty0PBig)
+{
+    const FreePathCache& cache = world.GetFreePathFinder().GetCache();
+    const MapPoint startPt(3, 6);
+    const MapPoint endPt(13, 6);
+    std::vector<Direction> route;
+    unsigned length;
+    BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, endPt, 99, false, &length, &route));
+    BOOST_TEST(length == 10u);
+    BOOST_TEST(cache.GetNumMisses() == 1u);
+    BOOST_TEST(cache.GetNumHits() == 0u);
+
+    // Same search is answered from the cache
+    std::vector<Direction> cachedRoute;
+    unsigned cachedLength;
+    BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, endPt, 99, false, &cachedLength, &cachedRoute));
+    BOOST_TEST(cache.GetNumHits() == 1u);
+    BOOST_TEST(cachedLength == length);
+    BOOST_TEST(cachedRoute == route, boost::test_tools::per_element());
+    // Other parameters require a new search
+    BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, endPt, 50));
+    BOOST_TEST(cache.GetNumMisses() == 2u);
+
+    // Changes far away don't affect the result
+    world.SetNO(MapPoint(40, 40), new noGranite(GraniteType::One, 1));
+    BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, endPt, 99, false, &cachedLength));
+    BOOST_TEST(cache.GetNumHits() == 2u);
+    BOOST_TEST(cachedLength == length);
+
+    // Blocking the route requires a new search which finds the detour
+    MapPoint blockedPt = startPt;
+    for(unsigned i = 0; i < 5; i++)
+        blockedPt = world.GetNeighbour(blockedPt, route[i]);
+    world.SetNO(blockedPt, new noGranite(GraniteType::One, 1));
+    BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, endPt, 99, false, &cachedLength));
+    BOOST_TEST(cache.GetNumMisses() == 3u);
+    BOOST_TEST(cachedLength == length + 1u);
+    // Removing it again makes the direct route possible
+    world.DestroyNO(blockedPt);
+    BOOST_TEST_REQUIRE(world.FindHumanPath(startPt, endPt, 99, false, &cachedLength));
+    BOOST_TEST(cache.GetNumMisses() == 4u);
+    BOOST_TEST(cachedLength == length);
+}
+
+BOOST_FIXTURE_TEST_CASE(FreePathLengthMatchesRoute, WorldFixtureEmpty0PBig)
+{
+    // Wall with a gap at the top and a single enclosed point
+    for(MapCoord y = 5; y < 60; y++)
+        world.SetNO(MapPoint(30, y), new noGranite(GraniteType::One, 1));
+    const MapPoint enclosedPt(50, 20);
+    for(const MapPoint pt : world.GetNeighbours(enclosedPt))
+        world.SetNO(pt, new noGranite(GraniteType::One, 1));
+
+    const std::vector<std::pair<MapPoint, MapPoint>> routes = {
+      {{3, 6}, {13, 6}}, {{20, 40}, {40, 40}}, {{40, 40}, {20, 40}}, {{20, 10}, {10, 50}}, {{5, 5}, enclosedPt}};
+    for(const auto& route : routes)
+    {
+        world.GetFreePathFinder().ClearCache();
+        unsigned length = 0;
+        const bool found = world.FindHumanPath(route.first, route.second, 200, false, &length).has_value();
+        for(const unsigned maxLength : {200u, length, length - 1u})
+        {
+            world.GetFreePathFinder().ClearCache();
+            unsigned expectedLength = 0;
+            const bool expectedFound =
+              world.FindHumanPath(route.first, route.second, maxLength, false, &expectedLength).has_value();
+            // Don't use the cached result of the route search
+            world.GetFreePathFinder().ClearCache();
+            unsigned curLength = 0;
+            BOOST_TEST(world.FindHumanPathLength(route.first, route.second, maxLength, &curLength) == expectedFound);
+            if(expectedFound)
+                BOOST_TEST(curLength == expectedLength);
+        }
+        BOOST_TEST(found == (route.second != enclosedPt));
+    }
+    // The length only result is cached but a route requires a new search
+    world.GetFreePathFinder().ClearCache();
+    const FreePathCache& cache = world.GetFreePathFinder().GetCache();
+    const unsigned numHits = cache.GetNumHits();
+    BOOST_TEST(world.FindHumanPathLength(MapPoint(20, 40), MapPoint(40, 40), 200));
+    BOOST_TEST(world.FindHumanPathLength(MapPoint(20, 40), MapPoint(40, 40), 200));
+    BOOST_TEST(cache.GetNumHits() == numHits + 1u);
+    const unsigned numMisses = cache.GetNumMisses();
+    BOOST_TEST(world.FindHumanPath(MapPoint(20, 40), MapPoint(40, 40), 200));
+    BOOST_TEST(cache.GetNumMisses() == numMisses + 1u);
+}
+
+BOOST_FIXTURE_TEST_CASE(RoadPathsWithLowerBounds, WorldFixtureEmpty1P)
+{
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const MapPoint hqFlagPos = world.GetNeighbour(world.GetPlayer(0).GetHQPos(), Direction::SouthEast);
+    const MapPoint flag1Pos = world.MakeMapPoint(Position(hqFlagPos) + Position(2, 0));
+    const MapPoint flag2Pos = world.MakeMapPoint(Position(hqFlagPos) + Position(4, 0));
+    const MapPoint flag3Pos = world.MakeMapPoint(Position(hqFlagPos) + Position(6, 0));
+    world.BuildRoad(0, false, hqFlagPos, {2, Direction::East});
+    world.BuildRoad(0, false, flag1Pos, {2, Direction::East});
+    world.SetFlag(flag3Pos, 0);
+    const noFlag& hqFlag = *world.GetSpecObj<noFlag>(hqFlagPos);
+    const noFlag& flag1 = *world.GetSpecObj<noFlag>(flag1Pos);
+    const noFlag& flag2 = *world.GetSpecObj<noFlag>(flag2Pos);
+    const noFlag& flag3 = *world.GetSpecObj<noFlag>(flag3Pos);
+
+    unsigned length;
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(hqFlag, flag2, false, 100, nullptr, &length));
+    BOOST_TEST(length == 4u);
+    BOOST_TEST(pathFinder.GetCostsLowerBound(hqFlag, flag2) <= length);
+    BOOST_TEST(pathFinder.GetCostsLowerBound(flag2, hqFlag) <= length);
+    BOOST_TEST(!pathFinder.FindPath(hqFlag, flag2, false, 3, nullptr, &length));
+    // Not connected
+    BOOST_TEST(pathFinder.GetCostsLowerBound(hqFlag, flag3) == RoadLandmarkIndex::unreachable);
+    BOOST_TEST(!pathFinder.PathExists(hqFlag, flag3, true));
+
+    // New roads are considered
+    world.BuildRoad(0, false, flag2Pos, {2, Direction::East});
+    BOOST_TEST(pathFinder.GetCostsLowerBound(hqFlag, flag3) <= 6u);
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(hqFlag, flag3, false, 100, nullptr, &length));
+    BOOST_TEST(length == 6u);
+
+    // Best goal is the nearest one, the first one on ties
+    BOOST_TEST(pathFinder.FindBestGoal(hqFlag, {&flag3, &flag1, &flag2}, false, false, 100, nullptr, &length) == 1);
+    BOOST_TEST(length == 2u);
+    BOOST_TEST(pathFinder.FindBestGoal(flag3, {&flag2, &flag1, &flag2}, false, true) == 0);
+    BOOST_TEST(pathFinder.FindBestGoal(hqFlag, {&flag3}, false, false, 5) == -1);
+
+    // Removed roads are considered too
+    world.GetSpecObj<noFlag>(flag1Pos)->DestroyRoad(Direction::East);
+    BOOST_TEST(!pathFinder.PathExists(hqFlag, flag2, true));
+    BOOST_TEST(pathFinder.GetCostsLowerBound(hqFlag, flag2) <= 4u);
+    BOOST_TEST(pathFinder.FindBestGoal(hqFlag, {&flag3, &flag2, &flag1}, false, false) == 2);
+}
+
+BOOST_FIXTURE_TEST_CASE(RoadLowerBoundsUpdatedByNewRoads, WorldFixtureEmpty1PBig)
+{
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        world.SetOwner(pt, 1);
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const RoadLandmarkIndex& landmarks = pathFinder.GetLandmarkIndex();
+    // 2 rows of flags connected at the left end only
+    const std::vector<Direction> down{Direction::SouthEast, Direction::SouthWest, Direction::SouthEast,
+                                      Direction::SouthWest};
+    const MapPoint rowStart1(2, 4), rowStart2(2, 8);
+    for(const MapPoint rowStart : {rowStart1, rowStart2})
+    {
+        world.SetFlag(rowStart, 0);
+        for(MapCoord x = rowStart.x; x < 36; x += 2)
+            world.BuildRoad(0, false, MapPoint(x, rowStart.y), {2, Direction::East});
+    }
+    world.BuildRoad(0, false, rowStart1, down);
+    const MapPoint rowEnd1(36, rowStart1.y), rowEnd2(36, rowStart2.y);
+    BOOST_TEST_REQUIRE(world.GetSpecObj<noFlag>(rowEnd1));
+    BOOST_TEST_REQUIRE(world.GetSpecObj<noFlag>(rowEnd2));
+    const noFlag& end1 = *world.GetSpecObj<noFlag>(rowEnd1);
+    const noFlag& end2 = *world.GetSpecObj<noFlag>(rowEnd2);
+
+    unsigned length;
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(end1, end2, false, 1000, nullptr, &length));
+    BOOST_TEST(length == 34u + 4u + 34u);
+    BOOST_TEST_REQUIRE(landmarks.IsValid());
+    BOOST_TEST_REQUIRE(landmarks.GetNumLandmarks() > 0u);
+    BOOST_TEST(pathFinder.GetCostsLowerBound(end1, end2) <= length);
+    BOOST_TEST(pathFinder.GetCostsLowerBound(end1, end2) > 4u);
+
+    // Shortcut between the ends updates the bounds without a rebuild
+    world.BuildRoad(0, false, rowEnd1, down);
+    BOOST_TEST(landmarks.IsValid());
+    BOOST_TEST_REQUIRE(pathFinder.FindPath(end1, end2, false, 1000, nullptr, &length));
+    BOOST_TEST(length == 4u);
+    BOOST_TEST(pathFinder.GetCostsLowerBound(end1, end2) <= length);
+    // New flags get added
+    const MapPoint newFlagPos(20, 12);
+    world.BuildRoad(0, false, MapPoint(20, rowStart2.y), down);
+    BOOST_TEST(landmarks.IsValid());
+    const noFlag& newFlag = *world.GetSpecObj<noFlag>(newFlagPos);
+    for(const noFlag* flag : {&end1, &end2})
+    {
+        BOOST_TEST_REQUIRE(pathFinder.FindPath(*flag, newFlag, false, 1000, nullptr, &length));
+        BOOST_TEST(pathFinder.GetCostsLowerBound(*flag, newFlag) <= length);
+        BOOST_TEST(pathFinder.GetCostsLowerBound(newFlag, *flag) <= length);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(RoadDistancesToManyGoals, WorldFixtureEmpty1P)
+{
+    RoadPathFinder& pathFinder = world.GetRoadPathFinder();
+    const MapPoint hqPos = world.GetPlayer(0).GetHQPos();
+    const MapPoint hqFlagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    const MapPoint flag1Pos = world.MakeMapPoint(Position(hqFlagPos) + Position(2, 0));
+    const MapPoint flag2Pos = world.MakeMapPoint(Position(hqFlagPos) + Position(4, 0));
+    const MapPoint flag3Pos = world.MakeMapPoint(Position(hqFlagPos) + Position(2, 2));
+    world.BuildRoad(0, false, hqFlagPos, {2, Direction::East});
+    world.BuildRoad(0, false, flag1Pos, {2, Direction::East});
+    world.BuildRoad(0, false, hqFlagPos, {Direction::SouthEast, Direction::SouthEast, Direction::East});
+    world.SetFlag(world.MakeMapPoint(Position(hqFlagPos) + Position(6, 0)), 0);
+    const noRoadNode& hq = *world.GetSpecObj<noRoadNode>(hqPos);
+    const noRoadNode& hqFlag = *world.GetSpecObj<noRoadNode>(hqFlagPos);
+    const std::vector<const noRoadNode*> goals{
+      world.GetSpecObj<noRoadNode>(flag2Pos), &hq, world.GetSpecObj<noRoadNode>(flag1Pos),
+      world.GetSpecObj<noRoadNode>(flag3Pos), world.GetSpecObj<noRoadNode>(flag2Pos),
+      world.GetSpecObj<noRoadNode>(world.MakeMapPoint(Position(hqFlagPos) + Position(6, 0)))};
+
+    for(const bool wareMode : {false, true})
+    {
+        for(const bool reverse : {false, true})
+        {
+            const std::vector<unsigned> distances = pathFinder.FindDistances(hqFlag, goals, wareMode, reverse);
+            BOOST_TEST_REQUIRE(distances.size() == goals.size());
+            // Same results as searching each goal on its own
+            for(unsigned i = 0; i < goals.size(); i++)
+            {
+                unsigned length;
+                const noRoadNode& start = reverse ? *goals[i] : hqFlag;
+                const noRoadNode& goal = reverse ? hqFlag : *goals[i];
+                if(pathFinder.FindPath(start, goal, wareMode, std::numeric_limits<unsigned>::max(), nullptr, &length))
+                    BOOST_TEST(distances[i] == length);
+                else
+                    BOOST_TEST(distances[i] == std::numeric_limits<unsigned>::max());
+            }
+            BOOST_TEST(distances[1] == 1u);
+            BOOST_TEST(distances[2] == 2u);
+            BOOST_TEST(distances[3] == 3u);
+            BOOST_TEST(distances[5] == std::numeric_limits<unsigned>::max());
+        }
+    }
+    // Limited costs
+    const std::vector<unsigned> distances = pathFinder.FindDistances(hqFlag, goals, false, false, 2);
+    BOOST_TEST(distances[2] == 2u);
+    BOOST_TEST(distances[3] == std::numeric_limits<unsigned>::max());
+    // Flag 1 is the nearest one from flag 2
+    BOOST_TEST(pathFinder.FindBestGoal(*goals[0], {goals[3], goals[2], goals[1]}, false, false) == 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,133 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "EventManager.h"
+#include "Game.h"
+#include "GamePlayer.h"
+#include "PlayerInfo.h"
+#include "Replay.h"
+#include "ReplayPlayer.h"
+#include "factories/GameCommandFactory.h"
+#include "lua/LuaInterfaceGameBase.h"
+#include "network/PlayerGameCommands.h"
+#include "test/testConfig.h"
+#include "world/GameWorld.h"
+#include "gameTypes/MapInfo.h"
+#include "gameData/SettingTypeConv.h"
+#include "rttr/test/LogAccessor.hpp"
+#include "s25util/tmpFile.h"
+#include <boost/filesystem/operations.hpp>
+#include <boost/test/unit_test.hpp>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+struct MilitaryCommands : public GameCommandFactory
+{
+    PlayerGameCommands result;
+
+    MilitaryCommands(const MilitarySettings& settings, const AsyncChecksum& checksum)
+    {
+        result.checksum = checksum;
+        ChangeMilitary(settings);
+    }
+
+protected:
+    bool AddGC(gc::GameCommandPtr gc) override
+    {
+        result.gcs.push_back(gc);
+        return true;
+    }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(ReplayPlayerSuite)
+
+BOOST_AUTO_TEST_CASE(RunsReplayWithLuaScript)
+{
+    rttr::test::LogAccessor logAcc;
+    TmpFile luaFile(".lua");
+    luaFile.getStream() << "function getRequiredLuaVersion()\n return " << LuaInterfaceGameBase::GetVersion()
+                        << "\nend\n"
+                        << "function onStart(isFirstStart)\n rttr:Log('LUA: Started')\nend\n"
+                        << "function onGameFrame(gf)\n rttr:Log('LUA: GF '..gf)\nend\n";
+    luaFile.close();
+
+    MapInfo map;
+    map.type = MapType::OldMap;
+    map.title = "LuaFunctions";
+    map.filepath = rttr::test::rttrBaseDir / "tests" / "testData" / "maps" / "LuaFunctions.SWD";
+    BOOST_TEST_REQUIRE(map.mapData.CompressFromFile(map.filepath, &map.mapChecksum));
+    BOOST_TEST_REQUIRE(map.luaData.CompressFromFile(luaFile.filePath, &map.luaChecksum));
+
+    std::vector<PlayerInfo> players(3);
+    players[0].ps = PlayerState::Locked;
+    players[1].ps = PlayerState::Occupied;
+    players[1].name = "Player";
+    players[2].ps = PlayerState::Locked;
+
+    const MilitarySettings zeroSettings{};
+    TmpFile replayFile(".rpl");
+    replayFile.close();
+    boost::filesystem::remove(replayFile.filePath);
+    {
+        Replay replay;
+        for(const PlayerInfo& player : players)
+            replay.AddPlayer(player);
+        replay.random_init = 815;
+        BOOST_TEST_REQUIRE(replay.StartRecording(replayFile.filePath, map));
+        replay.UpdateLastGF(1);
+        replay.AddChatCommand(1, 1, ChatDestination::All, "Hello");
+        // Commands with a checksum not matching the game
+        replay.UpdateLastGF(2);
+        replay.AddGameCommand(2, 1, MilitaryCommands(MILITARY_SETTINGS_SCALE, AsyncChecksum(1, 2, 3, 4, 5)).result);
+        // Commands without a checksum are not checked
+        replay.UpdateLastGF(4);
+        replay.AddGameCommand(4, 1, MilitaryCommands(zeroSettings, AsyncChecksum()).result);
+        replay.UpdateLastGF(6);
+        BOOST_TEST_REQUIRE(replay.StopRecording());
+    }
+
+    {
+        ReplayPlayer player(replayFile.filePath);
+        BOOST_TEST(logAcc.getLog().find("LUA: Started") != std::string::npos);
+        Game& game = player.GetGame();
+        BOOST_TEST(game.world_.HasLua());
+        BOOST_TEST(player.GetPlayerId() == 1u);
+        BOOST_TEST(!player.IsHost());
+        const GamePlayer& gamePlayer = game.world_.GetPlayer(1);
+
+        std::vector<unsigned> asyncGFs;
+        while(!player.IsFinished())
+        {
+            const unsigned curGF = game.em_->GetCurrentGF();
+            if(!player.RunGF())
+                asyncGFs.push_back(curGF);
+            BOOST_TEST(game.em_->GetCurrentGF() == curGF + 1u);
+            BOOST_TEST(logAcc.getLog().find("LUA: GF " + std::to_string(curGF + 1u)) != std::string::npos);
+            if(curGF == 2u)
+            {
+                for(unsigned i = 0; i < MILITARY_SETTINGS_SCALE.size(); i++)
+                    BOOST_TEST(gamePlayer.GetMilitarySetting(i) == MILITARY_SETTINGS_SCALE[i]);
+            }
+        }
+        BOOST_TEST(asyncGFs == std::vector<unsigned>{2u});
+        // Finished after the GF of the last command
+        BOOST_TEST(game.em_->GetCurrentGF() == 5u);
+        for(unsigned i = 0; i < zeroSettings.size(); i++)
+            BOOST_TEST(gamePlayer.GetMilitarySetting(i) == 0u);
+    }
+    // Close the replay before the file gets removed
+}
+
+BOOST_AUTO_TEST_CASE(InvalidReplayThrows)
+{
+    TmpFile replayFile(".rpl");
+    replayFile.getStream() << "Invalid";
+    replayFile.close();
+    BOOST_CHECK_THROW(ReplayPlayer player(replayFile.filePath), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
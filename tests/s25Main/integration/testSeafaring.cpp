@@ -4,6 +4,7 @@
 
 #include "GamePlayer.h"
 #include "PointOutput.h"
+#include "SerializedGameData.h"
 #include "buildings/noBuildingSite.h"
 #include "buildings/nobHarborBuilding.h"
 #include "buildings/nobShipYard.h"
@@ -11,6 +12,7 @@
 #include "pathfinding/FindPathForRoad.h"
 #include "postSystem/PostBox.h"
 #include "postSystem/ShipPostMsg.h"
+#include "worldFixtures/MockLocalGameState.h"
 #include "worldFixtures/SeaWorldWithGCExecution.h"
 #include "worldFixtures/initGameRNG.hpp"
 #include "nodeObjs/noShip.h"
@@ -124,6 +126,45 @@ BOOST_FIXTURE_TEST_CASE(ShipBuilding, SeaWorldWithGCExecution<>)
     BOOST_TEST_REQUIRE(player.GetShipID(ship) == 0u);
 }
 
+BOOST_FIXTURE_TEST_CASE(ShipRoutesSameAfterLoad, SeaWorldWithGCExecution<>)
+{
+    const unsigned seaId = 1;
+    const MapPoint startPt = world.GetCoastalPoint(1, seaId);
+    BOOST_TEST_REQUIRE(startPt.isValid());
+    // Ship routes are random depending on the GF, so get them for more GFs than there are start directions
+    const auto getRoutes = [this, startPt]() {
+        std::vector<std::vector<Direction>> routes;
+        for(unsigned i = 0; i < 12; i++)
+        {
+            for(unsigned targetHbId = 2; targetHbId <= world.GetNumHarborPoints(); targetHbId++)
+            {
+                std::vector<Direction> route;
+                BOOST_TEST_REQUIRE(world.FindShipPathToHarbor(startPt, targetHbId, seaId, &route, nullptr));
+                routes.push_back(route);
+            }
+            em.ExecuteNextGF();
+        }
+        return routes;
+    };
+    // Routes get stored in a running game
+    getRoutes();
+    SerializedGameData sgd;
+    sgd.MakeSnapshot(*game);
+    const unsigned savedGF = em.GetCurrentGF();
+    const auto expectedRoutes = getRoutes();
+
+    // Stored routes are not saved. Searching them again must give the same routes as in the running game
+    MockLocalGameState lgs;
+    em.Clear();
+    world.Unload();
+    sgd.ReadSnapshot(*game, lgs);
+    BOOST_TEST_REQUIRE(em.GetCurrentGF() == savedGF);
+    const auto routes = getRoutes();
+    BOOST_TEST_REQUIRE(routes.size() == expectedRoutes.size());
+    for(unsigned i = 0; i < routes.size(); i++)
+        BOOST_TEST(routes[i] == expectedRoutes[i], boost::test_tools::per_element());
+}
+
 template<unsigned T_numPlayers = 3, unsigned T_hbId = 1, unsigned T_width = SeaWorldDefault::width,
          unsigned T_height = SeaWorldDefault::height>
 struct ShipReadyFixture : public SeaWorldWithGCExecution<T_numPlayers, T_width, T_height>
@@ -212,13 +253,13 @@ BOOST_FIXTURE_TEST_CASE(ExplorationExpedition, ShipReadyFixture<>)
     BOOST_TEST_REQUIRE(ship->GetHomeHarbor() == 0u);
 
     // We want the ship to only scout unexplored harbors, so set all but one to visible
-    world.GetNodeWriteable(world.GetHarborPoint(6)).fow[curPlayer].visibility = Visibility::Visible; //-V807
+    world.GetFoWNodeWriteable(world.GetHarborPoint(6), curPlayer).visibility = Visibility::Visible; //-V807
     // Team visibility, so set one to own team
     world.GetPlayer(curPlayer).team = Team::Team1;
     world.GetPlayer(1).team = Team::Team1;
     world.GetPlayer(curPlayer).MakeStartPacts();
     world.GetPlayer(1).MakeStartPacts();
-    world.GetNodeWriteable(world.GetHarborPoint(3)).fow[1].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(3), 1).visibility = Visibility::Visible;
     unsigned targetHbId = 8u;
 
     // Start again (everything is here)
@@ -236,7 +277,7 @@ BOOST_FIXTURE_TEST_CASE(ExplorationExpedition, ShipReadyFixture<>)
     BOOST_TEST_REQUIRE(ship->IsOnExplorationExpedition());
     BOOST_TEST_REQUIRE(world.CalcDistance(world.GetHarborPoint(targetHbId), ship->GetPos()) <= 2u);
     // Now the ship waits and will select the next harbor. We allow another one:
-    world.GetNodeWriteable(world.GetHarborPoint(6)).fow[curPlayer].visibility = Visibility::FogOfWar;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(6), curPlayer).visibility = Visibility::FogOfWar;
     targetHbId = 6u;
     RTTR_EXEC_TILL(350, ship->IsMoving());
     BOOST_TEST_REQUIRE(ship->GetHomeHarbor() == hbId);
@@ -248,7 +289,7 @@ BOOST_FIXTURE_TEST_CASE(ExplorationExpedition, ShipReadyFixture<>)
     BOOST_TEST_REQUIRE(world.CalcDistance(world.GetHarborPoint(targetHbId), ship->GetPos()) <= 2u);
 
     // Now disallow the first harbor so ship returns home
-    world.GetNodeWriteable(world.GetHarborPoint(8)).fow[curPlayer].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(8), curPlayer).visibility = Visibility::Visible;
 
     RTTR_EXEC_TILL(350, ship->IsMoving());
     BOOST_TEST_REQUIRE(ship->GetHomeHarbor() == hbId);
@@ -261,7 +302,7 @@ BOOST_FIXTURE_TEST_CASE(ExplorationExpedition, ShipReadyFixture<>)
     BOOST_TEST_REQUIRE(ship->GetPos() == world.GetCoastalPoint(hbId, 1));
 
     // Now try to start an expedition but all harbors are explored -> Load, Unload, Idle
-    world.GetNodeWriteable(world.GetHarborPoint(6)).fow[curPlayer].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(6), curPlayer).visibility = Visibility::Visible;
     this->StartStopExplorationExpedition(hbPos, true);
     BOOST_TEST_REQUIRE(ship->IsOnExplorationExpedition());
     RTTR_EXEC_TILL(2 * 200 + 5, ship->IsIdling());
@@ -286,8 +327,8 @@ BOOST_FIXTURE_TEST_CASE(DestroyHomeOnExplExp, ShipReadyFixture<2>)
     world.GetPlayer(curPlayer).MakeStartPacts();
     world.GetPlayer(1).MakeStartPacts();
 
-    world.GetNodeWriteable(world.GetHarborPoint(6)).fow[1].visibility = Visibility::Visible;
-    world.GetNodeWriteable(world.GetHarborPoint(3)).fow[1].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(6), 1).visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(3), 1).visibility = Visibility::Visible;
     unsigned targetHbId = 8u;
     this->StartStopExplorationExpedition(hbPos, true);
 
@@ -303,7 +344,7 @@ BOOST_FIXTURE_TEST_CASE(DestroyHomeOnExplExp, ShipReadyFixture<2>)
     // Run till ship is coming back
     RTTR_EXEC_TILL(1000, ship->GetTargetHarbor() == hbId);
     // Avoid that it goes back to that point
-    world.GetNodeWriteable(world.GetHarborPoint(targetHbId)).fow[1].visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(targetHbId), 1).visibility = Visibility::Visible;
 
     // Destroy home harbor
     world.DestroyNO(hbPos);
@@ -461,8 +502,8 @@ BOOST_FIXTURE_TEST_CASE(LongDistanceTravel, ShipReadyFixtureBig)
     harbor.AddGoods(newScouts, true);
     // We want the ship to only scout unexplored harbors, so set all but one to visible
     for(unsigned i = 1; i <= 8; i++)
-        world.GetNodeWriteable(world.GetHarborPoint(i)).fow[curPlayer].visibility = Visibility::Visible;
-    world.GetNodeWriteable(world.GetHarborPoint(targetHbId)).fow[curPlayer].visibility = Visibility::Invisible;
+        world.GetFoWNodeWriteable(world.GetHarborPoint(i), curPlayer).visibility = Visibility::Visible;
+    world.GetFoWNodeWriteable(world.GetHarborPoint(targetHbId), curPlayer).visibility = Visibility::Invisible;
     // Start an exploration expedition
     this->StartStopExplorationExpedition(hbPos, true);
     BOOST_TEST_REQUIRE(harbor.IsExplorationExpeditionActive());
@@ -2,11 +2,14 @@
 //
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "EventManager.h"
+#include "Game.h"
 #include "GameCommands.h"
 #include "GameEvent.h"
 #include "GamePlayer.h"
 #include "PointOutput.h"
 #include "Replay.h"
+#include "RttrConfig.h"
 #include "RttrForeachPt.h"
 #include "Savegame.h"
 #include "SerializedGameData.h"
@@ -17,9 +20,15 @@
 #include "factories/BuildingFactory.h"
 #include "factories/GameCommandFactory.h"
 #include "figures/nofHunter.h"
+#include "files.h"
 #include "helpers/format.hpp"
+#include "network/ClientInterface.h"
+#include "network/GameClient.h"
 #include "network/GameMessage_Chat.h"
 #include "network/PlayerGameCommands.h"
+#include "random/Random.h"
+#include "test/testConfig.h"
+#include "uiHelper/uiHelpers.hpp"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/MockLocalGameState.h"
 #include "worldFixtures/WorldFixture.h"
@@ -30,6 +39,7 @@
 #include "gameTypes/GameTypesOutput.h"
 #include "gameTypes/MapInfo.h"
 #include "s25util/tmpFile.h"
+#include <rttr/test/LogAccessor.hpp>
 #include <rttr/test/random.hpp>
 #include <rttr/test/testHelpers.hpp>
 #include <boost/filesystem/operations.hpp>
@@ -649,6 +659,224 @@ BOOST_FIXTURE_TEST_CASE(ReplayWithSavegame, RandWorldFixture)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(ReplayWithKeyframes, RandWorldFixture)
+{
+    MapInfo map;
+    map.type = MapType::Savegame;
+    map.title = "MapTitle";
+    map.filepath = "Map.swd";
+    map.savegame = std::make_unique<Savegame>();
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        map.savegame->AddPlayer(world.GetPlayer(i));
+    map.savegame->ggs = ggs;
+    map.savegame->start_gf = em.GetCurrentGF();
+    map.savegame->sgd.MakeSnapshot(*game);
+
+    Replay replay;
+    for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        replay.AddPlayer(world.GetPlayer(i));
+    replay.random_init = 815;
+    replay.SetKeyframeInterval(2);
+
+    TmpFile tmpFile;
+    BOOST_TEST_REQUIRE(tmpFile.isValid());
+    tmpFile.close();
+    bfs::remove(tmpFile.filePath);
+    BOOST_TEST_REQUIRE(replay.StartRecording(tmpFile.filePath, map));
+
+    BOOST_TEST(!replay.IsKeyframeDue(0));
+    BOOST_TEST(!replay.IsKeyframeDue(1));
+    BOOST_TEST(replay.IsKeyframeDue(2));
+    BOOST_TEST(!replay.IsKeyframeDue(3));
+
+    PlayerGameCommands cmds = GetTestCommands().create(*game).result;
+    replay.UpdateLastGF(1);
+    replay.AddChatCommand(1, 2, ChatDestination::Enemies, "Hello");
+    // Keyframe at GF 2 with a different state than the initial one
+    world.GetNodeWriteable(MapPoint(1, 2)).altitude = 42;
+    SerializedGameData keyframeSgd;
+    keyframeSgd.MakeSnapshot(*game);
+    const UsedPRNG rngState(rttr::test::randomValue<uint64_t>());
+    replay.AddKeyframe(2, rngState, keyframeSgd);
+    BOOST_TEST(!replay.IsKeyframeDue(2));
+    BOOST_TEST(replay.IsKeyframeDue(4));
+    replay.AddGameCommand(2, 0, cmds);
+    replay.AddChatCommand(3, 2, ChatDestination::Allies, "Hello2");
+    replay.AddKeyframe(4, UsedPRNG(), map.savegame->sgd);
+    replay.AddChatCommand(5, 3, ChatDestination::All, "Hello3");
+    replay.UpdateLastGF(5);
+    BOOST_TEST_REQUIRE(replay.StopRecording());
+
+    Replay loadReplay;
+    BOOST_TEST_REQUIRE(loadReplay.LoadHeader(tmpFile.filePath));
+    MapInfo newMap;
+    BOOST_TEST_REQUIRE(loadReplay.LoadGameData(newMap));
+    BOOST_TEST_REQUIRE(loadReplay.GetKeyframes().size() == 2u);
+    BOOST_TEST(loadReplay.GetKeyframes()[0].gf == 2u);
+    BOOST_TEST(loadReplay.GetKeyframes()[1].gf == 4u);
+    // The game data is unchanged
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(newMap.savegame->sgd.GetData(),
+                                    newMap.savegame->sgd.GetData() + newMap.savegame->sgd.GetLength(),
+                                    map.savegame->sgd.GetData(),
+                                    map.savegame->sgd.GetData() + map.savegame->sgd.GetLength());
+
+    BOOST_TEST(!loadReplay.FindKeyframe(0));
+    BOOST_TEST(!loadReplay.FindKeyframe(1));
+    BOOST_TEST(loadReplay.FindKeyframe(2) == &loadReplay.GetKeyframes()[0]);
+    BOOST_TEST(loadReplay.FindKeyframe(3) == &loadReplay.GetKeyframes()[0]);
+    BOOST_TEST(loadReplay.FindKeyframe(4) == &loadReplay.GetKeyframes()[1]);
+    BOOST_TEST(loadReplay.FindKeyframe(100) == &loadReplay.GetKeyframes()[1]);
+
+    const ReplayKeyframe& keyframe = *loadReplay.FindKeyframe(3);
+    SerializedGameData loadedSgd;
+    UsedPRNG loadedRngState;
+    BOOST_TEST_REQUIRE(loadReplay.LoadKeyframe(keyframe, loadedSgd, loadedRngState));
+    BOOST_TEST(loadedRngState == rngState);
+    BOOST_REQUIRE_EQUAL_COLLECTIONS(loadedSgd.GetData(), loadedSgd.GetData() + loadedSgd.GetLength(),
+                                    keyframeSgd.GetData(), keyframeSgd.GetData() + keyframeSgd.GetLength());
+
+    // Commands continue at the keyframe GF
+    loadReplay.SeekToKeyframe(keyframe);
+    unsigned gf;
+    BOOST_TEST_REQUIRE(loadReplay.ReadGF(&gf));
+    BOOST_TEST(gf == 2u);
+    BOOST_TEST_REQUIRE(loadReplay.ReadRCType() == ReplayCommand::Game);
+    uint8_t player;
+    PlayerGameCommands loadedCmds;
+    loadReplay.ReadGameCommand(player, loadedCmds);
+    BOOST_TEST(player == 0u);
+    BOOST_TEST(loadedCmds.gcs.size() == cmds.gcs.size());
+    BOOST_TEST_REQUIRE(loadReplay.ReadGF(&gf));
+    BOOST_TEST(gf == 3u);
+
+    // Seeking backwards works too
+    loadReplay.SeekToKeyframe(loadReplay.GetKeyframes()[1]);
+    BOOST_TEST_REQUIRE(loadReplay.ReadGF(&gf));
+    BOOST_TEST(gf == 5u);
+    loadReplay.SeekToKeyframe(loadReplay.GetKeyframes()[0]);
+    BOOST_TEST_REQUIRE(loadReplay.ReadGF(&gf));
+    BOOST_TEST(gf == 2u);
+}
+
+namespace {
+/// Remembers the game started by the client
+struct GameLoadingObserver : ClientInterface
+{
+    std::weak_ptr<Game> game;
+    unsigned startGF = 0;
+    void CI_GameLoading(std::shared_ptr<Game> newGame) override
+    {
+        game = newGame;
+        startGF = newGame->em_->GetCurrentGF();
+    }
+};
+
+std::vector<char> makeSnapshot(const std::weak_ptr<Game>& game)
+{
+    SerializedGameData sgd;
+    sgd.MakeSnapshot(*game.lock());
+    return std::vector<char>(sgd.GetData(), sgd.GetData() + sgd.GetLength());
+}
+
+struct SeekReplayFixture : uiHelper::Fixture
+{
+    boost::filesystem::path oldUserData;
+    TmpFolder tmpUserdata;
+    GameLoadingObserver observer;
+    MapInfo map;
+    std::vector<PlayerInfo> players;
+
+    SeekReplayFixture() : tmpUserdata(rttr::test::rttrTestDataDirOut), players(3)
+    {
+        oldUserData = RTTRCONFIG.ExpandPath("<RTTR_USERDATA>");
+        RTTRCONFIG.overridePathMapping("USERDATA", tmpUserdata);
+        bfs::create_directories(RTTRCONFIG.ExpandPath(s25::folders::mapsPlayed));
+        GAMECLIENT.SetInterface(&observer);
+
+        map.type = MapType::OldMap;
+        map.title = "LuaFunctions";
+        map.filepath = rttr::test::rttrBaseDir / "tests" / "testData" / "maps" / "LuaFunctions.SWD";
+        BOOST_TEST_REQUIRE(map.mapData.CompressFromFile(map.filepath, &map.mapChecksum));
+        players[0].ps = PlayerState::Occupied;
+        players[0].name = "Player";
+        players[1].ps = players[2].ps = PlayerState::Locked;
+    }
+    ~SeekReplayFixture()
+    {
+        GAMECLIENT.Stop();
+        GAMECLIENT.SetInterface(nullptr);
+        RTTRCONFIG.overridePathMapping("USERDATA", oldUserData);
+    }
+
+    /// Record a replay of 100 GFs containing only chat messages and optionally a keyframe at GF 20
+    boost::filesystem::path recordReplay(const TmpFile& file, const SerializedGameData* keyframeSgd = nullptr,
+                                         const UsedPRNG& keyframeRngState = UsedPRNG())
+    {
+        bfs::remove(file.filePath);
+        Replay replay;
+        for(const PlayerInfo& player : players)
+            replay.AddPlayer(player);
+        replay.random_init = 815;
+        BOOST_TEST_REQUIRE(replay.StartRecording(file.filePath, map));
+        replay.UpdateLastGF(10);
+        replay.AddChatCommand(10, 0, ChatDestination::All, "Hello");
+        if(keyframeSgd)
+            replay.AddKeyframe(20, keyframeRngState, *keyframeSgd);
+        replay.UpdateLastGF(30);
+        replay.AddChatCommand(30, 0, ChatDestination::All, "Hello2");
+        replay.UpdateLastGF(100);
+        BOOST_TEST_REQUIRE(replay.StopRecording());
+        return file.filePath;
+    }
+};
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(SeekReplay, SeekReplayFixture)
+{
+    rttr::test::LogAccessor logAcc;
+    TmpFile replayFile, keyframeReplayFile;
+    BOOST_TEST_REQUIRE(replayFile.isValid());
+    BOOST_TEST_REQUIRE(keyframeReplayFile.isValid());
+    replayFile.close();
+    keyframeReplayFile.close();
+
+    BOOST_TEST_REQUIRE(GAMECLIENT.StartReplay(recordReplay(replayFile)));
+    BOOST_TEST(GAMECLIENT.GetGFNumber() == 0u);
+    // Without keyframes only seeking backwards restarts the replay
+    BOOST_TEST(!GAMECLIENT.ShouldSeekReplay(40));
+    BOOST_TEST_REQUIRE(GAMECLIENT.SeekReplay(20));
+    BOOST_TEST(GAMECLIENT.GetGFNumber() == 20u);
+    BOOST_TEST(observer.startGF == 0u);
+    SerializedGameData keyframeSgd;
+    keyframeSgd.MakeSnapshot(*observer.game.lock());
+    const UsedPRNG keyframeRngState = RANDOM.GetCurrentState();
+
+    BOOST_TEST_REQUIRE(GAMECLIENT.SeekReplay(40));
+    BOOST_TEST(GAMECLIENT.GetGFNumber() == 40u);
+    const std::vector<char> expectedState = makeSnapshot(observer.game);
+
+    BOOST_TEST(GAMECLIENT.ShouldSeekReplay(5));
+    BOOST_TEST_REQUIRE(GAMECLIENT.SeekReplay(5));
+    BOOST_TEST(GAMECLIENT.GetGFNumber() == 5u);
+    BOOST_TEST_REQUIRE(GAMECLIENT.SeekReplay(40));
+    BOOST_TEST(GAMECLIENT.GetGFNumber() == 40u);
+    BOOST_TEST(makeSnapshot(observer.game) == expectedState);
+    logAcc.clearLog();
+    GAMECLIENT.Stop();
+
+    // Seeking over a keyframe starts from it and results in the same state
+    BOOST_TEST_REQUIRE(GAMECLIENT.StartReplay(recordReplay(keyframeReplayFile, &keyframeSgd, keyframeRngState)));
+    BOOST_TEST(!GAMECLIENT.ShouldSeekReplay(15));
+    BOOST_TEST(GAMECLIENT.ShouldSeekReplay(40));
+    BOOST_TEST_REQUIRE(GAMECLIENT.SeekReplay(40));
+    BOOST_TEST(observer.startGF == 20u);
+    BOOST_TEST(GAMECLIENT.GetGFNumber() == 40u);
+    BOOST_TEST(makeSnapshot(observer.game) == expectedState);
+    logAcc.clearLog();
+    // Close the replay before the files get removed
+    GAMECLIENT.Stop();
+}
+
 BOOST_FIXTURE_TEST_CASE(SerializeHunter, EmptyWorldFixture1P)
 {
     SerializedGameData sgd;
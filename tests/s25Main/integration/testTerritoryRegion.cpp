@@ -310,4 +310,50 @@ BOOST_FIXTURE_TEST_CASE(CreateTerritoryRegion, WorldFixtureEmpty2P)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(MilitaryInfluenceMatchesRegion, WorldFixtureEmpty2P)
+{
+    const auto checkInfluence = [this]() {
+        TerritoryRegion region(Position(0, 0), Extent(world.GetSize()), world);
+        for(const nobBaseMilitary* bld : world.LookForMilitaryBuildings(MapPoint(0, 0), 99))
+            region.CalcTerritoryOfBuilding(*bld);
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            BOOST_TEST_INFO(pt);
+            BOOST_TEST_REQUIRE(world.GetMilitaryInfluence().GetOwner(world.GetIdx(pt))
+                               == region.GetOwner(Position(pt)));
+        }
+    };
+    checkInfluence();
+
+    const MapPoint hqPos = world.GetPlayer(0).GetHQPos();
+    const std::array<MapPoint, 3> milBldPos = {world.MakeMapPoint(hqPos + Position(2, 0)),
+                                               world.MakeMapPoint(hqPos + Position(7, 4)),
+                                               world.MakeMapPoint(hqPos + Position(7, -4))};
+    std::array<nobMilitary*, 3> milBlds;
+    for(unsigned i = 0; i < milBldPos.size(); i++)
+    {
+        milBlds[i] = static_cast<nobMilitary*>(BuildingFactory::CreateBuilding(
+          world, BuildingType::Barracks, milBldPos[i], (i == 0) ? 0 : 1, Nation::Africans));
+    }
+    // Not occupied -> No territory
+    checkInfluence();
+    // bld 0 last as it would destroy others
+    for(int i = 2; i >= 0; --i)
+    {
+        const MapPoint flagPt = milBlds[i]->GetFlagPos();
+        world
+          .AddFigure(flagPt,
+                     std::make_unique<nofPassiveSoldier>(flagPt, milBlds[i]->GetPlayer(), milBlds[i], milBlds[i], 0))
+          .ActAtFirst();
+    }
+    RTTR_SKIP_GFS(30);
+    checkInfluence();
+
+    // The nodes of a destroyed building go to the remaining ones
+    world.DestroyNO(milBldPos[1]);
+    checkInfluence();
+    world.DestroyNO(milBldPos[0]);
+    checkInfluence();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
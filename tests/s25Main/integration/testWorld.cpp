@@ -5,19 +5,30 @@
 #include "FileChecksum.h"
 #include "GamePlayer.h"
 #include "PointOutput.h"
+#include "RTTR_AssertError.h"
 #include "RttrConfig.h"
 #include "RttrForeachPt.h"
+#include "buildings/nobUsual.h"
+#include "factories/BuildingFactory.h"
 #include "files.h"
+#include "figures/nofScout_Free.h"
 #include "lua/GameDataLoader.h"
 #include "worldFixtures/CreateEmptyWorld.h"
 #include "worldFixtures/MockLocalGameState.h"
 #include "worldFixtures/WorldFixture.h"
+#include "world/BQCalculator.h"
 #include "world/MapLoader.h"
+#include "nodeObjs/noAnimal.h"
 #include "nodeObjs/noBase.h"
+#include "nodeObjs/noFlag.h"
+#include "nodeObjs/noGranite.h"
 #include "gameTypes/GameTypesOutput.h"
+#include "gameData/MilitaryConsts.h"
+#include "gameData/WorldDescription.h"
 #include "libsiedler2/ArchivItem_Map.h"
 #include "libsiedler2/ArchivItem_Map_Header.h"
 #include "rttr/test/LogAccessor.hpp"
+#include "rttr/test/random.hpp"
 #include "s25util/tmpFile.h"
 #include <boost/filesystem/path.hpp>
 #include <boost/test/unit_test.hpp>
@@ -131,6 +142,89 @@ BOOST_FIXTURE_TEST_CASE(SameBQasInS2, WorldLoadedWithS2MapFixture)
     }
 }
 
+namespace {
+/// Terrain part of the BQ calculation done per point, as it was before the terrain BQs were precalculated
+BuildingQuality calcTerrainBQReference(const World& world, const MapPoint pt, const bool flagOnly)
+{
+    unsigned building_hits = 0;
+    unsigned mine_hits = 0;
+    unsigned flag_hits = 0;
+
+    const WorldDescription& desc = world.GetDescription();
+    if(flagOnly)
+    {
+        bool flagPossible = false;
+        for(const DescIdx<TerrainDesc> tIdx : world.GetTerrainsAround(pt))
+        {
+            TerrainBQ bq = desc.get(tIdx).GetBQ();
+            if(bq == TerrainBQ::Danger)
+                return BuildingQuality::Nothing;
+            else if(bq != TerrainBQ::Nothing)
+                flagPossible = true;
+        }
+        return flagPossible ? BuildingQuality::Flag : BuildingQuality::Nothing;
+    }
+    for(const DescIdx<TerrainDesc> tIdx : world.GetTerrainsAround(pt))
+    {
+        TerrainBQ bq = desc.get(tIdx).GetBQ();
+        if(bq == TerrainBQ::Castle)
+            ++building_hits;
+        else if(bq == TerrainBQ::Mine)
+            ++mine_hits;
+        else if(bq == TerrainBQ::Flag)
+            ++flag_hits;
+        else if(bq == TerrainBQ::Danger)
+            return BuildingQuality::Nothing;
+    }
+
+    if(mine_hits == 6)
+        return BuildingQuality::Mine;
+    else if(building_hits == 6)
+        return BuildingQuality::Castle;
+    else if(flag_hits || mine_hits || building_hits)
+        return BuildingQuality::Flag;
+    else
+        return BuildingQuality::Nothing;
+}
+
+void checkTerrainBQs(const GameWorld& world)
+{
+    const std::vector<BuildingQuality> terrainBQs = BQCalculator::CalcTerrainBQs(world);
+    BOOST_TEST_REQUIRE(terrainBQs.size() == prodOfComponents(world.GetSize()));
+    const BQCalculator calcBQ(world);
+    const BQCalculator calcBQPrecalculated(world, terrainBQs);
+    const auto isOnRoad = [&world](const MapPoint& pt) { return world.IsOnRoad(pt); };
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        BOOST_TEST_INFO("pt " << pt);
+        const BuildingQuality terrainBQ = terrainBQs[world.GetIdx(pt)];
+        BOOST_TEST(terrainBQ == calcTerrainBQReference(world, pt, false));
+        // A flag is possible if the terrain allows anything
+        BOOST_TEST((terrainBQ == BuildingQuality::Nothing ? BuildingQuality::Nothing : BuildingQuality::Flag)
+                   == calcTerrainBQReference(world, pt, true));
+        // Using the precalculated terrain BQs yields the same result as the calculation per point
+        BOOST_TEST(calcBQPrecalculated(pt, isOnRoad) == calcBQ(pt, isOnRoad));
+        BOOST_TEST(calcBQPrecalculated(pt, isOnRoad, true) == calcBQ(pt, isOnRoad, true));
+    }
+}
+} // namespace
+
+BOOST_FIXTURE_TEST_CASE(TerrainBQsForWholeMap, WorldLoadedWithS2MapFixture)
+{
+    world.InitAfterLoad();
+    checkTerrainBQs(world);
+
+    // Random terrains to get all combinations of terrain BQs
+    const unsigned numTerrains = world.GetDescription().terrain.size();
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        MapNode& node = world.GetNodeWriteable(pt);
+        node.t1 = DescIdx<TerrainDesc>(rttr::test::randomValue(0u, numTerrains - 1u));
+        node.t2 = DescIdx<TerrainDesc>(rttr::test::randomValue(0u, numTerrains - 1u));
+    }
+    checkTerrainBQs(world);
+}
+
 BOOST_FIXTURE_TEST_CASE(HQPlacement, WorldLoaded1PFixture)
 {
     GamePlayer& player = world.GetPlayer(0);
@@ -227,6 +321,15 @@ BOOST_FIXTURE_TEST_CASE(CloseHarborSpots, WorldFixture<UninitializedWorldCreator
                 std::vector<Direction> route;
                 BOOST_TEST_REQUIRE((startPt == destPt || world.FindShipPath(startPt, destPt, 10000, &route, nullptr)));
                 BOOST_TEST_REQUIRE(route.size() == world.CalcHarborDistance(startHb, targetHb));
+                // Stored routes from the harbor are the same as the searched ones
+                for(unsigned i = 0; i < 2 && startPt != destPt; i++)
+                {
+                    std::vector<Direction> harborRoute;
+                    unsigned length;
+                    BOOST_TEST_REQUIRE(world.FindShipPathToHarbor(startPt, targetHb, seaId, &harborRoute, &length));
+                    BOOST_TEST(harborRoute == route, boost::test_tools::per_element());
+                    BOOST_TEST(length == route.size());
+                }
             }
         }
     }
@@ -247,6 +350,152 @@ BOOST_FIXTURE_TEST_CASE(NONothingOnEmptyNode, WorldFixtureEmpty1P)
     BOOST_TEST(world.GetGOT(emptySpot) == GO_Type::Nothing);
 }
 
+using WorldFixtureEmpty2P = WorldFixture<CreateEmptyWorld, 2>;
+BOOST_FIXTURE_TEST_CASE(FoWNodesPerPlayer, WorldFixtureEmpty2P)
+{
+    // Only existing players have FoW data
+    BOOST_TEST(world.GetNumFoWPlayers() == 2u);
+    const MapPoint pt(3, 4);
+    world.SetVisibility(pt, 1, Visibility::FogOfWar, 42);
+    BOOST_TEST(world.GetFoWNode(pt, 1).visibility == Visibility::FogOfWar);
+    BOOST_TEST(world.GetFoWNode(pt, 1).last_update_time == 42u);
+    // Other players and neighbouring points are unaffected
+    BOOST_TEST(world.GetFoWNode(pt, 0).visibility != Visibility::FogOfWar);
+    BOOST_TEST(world.GetFoWNode(world.GetNeighbour(pt, Direction::East), 1).visibility != Visibility::FogOfWar);
+}
+
+BOOST_FIXTURE_TEST_CASE(StateHashTracksChanges, WorldFixtureEmpty2P)
+{
+    const StateHash& stateHash = world.GetStateHash();
+    const unsigned initialHash = stateHash.Get();
+    BOOST_TEST(initialHash != 0u);
+    // Incrementally updated hash is the same as a new calculation
+    const auto checkHash = [&]() {
+        const unsigned curHash = stateHash.Get();
+        world.RecalcStateHash();
+        BOOST_TEST(stateHash.Get() == curHash);
+    };
+
+    const MapPoint pt(3, 4);
+    world.SetOwner(pt, 2);
+    const unsigned ownerHash = stateHash.Get();
+    BOOST_TEST(ownerHash != initialHash);
+    checkHash();
+    world.SetNO(pt, new noGranite(GraniteType::One, 1));
+    BOOST_TEST(stateHash.Get() != ownerHash);
+    checkHash();
+    world.SetPointRoad(pt, Direction::East, PointRoad::Normal);
+    checkHash();
+    world.GetPlayer(1).IncreaseInventoryWare(GoodType::Wood, 5);
+    world.GetPlayer(0).IncreaseInventoryJob(Job::Woodcutter, 2);
+    checkHash();
+
+    // Reverting all changes restores the hash
+    world.GetPlayer(0).DecreaseInventoryJob(Job::Woodcutter, 2);
+    world.GetPlayer(1).DecreaseInventoryWare(GoodType::Wood, 5);
+    world.SetPointRoad(pt, Direction::East, PointRoad::None);
+    world.DestroyNO(pt);
+    BOOST_TEST(stateHash.Get() == ownerHash);
+    world.SetOwner(pt, 0);
+    BOOST_TEST(stateHash.Get() == initialHash);
+
+    // Figure positions
+    auto& figure = world.AddFigure(pt, std::make_unique<noAnimal>(Species::Sheep, pt));
+    const unsigned figureHash = stateHash.Get();
+    BOOST_TEST(figureHash != initialHash);
+    checkHash();
+    const MapPoint nbPt = world.GetNeighbour(pt, Direction::East);
+    world.AddFigure(nbPt, world.RemoveFigure(pt, figure));
+    BOOST_TEST(stateHash.Get() != figureHash);
+    checkHash();
+    world.AddFigure(pt, world.RemoveFigure(nbPt, figure));
+    BOOST_TEST(stateHash.Get() == figureHash);
+}
+
+BOOST_FIXTURE_TEST_CASE(ViewersTrackVisionSources, WorldFixtureEmpty2P)
+{
+    const auto getViewers = [&]() {
+        std::vector<unsigned> viewers;
+        RTTR_FOREACH_PT(MapPoint, world.GetSize())
+        {
+            for(unsigned player = 0; player < world.GetNumPlayers(); ++player)
+                viewers.push_back(world.GetNumViewers(pt, player));
+        }
+        return viewers;
+    };
+    // Incrementally updated viewers are the same as a new calculation
+    const auto checkViewers = [&]() {
+        const std::vector<unsigned> viewers = getViewers();
+        world.RecalcViewers();
+        BOOST_TEST((getViewers() == viewers));
+    };
+
+    // The HQ sees its surroundings
+    const MapPoint hqPos = world.GetPlayer(0).GetHQPos();
+    BOOST_TEST(world.GetNumViewers(hqPos, 0) == 1u);
+    checkViewers();
+
+    const MapPoint flagPos = world.GetNeighbour(hqPos, Direction::SouthEast);
+    MapPoint westPt = flagPos;
+    for(unsigned i = 0; i < VISUALRANGE_SCOUT; i++)
+        westPt = world.GetNeighbour(westPt, Direction::West);
+    const unsigned numFlagViewers = world.GetNumViewers(flagPos, 1);
+    const unsigned numWestViewers = world.GetNumViewers(westPt, 1);
+    auto& scout =
+      world.AddFigure(flagPos, std::make_unique<nofScout_Free>(flagPos, 1, world.GetSpecObj<noRoadNode>(flagPos)));
+    BOOST_TEST(world.GetNumViewers(flagPos, 1) == numFlagViewers + 1u);
+    BOOST_TEST(world.GetNumViewers(westPt, 1) == numWestViewers + 1u);
+    checkViewers();
+
+    // After moving east the scout does not see the west-most point anymore
+    const MapPoint eastPt = world.GetNeighbour(flagPos, Direction::East);
+    world.AddFigure(eastPt, world.RemoveFigure(flagPos, scout));
+    BOOST_TEST(world.GetNumViewers(flagPos, 1) == numFlagViewers + 1u);
+    BOOST_TEST(world.GetNumViewers(westPt, 1) == numWestViewers);
+    checkViewers();
+
+    // A lookout tower sees while it has a worker, i.e. from the arrival of the scout until it leaves
+    const MapPoint towerFlagPos = world.MakeMapPoint(flagPos + Position(4, 0));
+    const MapPoint towerPos = world.GetNeighbour(towerFlagPos, Direction::NorthWest);
+    auto* tower = static_cast<nobUsual*>(
+      BuildingFactory::CreateBuilding(world, BuildingType::LookoutTower, towerPos, 0, Nation::Romans));
+    BOOST_TEST_REQUIRE(tower);
+    const unsigned numTowerViewers = world.GetNumViewers(towerPos, 0);
+    world.BuildRoad(0, false, flagPos, std::vector<Direction>(4, Direction::East));
+    for(unsigned gf = 0; gf < 1000 && !tower->HasWorker(); gf++)
+    {
+        BOOST_TEST_REQUIRE(world.GetNumViewers(towerPos, 0) == numTowerViewers);
+        em.ExecuteNextGF();
+    }
+    BOOST_TEST_REQUIRE(tower->HasWorker());
+    BOOST_TEST(world.GetNumViewers(towerPos, 0) == numTowerViewers + 1u);
+    checkViewers();
+    world.DestroyNO(towerPos);
+    BOOST_TEST(world.GetNumViewers(towerPos, 0) == numTowerViewers);
+    checkViewers();
+}
+
+#if RTTR_ENABLE_ASSERTS
+BOOST_FIXTURE_TEST_CASE(NoChangesWhileAIsRun, WorldFixtureEmpty1P)
+{
+    rttr::test::LogAccessor logAcc;
+    const MapPoint pt = world.MakeMapPoint(world.GetPlayer(0).GetHQPos() - Position(3, 0));
+    const BuildingQuality bq = world.GetNode(pt).bq;
+    {
+        const World::AIRunScope aiRunScope(world);
+        BOOST_TEST(world.AreAIsRunning());
+        RTTR_REQUIRE_ASSERT(world.SetNO(pt, nullptr));
+        RTTR_REQUIRE_ASSERT(world.GetNodeWriteable(pt));
+        RTTR_REQUIRE_ASSERT(world.RecalcBQ(pt));
+        RTTR_REQUIRE_ASSERT(world.GetUpToDateBQ(pt));
+        // Reading is allowed
+        BOOST_TEST(world.GetNode(pt).bq == bq);
+    }
+    BOOST_TEST(!world.AreAIsRunning());
+    world.RecalcBQ(pt);
+}
+#endif
+
 BOOST_FIXTURE_TEST_CASE(LoadLua, WorldFixture<UninitializedWorldCreator>)
 {
     MapLoader loader(world);
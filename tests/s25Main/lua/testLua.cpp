@@ -795,10 +795,9 @@ BOOST_AUTO_TEST_CASE(onExplored)
     std::map<int, Points> gamePtsPerPlayer;
     RTTR_FOREACH_PT(MapPoint, world.GetSize())
     {
-        const MapNode& node = world.GetNode(pt);
         for(unsigned i = 0; i < world.GetNumPlayers(); i++)
         {
-            if(node.fow[i].visibility == Visibility::Visible)
+            if(world.GetFoWNode(pt, i).visibility == Visibility::Visible)
                 gamePtsPerPlayer[i].push_back(std::pair<int, int>(pt.x, pt.y));
         }
     }
@@ -814,6 +813,129 @@ BOOST_AUTO_TEST_CASE(onExplored)
     }
 }
 
+BOOST_AUTO_TEST_CASE(onExploredAndOccupiedBatch)
+{
+    executeLua("explored = {}\n\
+    occupied = {}\n\
+    numCalls = 0\n\
+    function addPoints(pointsPerPlayer, player_id, points)\n\
+        local ptsOfPlayer = pointsPerPlayer[player_id] or {}\n\
+        for _, pt in ipairs(points) do\n\
+            table.insert(ptsOfPlayer, {pt.x, pt.y})\n\
+        end\n\
+        pointsPerPlayer[player_id] = ptsOfPlayer\n\
+        numCalls = numCalls + 1\n\
+    end\n\
+    function onExploredBatch(player_id, points) addPoints(explored, player_id, points) end\n\
+    function onOccupiedBatch(player_id, points) addPoints(occupied, player_id, points) end");
+    initWorld();
+    LuaInterfaceGame& lua = world.GetLua();
+    // Delivered at the next GF
+    BOOST_TEST(isLuaEqual("numCalls", "0"));
+    lua.EventGameFrame(0);
+
+    using Points = std::vector<std::pair<int, int>>;
+    std::map<int, Points> exploredPtsPerPlayer, occupiedPtsPerPlayer;
+    RTTR_FOREACH_PT(MapPoint, world.GetSize())
+    {
+        for(unsigned i = 0; i < world.GetNumPlayers(); i++)
+        {
+            if(world.GetFoWNode(pt, i).visibility == Visibility::Visible)
+                exploredPtsPerPlayer[i].push_back(std::pair<int, int>(pt.x, pt.y));
+        }
+        const uint8_t owner = world.GetNode(pt).owner;
+        if(owner)
+            occupiedPtsPerPlayer[owner - 1].push_back(std::pair<int, int>(pt.x, pt.y));
+    }
+    // Once per player and event
+    const auto numCalls = std::to_string(exploredPtsPerPlayer.size() + occupiedPtsPerPlayer.size());
+    BOOST_TEST(isLuaEqual("numCalls", numCalls));
+    for(const auto* gamePtsPerPlayer : {&exploredPtsPerPlayer, &occupiedPtsPerPlayer})
+    {
+        std::map<int, Points> luaPtsPerPlayer =
+          getLuaState()[gamePtsPerPlayer == &exploredPtsPerPlayer ? "explored" : "occupied"];
+        BOOST_TEST_REQUIRE(luaPtsPerPlayer.size() == gamePtsPerPlayer->size());
+        for(const auto& playerAndPts : *gamePtsPerPlayer)
+        {
+            Points gamePts = playerAndPts.second;
+            Points& luaPts = luaPtsPerPlayer[playerAndPts.first];
+            std::sort(gamePts.begin(), gamePts.end());
+            std::sort(luaPts.begin(), luaPts.end());
+            BOOST_TEST_REQUIRE(luaPts == gamePts, boost::test_tools::per_element());
+        }
+    }
+    // Nothing new -> No calls
+    lua.EventGameFrame(1);
+    BOOST_TEST(isLuaEqual("numCalls", numCalls));
+
+    // Owner is passed like for onExplored
+    executeLua("function onExploredBatch(player_id, points)\n\
+        for _, pt in ipairs(points) do rttr:Log(player_id..':'..pt.x..','..pt.y..':'..tostring(pt.owner)) end\n\
+    end");
+    lua.EventExplored(1, MapPoint(2, 3), 0);
+    lua.EventExplored(1, MapPoint(4, 5), 2);
+    BOOST_TEST(getLog() == "");
+    lua.EventGameFrame(2);
+    BOOST_TEST(getLog() == "1:2,3:nil\n1:4,5:1\n");
+
+    // Pending points are saved and restored
+    lua.EventExplored(0, MapPoint(6, 7), 1);
+    lua.EventOccupied(2, MapPoint(8, 9));
+    Serializer ser;
+    lua.SerializeBatchedEvents(ser);
+    executeLua("function onOccupiedBatch(player_id, points)\n\
+        for _, pt in ipairs(points) do rttr:Log('occ:'..player_id..':'..pt.x..','..pt.y) end\n\
+    end");
+    lua.EventGameFrame(3);
+    BOOST_TEST(getLog() == "0:6,7:0\nocc:2:8,9\n");
+    lua.EventGameFrame(4);
+    BOOST_TEST(getLog() == "");
+    lua.DeserializeBatchedEvents(ser);
+    lua.EventGameFrame(5);
+    BOOST_TEST(getLog() == "0:6,7:0\nocc:2:8,9\n");
+
+    // Points are dropped if there is no handler at the next GF
+    executeLua("onOccupiedBatch = nil");
+    lua.EventOccupied(1, MapPoint(1, 2));
+    lua.EventGameFrame(6);
+    // A handler set during the GF gets all points since the last one
+    lua.EventOccupied(1, MapPoint(3, 4));
+    executeLua("function onOccupiedBatch(player_id, points)\n\
+        for _, pt in ipairs(points) do rttr:Log('occ:'..player_id..':'..pt.x..','..pt.y) end\n\
+    end");
+    lua.EventGameFrame(7);
+    BOOST_TEST(getLog() == "occ:1:3,4\n");
+}
+
+BOOST_AUTO_TEST_CASE(HandlersChangedDuringEvents)
+{
+    initWorld();
+    LuaInterfaceGame& lua = world.GetLua();
+    // A handler removing itself is not called again
+    executeLua("function onOccupied(player_id, x, y)\n\
+        rttr:Log('occupied')\n\
+        onOccupied = nil\n\
+    end");
+    lua.EventOccupied(0, MapPoint(1, 2));
+    lua.EventOccupied(0, MapPoint(1, 3));
+    BOOST_TEST(getLog() == "occupied\n");
+    // A replaced handler is used immediately
+    executeLua("function onExplored(player_id, x, y)\n\
+        rttr:Log('explored1')\n\
+        onExplored = function() rttr:Log('explored2') end\n\
+    end");
+    lua.EventExplored(0, MapPoint(1, 2), 0);
+    lua.EventExplored(0, MapPoint(1, 3), 0);
+    BOOST_TEST(getLog() == "explored1\nexplored2\n");
+    // Also for handlers defined in onGameFrame
+    executeLua("function onGameFrame(gf)\n\
+        function onResourceFound() rttr:Log('resFound') end\n\
+    end");
+    lua.EventGameFrame(0);
+    lua.EventResourceFound(0, MapPoint(1, 2), ResourceType::Gold, 1);
+    BOOST_TEST(getLog() == "resFound\n");
+}
+
 BOOST_AUTO_TEST_CASE(LuaPacts)
 {
     initWorld();
@@ -0,0 +1,273 @@
+// Copyright (C) 2005 - 2022 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "AsyncChecksum.h"
+#include "JoinPlayerInfo.h"
+#include "RTTR_Version.h"
+#include "network/CreateServerInfo.h"
+#include "network/GameMessage.h"
+#include "network/GameMessageInterface.h"
+#include "network/GameMessage_GameCommand.h"
+#include "network/GameMessages.h"
+#include "network/GameServer.h"
+#include "network/NWFScheduler.h"
+#include "network/NetworkPlayer.h"
+#include "gameTypes/AIInfo.h"
+#include "gameTypes/MapInfo.h"
+#include "gameTypes/ServerType.h"
+#include "test/testConfig.h"
+#include "rttr/test/LogAccessor.hpp"
+#include "rttr/test/random.hpp"
+#include "s25util/SocketSet.h"
+#include "s25util/warningSuppression.h"
+#include <boost/filesystem/path.hpp>
+#include <boost/optional.hpp>
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+const boost::filesystem::path testMapPath =
+  rttr::test::rttrBaseDir / "tests" / "testData" / "maps" / "LuaFunctions.SWD";
+
+/// NWF announced by the server together with the highest ping the server reported up to then
+struct AnnouncedNWF
+{
+    unsigned gf, gfLength, nextNWF;
+    unsigned highestPing;
+    unsigned getLength() const { return nextNWF - gf; }
+};
+
+/// Client talking to the real server over a socket.
+/// It joins and gets ready, replies to pings after an adjustable delay and sends (empty) commands for each announced
+/// NWF right away, i.e. behaves like a client without any lag
+class FakeClient : public GameMessageInterface
+{
+public:
+    NetworkPlayer con;
+    std::string password;
+    unsigned mapChecksum, luaChecksum;
+    /// Time the ping reply is held back to simulate latency
+    std::chrono::milliseconds pingDelay = 0ms;
+
+    /// Set when the server confirmed our ready state
+    bool isReady = false;
+    unsigned numPlayers = 0;
+    unsigned cmdDelay = 0;
+    /// Last reported ping per player
+    std::map<unsigned, unsigned> pings;
+    std::vector<AnnouncedNWF> nwfs;
+
+    FakeClient(std::string password, const MapInfo& mapInfo)
+        : con(GameMessageWithPlayer::NO_PLAYER_ID), password(std::move(password)), mapChecksum(mapInfo.mapChecksum),
+          luaChecksum(mapInfo.luaChecksum)
+    {}
+
+    bool connect(unsigned short port) { return con.socket.Connect("localhost", port, false); }
+
+    void run()
+    {
+        SocketSet set;
+        set.Add(con.socket);
+        if(set.Select(0, 0) > 0)
+            BOOST_TEST_REQUIRE(con.receiveMsgs());
+        con.executeMsgs(*this);
+        if(pingReceived && std::chrono::steady_clock::now() - *pingReceived >= pingDelay)
+        {
+            con.sendMsgAsync(new GameMessage_Pong());
+            pingReceived.reset();
+        }
+        BOOST_TEST_REQUIRE(con.sendMsgs(10));
+    }
+
+    unsigned getHighestPing() const
+    {
+        unsigned result = 0;
+        for(const auto& ping : pings)
+            result = std::max(result, ping.second);
+        return result;
+    }
+
+    RTTR_IGNORE_OVERLOADED_VIRTUAL
+    bool OnGameMessage(const GameMessage_Player_Id& msg) override
+    {
+        con.playerId = msg.player;
+        con.sendMsgAsync(new GameMessage_Server_Type(ServerType::Direct, rttr::version::GetRevision()));
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Server_TypeOK& msg) override
+    {
+        BOOST_TEST_REQUIRE((msg.err_code == GameMessage_Server_TypeOK::StatusCode::Ok));
+        con.sendMsgAsync(new GameMessage_Server_Password(password));
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Server_Password& msg) override
+    {
+        BOOST_TEST_REQUIRE(msg.password == "true");
+        con.sendMsgAsync(new GameMessage_Map_Checksum(mapChecksum, luaChecksum));
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Map_ChecksumOK& msg) override
+    {
+        BOOST_TEST_REQUIRE(msg.correct);
+        con.sendMsgAsync(new GameMessage_Player_Ready(con.playerId, true));
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Player_Ready& msg) override
+    {
+        if(msg.player == con.playerId)
+            isReady = msg.ready;
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Player_List& msg) override
+    {
+        numPlayers = msg.playerInfos.size();
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Ping&) override
+    {
+        pingReceived = std::chrono::steady_clock::now();
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Player_Ping& msg) override
+    {
+        pings[msg.player] = msg.ping;
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Server_Start& msg) override
+    {
+        cmdDelay = msg.cmdDelay;
+        sendEmptyCmds();
+        return true;
+    }
+    bool OnGameMessage(const GameMessage_Server_NWFDone& msg) override
+    {
+        nwfs.push_back(AnnouncedNWF{msg.gf, msg.gf_length, msg.nextNWF, getHighestPing()});
+        sendEmptyCmds();
+        return true;
+    }
+    RTTR_POP_DIAGNOSTIC
+
+private:
+    boost::optional<std::chrono::steady_clock::time_point> pingReceived;
+
+    void sendEmptyCmds()
+    {
+        con.sendMsgAsync(new GameMessage_GameCommand(con.playerId, AsyncChecksum(), std::vector<gc::GameCommandPtr>()));
+    }
+};
+
+/// Run server and clients until the predicate is true or the timeout is reached. Return the predicate result
+template<class T_Pred>
+bool runUntil(std::vector<FakeClient*> clients, T_Pred&& predicate,
+              const std::chrono::steady_clock::duration timeout = 15s)
+{
+    const auto startTime = std::chrono::steady_clock::now();
+    while(!predicate())
+    {
+        if(std::chrono::steady_clock::now() - startTime > timeout)
+            return false;
+        GAMESERVER.Run();
+        for(FakeClient* client : clients)
+            client->run();
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+/// Length the NWF following one with lastLength must have according to the given ping (see NWFScheduler)
+unsigned getExpectedNWFLength(unsigned lastLength, unsigned highestPing, unsigned gfLength)
+{
+    const unsigned requiredLength = std::min<unsigned>(
+      std::max<unsigned>(NWFScheduler::minNWFLength, (highestPing + gfLength - 1u) / gfLength),
+      NWFScheduler::maxNWFLength);
+    return (requiredLength >= lastLength) ? requiredLength : lastLength - 1u;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(GameServerTests)
+
+BOOST_AUTO_TEST_CASE(NWFLengthFollowsMeasuredPings)
+{
+    rttr::test::LogAccessor _suppressLogOutput;
+    MapInfo mapInfo;
+    BOOST_TEST_REQUIRE(mapInfo.mapData.CompressFromFile(testMapPath, &mapInfo.mapChecksum));
+    BOOST_TEST_REQUIRE(mapInfo.luaData.CompressFromFile(boost::filesystem::path(testMapPath).replace_extension("lua"),
+                                                        &mapInfo.luaChecksum));
+
+    const auto hostPw = rttr::test::randString(10);
+    int port = -1;
+    for(unsigned i = 0; i < 10 && port < 0; i++)
+    {
+        const auto curPort = rttr::test::randomValue(1024, 49151);
+        if(GAMESERVER.Start(CreateServerInfo(ServerType::Direct, curPort, "NWFTest"), testMapPath, MapType::OldMap,
+                            hostPw))
+            port = curPort;
+    }
+    BOOST_TEST_REQUIRE(port >= 0);
+
+    FakeClient host(hostPw, mapInfo);
+    FakeClient client("", mapInfo);
+    std::vector<FakeClient*> clients{&host, &client};
+    BOOST_TEST_REQUIRE(host.connect(port));
+    BOOST_TEST_REQUIRE(runUntil(clients, [&host]() { return host.isReady; }));
+    BOOST_TEST_REQUIRE(client.connect(port));
+    BOOST_TEST_REQUIRE(runUntil(clients, [&client]() { return client.isReady; }));
+    BOOST_TEST(host.con.playerId == 0u);
+    BOOST_TEST(client.con.playerId == 1u);
+    // Close the remaining slots and start the game
+    for(unsigned id = 2; id < host.numPlayers; id++)
+        host.con.sendMsgAsync(new GameMessage_Player_State(id, PlayerState::Locked, AI::Info()));
+    host.con.sendMsgAsync(new GameMessage_Countdown(0));
+    BOOST_TEST_REQUIRE(runUntil(clients, [&]() { return host.cmdDelay > 0u && client.cmdDelay > 0u; }));
+
+    // Fast connections: Run the game for some NWFs
+    BOOST_TEST_REQUIRE(runUntil(clients, [&host]() { return host.nwfs.size() >= host.cmdDelay + 5u; }));
+    const unsigned gfLength = host.nwfs.back().gfLength;
+    const unsigned fastLength = host.nwfs.back().getLength();
+
+    // Delayed ping replies of one client are measured and make the NWFs long enough to cover them
+    client.pingDelay = 300ms;
+    BOOST_TEST_REQUIRE(runUntil(clients, [&host]() { return host.pings[1] >= 300u; }));
+    const size_t numNWFs = host.nwfs.size();
+    BOOST_TEST_REQUIRE(runUntil(clients, [&]() { return host.nwfs.size() > numNWFs; }));
+    const unsigned delayedLength = host.nwfs.back().getLength();
+    BOOST_TEST(delayedLength * gfLength >= 300u);
+    BOOST_TEST(delayedLength > fastLength);
+
+    // Without the delay the NWFs get shorter again
+    client.pingDelay = 0ms;
+    BOOST_TEST_REQUIRE(runUntil(clients, [&]() { return host.nwfs.back().getLength() < delayedLength; }));
+
+    // Both clients got the same announcements, each following the previous one with the length chosen from the pings
+    const size_t numCheckedNWFs = host.nwfs.size();
+    BOOST_TEST_REQUIRE(runUntil(clients, [&]() { return client.nwfs.size() >= numCheckedNWFs; }));
+    for(unsigned i = 0; i < numCheckedNWFs; i++)
+    {
+        BOOST_TEST(client.nwfs[i].gf == host.nwfs[i].gf);
+        BOOST_TEST(client.nwfs[i].nextNWF == host.nwfs[i].nextNWF);
+    }
+    for(unsigned i = 1; i < numCheckedNWFs; i++)
+    {
+        const AnnouncedNWF& lastNWF = host.nwfs[i - 1];
+        const AnnouncedNWF& curNWF = host.nwfs[i];
+        BOOST_TEST(curNWF.gf == lastNWF.nextNWF);
+        // The first cmdDelay NWFs are announced at once when the game starts and use the initial length
+        if(i >= host.cmdDelay)
+        {
+            BOOST_TEST(curNWF.getLength()
+                       == getExpectedNWFLength(lastNWF.getLength(), curNWF.highestPing, curNWF.gfLength));
+        }
+    }
+
+    GAMESERVER.Stop();
+}
+
+BOOST_AUTO_TEST_SUITE_END()
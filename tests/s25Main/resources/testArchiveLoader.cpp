@@ -2,6 +2,9 @@
 //
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "Loader.h"
+#include "RttrConfig.h"
+#include "WorkerPool.h"
 #include "resources/ArchiveLoader.h"
 #include "resources/ResolvedFile.h"
 #include "test/testConfig.h"
@@ -17,6 +20,8 @@
 #include <boost/filesystem.hpp>
 #include <boost/nowide/fstream.hpp>
 #include <boost/test/unit_test.hpp>
+#include <string>
+#include <vector>
 
 namespace fs = boost::filesystem;
 
@@ -142,6 +147,31 @@ BOOST_FIXTURE_TEST_CASE(Overrides, CreateTestData)
     logAcc.clearLog();
 }
 
+BOOST_AUTO_TEST_CASE(ConcurrentLoads)
+{
+    rttr::test::LogAccessor logAcc;
+    rttr::test::TmpFolder tmpFolder;
+
+    constexpr unsigned numFiles = 16;
+    std::vector<fs::path> files;
+    for(unsigned i = 0; i < numFiles; i++)
+    {
+        files.push_back(tmpFolder.get() / ("test" + std::to_string(i) + ".GER"));
+        const std::string value = std::to_string(i);
+        BOOST_TEST_REQUIRE(libsiedler2::Write(files.back(), createTxtArchive({value.c_str(), "10"})) == 0);
+    }
+
+    ArchiveLoader loader(LOG);
+    std::vector<libsiedler2::Archiv> archives(numFiles);
+    WorkerPool workers(3);
+    workers.Run(numFiles, [&](unsigned i) { archives[i] = loader.load(ResolvedFile{files[i]}); });
+    for(unsigned i = 0; i < numFiles; i++)
+        BOOST_TEST(compareTxts(archives[i], std::to_string(i) + "|10"));
+
+    // Avoid log cluttering
+    logAcc.clearLog();
+}
+
 BOOST_AUTO_TEST_CASE(BobOverrides)
 {
     rttr::test::LogAccessor logAcc;
@@ -187,4 +217,41 @@ BOOST_AUTO_TEST_CASE(BobOverrides)
     logAcc.clearLog();
 }
 
+BOOST_AUTO_TEST_CASE(LoadFilesLikeSequentialLoads)
+{
+    rttr::test::LogAccessor logAcc;
+    rttr::test::TmpFolder tmpFolder;
+
+    const fs::path folder1 = tmpFolder.get() / "folder1";
+    const fs::path folder2 = tmpFolder.get() / "folder2";
+    fs::create_directory(folder1);
+    fs::create_directory(folder2);
+    // Same resource id
+    const std::string file1 = (folder1 / "test.GER").string();
+    const std::string file2 = (folder2 / "test.GER").string();
+    const std::string otherFile = (tmpFolder.get() / "other.GER").string();
+    const std::string brokenFile = (tmpFolder.get() / "broken.bmp").string();
+    BOOST_TEST_REQUIRE(libsiedler2::Write(file1, createTxtArchive({"1"})) == 0);
+    BOOST_TEST_REQUIRE(libsiedler2::Write(file2, createTxtArchive({"2"})) == 0);
+    BOOST_TEST_REQUIRE(libsiedler2::Write(otherFile, createTxtArchive({"other"})) == 0);
+    {
+        boost::nowide::ofstream f(brokenFile);
+        f << "Not a bitmap";
+    }
+
+    Loader loader(LOG, RTTRCONFIG);
+    // The last file for an id is used
+    BOOST_TEST_REQUIRE(loader.LoadFiles({file1, file2}));
+    BOOST_TEST(loader.GetTextN("test", 0) == "2");
+    BOOST_TEST_REQUIRE(loader.LoadFiles({file2, file1}));
+    BOOST_TEST(loader.GetTextN("test", 0) == "1");
+    // Files before the first error are stored, the ones after it are not
+    BOOST_TEST(!loader.LoadFiles({file2, brokenFile, otherFile}));
+    BOOST_TEST(loader.GetTextN("test", 0) == "2");
+    BOOST_TEST(loader.GetTextN("other", 0) == "text missing");
+
+    // Avoid log cluttering
+    logAcc.clearLog();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
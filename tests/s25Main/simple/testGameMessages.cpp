@@ -2,8 +2,11 @@
 //
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include "AsyncChecksum.h"
 #include "JoinPlayerInfo.h"
+#include "network/GameMessage_Batch.h"
 #include "network/GameMessages.h"
+#include "network/NetworkPlayer.h"
 #include "gameTypes/GameTypesOutput.h"
 #include "gameTypes/PlayerState.h"
 #include "rttr/test/random.hpp"
@@ -305,4 +308,99 @@ BOOST_AUTO_TEST_CASE(Serialization)
     }
 }
 
+namespace {
+struct PingReceiver : GameMessageInterface
+{
+    std::vector<unsigned> senders, players;
+    bool OnGameMessage(const GameMessage_Ping& msg) override
+    {
+        senders.push_back(msg.senderPlayerID);
+        players.push_back(msg.player);
+        return true;
+    }
+};
+} // namespace
+
+BOOST_AUTO_TEST_CASE(BatchAndSharedMessages)
+{
+    const GameMessage_Server_Type typeMsg(ServerType::Local, rttr::test::randString());
+    const GameMessage_Shared sharedMsg(typeMsg);
+    {
+        // Shared message serializes to the same data
+        Serializer ser, sharedSer;
+        typeMsg.Serialize(ser);
+        sharedMsg.Serialize(sharedSer);
+        BOOST_TEST(sharedMsg.getId() == typeMsg.getId());
+        BOOST_TEST(sharedMsg.getSize() == ser.GetLength());
+        BOOST_TEST(std::vector<uint8_t>(sharedSer.GetData(), sharedSer.GetData() + sharedSer.GetLength())
+                     == std::vector<uint8_t>(ser.GetData(), ser.GetData() + ser.GetLength()),
+                   boost::test_tools::per_element());
+    }
+    GameMessage_Batch batchIn;
+    batchIn.msgs.emplace_back(new GameMessage_Ping(2));
+    batchIn.msgs.emplace_back(new GameMessage_Shared(sharedMsg));
+    batchIn.msgs.emplace_back(new GameMessage_Server_NWFDone(1, 2, 3));
+    batchIn.msgs.emplace_back(new GameMessage_Ping(4));
+    const auto batchOut = serializeDeserializeMessage(batchIn);
+    BOOST_TEST_REQUIRE(batchOut->msgs.size() == 4u);
+    const auto* typeOut = dynamic_cast<const GameMessage_Server_Type*>(batchOut->msgs[1].get());
+    BOOST_TEST_REQUIRE(typeOut);
+    BOOST_TEST(typeOut->revision == typeMsg.revision);
+    const auto* nwfDoneOut = dynamic_cast<const GameMessage_Server_NWFDone*>(batchOut->msgs[2].get());
+    BOOST_TEST_REQUIRE(nwfDoneOut);
+    BOOST_TEST(nwfDoneOut->nextNWF == 3u);
+
+    // Running executes all messages in order with the sender of the batch
+    PingReceiver receiver;
+    batchOut->run(&receiver, 1);
+    BOOST_TEST(receiver.senders == (std::vector<unsigned>{1, 1}), boost::test_tools::per_element());
+    BOOST_TEST(receiver.players == (std::vector<unsigned>{2, 4}), boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(ChecksumStateHash)
+{
+    const AsyncChecksum withHash(1, 2, 3, 4, 5, 0);
+    const AsyncChecksum otherHash(1, 2, 3, 4, 5, 6);
+    const AsyncChecksum withoutHash(1, 2, 3, 4, 5);
+    // A hash of 0 is a valid hash
+    BOOST_TEST(withHash.hasStateHash);
+    BOOST_TEST(withHash != otherHash);
+    // A missing hash matches any hash
+    BOOST_TEST(!withoutHash.hasStateHash);
+    BOOST_TEST(withoutHash == withHash);
+    BOOST_TEST(otherHash == withoutHash);
+
+    for(const AsyncChecksum& checksum : {withHash, otherHash, withoutHash})
+    {
+        Serializer ser;
+        checksum.Serialize(ser);
+        AsyncChecksum checksumOut;
+        checksumOut.Deserialize(ser);
+        BOOST_TEST(checksumOut.hasStateHash == checksum.hasStateHash);
+        BOOST_TEST(checksumOut.stateHash == checksum.stateHash);
+    }
+    // The basic format has no hash
+    Serializer ser;
+    withHash.Serialize(ser, AsyncChecksum::Version::Basic);
+    AsyncChecksum checksumOut;
+    checksumOut.Deserialize(ser, AsyncChecksum::Version::Basic);
+    BOOST_TEST(!checksumOut.hasStateHash);
+    BOOST_TEST(checksumOut.randChecksum == withHash.randChecksum);
+}
+
+BOOST_AUTO_TEST_CASE(PopBatchFromQueue)
+{
+    NetworkPlayer player(0);
+    for(unsigned i = 0; i < 3; i++)
+        player.sendMsgAsync(new GameMessage_Ping(i));
+    const auto batch = player.popBatch(2);
+    BOOST_TEST_REQUIRE(batch);
+    BOOST_TEST_REQUIRE(batch->msgs.size() == 2u);
+    BOOST_TEST(dynamic_cast<const GameMessage_Ping&>(*batch->msgs[1]).player == 1u);
+    // A single message is not batched and stays in the queue
+    BOOST_TEST(!player.popBatch(-1));
+    BOOST_TEST_REQUIRE(player.sendQueue.size() == 1u);
+    BOOST_TEST(dynamic_cast<const GameMessage_Ping&>(*player.sendQueue.pop()).player == 2u);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,174 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "network/NWFScheduler.h"
+#include <boost/test/unit_test.hpp>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+namespace {
+/// Loopback simulation of the NWF protocol between the server and clients with artificial delays.
+/// Times are in ms. A client executes NWF k when it is due, got the NWFDone for it (sent when the server executed
+/// NWF k - cmdDelay) and the commands of all players for it (sent when they executed NWF k - cmdDelay, relayed by the
+/// server). The server executes NWF k when it got the commands of all players for it.
+struct LoopbackGame
+{
+    static constexpr unsigned cmdDelay = 3;
+    FramesInfo::milliseconds32_t gfLength = 50ms;
+    unsigned numClients = 2;
+    /// One-way delay of a client in ms for a message sent at the given time
+    std::function<unsigned(unsigned client, unsigned time)> delay;
+    bool adaptive = true;
+
+    /// Time client 0 had to wait for messages
+    unsigned waitTime = 0;
+    /// Length of all NWFs
+    std::vector<unsigned> nwfLengths;
+
+    void run(unsigned numGFs)
+    {
+        const unsigned gfLen = gfLength.count();
+        NWFScheduler scheduler;
+        for(unsigned c = 0; c < numClients; c++)
+            scheduler.setPing(c, 2 * delay(c, 0));
+        // Server sends the NWFDone for the first cmdDelay NWFs on start
+        nwfLengths.assign(cmdDelay, scheduler.getRequiredNWFLength(gfLength));
+        std::vector<unsigned> serverTimes;
+        std::vector<std::vector<unsigned>> clientTimes(numClients);
+        waitTime = 0;
+        for(unsigned nwf = 0, gf = 0; gf < numGFs; gf += nwfLengths[nwf], nwf++)
+        {
+            unsigned serverTime = 0;
+            if(nwf > 0)
+                serverTime = serverTimes[nwf - 1] + nwfLengths[nwf - 1] * gfLen;
+            if(nwf >= cmdDelay)
+            {
+                for(unsigned c = 0; c < numClients; c++)
+                {
+                    const unsigned sendTime = clientTimes[c][nwf - cmdDelay];
+                    serverTime = std::max(serverTime, sendTime + delay(c, sendTime));
+                }
+            }
+            serverTimes.push_back(serverTime);
+            // Pongs arrive regularly, so the server knows the current pings
+            for(unsigned c = 0; c < numClients; c++)
+                scheduler.setPing(c, 2 * delay(c, serverTime));
+            const unsigned lastLength = nwfLengths.back();
+            nwfLengths.push_back(adaptive ? scheduler.getNextNWFLength(lastLength, gfLength) : lastLength);
+
+            for(unsigned c = 0; c < numClients; c++)
+            {
+                if(nwf == 0)
+                {
+                    clientTimes[c].push_back(delay(c, 0));
+                    continue;
+                }
+                const unsigned dueTime = clientTimes[c][nwf - 1] + nwfLengths[nwf - 1] * gfLen;
+                unsigned time = dueTime;
+                if(nwf >= cmdDelay)
+                {
+                    const unsigned nwfDoneTime = serverTimes[nwf - cmdDelay];
+                    time = std::max(time, nwfDoneTime + delay(c, nwfDoneTime));
+                    for(unsigned p = 0; p < numClients; p++)
+                    {
+                        const unsigned sendTime = clientTimes[p][nwf - cmdDelay];
+                        time = std::max(time, sendTime + delay(p, sendTime) + delay(c, sendTime));
+                    }
+                }
+                if(c == 0)
+                    waitTime += time - dueTime;
+                clientTimes[c].push_back(time);
+            }
+        }
+    }
+};
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(NWFSchedulerTests)
+
+BOOST_AUTO_TEST_CASE(RequiredLengthCoversHighestPing)
+{
+    NWFScheduler scheduler;
+    BOOST_TEST(scheduler.getHighestPing() == 0u);
+    BOOST_TEST(scheduler.getRequiredNWFLength(50ms) == NWFScheduler::minNWFLength);
+    scheduler.setPing(0, 40);
+    scheduler.setPing(3, 120);
+    BOOST_TEST(scheduler.getHighestPing() == 120u);
+    BOOST_TEST(scheduler.getRequiredNWFLength(50ms) == 3u);
+    BOOST_TEST(scheduler.getRequiredNWFLength(40ms) == 3u);
+    BOOST_TEST(scheduler.getRequiredNWFLength(30ms) == 4u);
+    // Update
+    scheduler.setPing(3, 20);
+    BOOST_TEST(scheduler.getHighestPing() == 40u);
+    BOOST_TEST(scheduler.getRequiredNWFLength(50ms) == 1u);
+    // Kicked players don't count
+    scheduler.setPing(1, 200);
+    BOOST_TEST(scheduler.getRequiredNWFLength(50ms) == 4u);
+    scheduler.removePlayer(1);
+    BOOST_TEST(scheduler.getRequiredNWFLength(50ms) == 1u);
+    // Bounded
+    scheduler.setPing(2, 100000);
+    BOOST_TEST(scheduler.getRequiredNWFLength(50ms) == NWFScheduler::maxNWFLength);
+    scheduler.clear();
+    BOOST_TEST(scheduler.getHighestPing() == 0u);
+}
+
+BOOST_AUTO_TEST_CASE(NextLengthIncreasesFastAndDecreasesSlowly)
+{
+    NWFScheduler scheduler;
+    scheduler.setPing(0, 300);
+    BOOST_TEST(scheduler.getNextNWFLength(1, 50ms) == 6u);
+    BOOST_TEST(scheduler.getNextNWFLength(6, 50ms) == 6u);
+    scheduler.setPing(0, 20);
+    unsigned length = 6;
+    for(unsigned expected = 5; expected >= 1u; expected--)
+    {
+        length = scheduler.getNextNWFLength(length, 50ms);
+        BOOST_TEST(length == expected);
+    }
+    BOOST_TEST(scheduler.getNextNWFLength(1, 50ms) == 1u);
+    // A length out of bounds (e.g. after a speed change) gets back into them
+    BOOST_TEST(scheduler.getNextNWFLength(30, 50ms) == NWFScheduler::maxNWFLength);
+}
+
+BOOST_AUTO_TEST_CASE(LoopbackWithLatencySpike)
+{
+    LoopbackGame game;
+    // Low latency, then 10s with high latency
+    game.delay = [](unsigned client, unsigned time) {
+        return ((time >= 5000 && time < 15000) ? 150u : 10u) + client * 5u;
+    };
+    game.adaptive = false;
+    game.run(600);
+    const unsigned fixedWaitTime = game.waitTime;
+    BOOST_TEST(std::all_of(game.nwfLengths.begin(), game.nwfLengths.end(), [](unsigned l) { return l == 1u; }));
+    // Each NWF waits for the commands of the others
+    BOOST_TEST(fixedWaitTime > 1000u);
+
+    game.adaptive = true;
+    game.run(600);
+    BOOST_TEST(game.waitTime * 10u < fixedWaitTime);
+    const auto minMax = std::minmax_element(game.nwfLengths.begin(), game.nwfLengths.end());
+    BOOST_TEST(*minMax.first == NWFScheduler::minNWFLength);
+    BOOST_TEST(*minMax.second > 5u);
+    BOOST_TEST(*minMax.second <= NWFScheduler::maxNWFLength);
+    // Back to fast NWFs after the spike
+    BOOST_TEST(game.nwfLengths.back() == 1u);
+}
+
+BOOST_AUTO_TEST_CASE(LoopbackWithHugeLatency)
+{
+    LoopbackGame game;
+    game.numClients = 4;
+    game.delay = [](unsigned, unsigned) { return 5000u; };
+    game.run(200);
+    // Longest possible NWFs
+    BOOST_TEST(game.nwfLengths.front() == NWFScheduler::maxNWFLength);
+    BOOST_TEST(game.nwfLengths.back() == NWFScheduler::maxNWFLength);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
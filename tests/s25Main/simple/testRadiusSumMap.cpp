@@ -0,0 +1,64 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "PointOutput.h"
+#include "RttrForeachPt.h"
+#include "world/RadiusSumMap.h"
+#include <boost/test/unit_test.hpp>
+
+namespace {
+int sumInRadius(const RadiusSumMap& map, MapPoint pt, unsigned radius)
+{
+    int result = 0;
+    for(const MapPoint curPt : map.GetPointsInRadiusWithCenter(pt, radius))
+        result += map.Get(curPt);
+    return result;
+}
+} // namespace
+
+BOOST_AUTO_TEST_SUITE(RadiusSumMapSuite)
+
+BOOST_AUTO_TEST_CASE(SumsMatchPointsInRadius)
+{
+    // Includes a tiny map where the radius wraps around the whole map
+    for(const MapExtent size : {MapExtent(32, 24), MapExtent(6, 4)})
+    {
+        RadiusSumMap map;
+        map.Resize(size);
+        BOOST_TEST(map.GetSumInRadius(MapPoint(1, 1), 3) == 0);
+        RTTR_FOREACH_PT(MapPoint, size)
+            map.Set(pt, static_cast<int>((pt.x * 7 + pt.y * 13) % 11) - 3);
+        RTTR_FOREACH_PT(MapPoint, size)
+        {
+            for(unsigned radius = 0; radius <= 8; radius++)
+            {
+                BOOST_TEST_INFO(pt << " radius " << radius);
+                BOOST_TEST(map.GetSumInRadius(pt, radius) == sumInRadius(map, pt, radius));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(UpdatesAreReflected)
+{
+    RadiusSumMap map;
+    map.Resize(MapExtent(40, 30));
+    const MapPoint center(20, 15);
+    map.Set(center, 5);
+    BOOST_TEST(map.GetSumInRadius(center, 0) == 5);
+    BOOST_TEST(map.GetSumInRadius(MapPoint(23, 15), 2) == 0);
+    BOOST_TEST(map.GetSumInRadius(MapPoint(23, 15), 3) == 5);
+    // Wrapping around the map borders
+    map.Set(MapPoint(0, 0), 3);
+    map.Set(MapPoint(39, 29), 4);
+    BOOST_TEST(map.GetSumInRadius(MapPoint(0, 0), 1) == 7);
+    BOOST_TEST(map.GetSumInRadius(MapPoint(39, 29), 1) == 7);
+    map.Set(MapPoint(0, 0), -2);
+    BOOST_TEST(map.Get(MapPoint(0, 0)) == -2);
+    BOOST_TEST(map.GetSumInRadius(MapPoint(0, 0), 1) == 2);
+    // The corners are too far away
+    BOOST_TEST(map.GetSumInRadius(center, 14) == 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,74 @@
+// Copyright (C) 2005 - 2021 Settlers Freaks (sf-team at siedler25.org)
+//
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "WorkerPool.h"
+#include <boost/test/unit_test.hpp>
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(WorkerPoolTests)
+
+BOOST_AUTO_TEST_CASE(RunsAllTasksOnce)
+{
+    for(unsigned numThreads : {0u, 1u, 3u})
+    {
+        WorkerPool pool(numThreads);
+        BOOST_TEST(pool.GetNumThreads() == numThreads);
+        for(unsigned numTasks : {0u, 1u, 2u, 7u, 100u})
+        {
+            std::vector<std::atomic<unsigned>> numCalls(numTasks);
+            for(auto& ctr : numCalls)
+                ctr = 0;
+            pool.Run(numTasks, [&numCalls](unsigned i) { numCalls[i]++; });
+            for(const auto& ctr : numCalls)
+                BOOST_TEST(ctr == 1u);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(ResultsIndependentOfThreads)
+{
+    const auto calc = [](unsigned numThreads) {
+        WorkerPool pool(numThreads);
+        std::vector<unsigned> results(50);
+        for(unsigned run = 0; run < 10; run++)
+        {
+            pool.Run(results.size(), [&results, run](unsigned i) {
+                for(unsigned j = 0; j < 1000; j++)
+                    results[i] = results[i] * 31u + i + run + j;
+            });
+        }
+        return results;
+    };
+    const std::vector<unsigned> expected = calc(0);
+    BOOST_TEST(calc(4) == expected, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_CASE(RethrowsFirstException)
+{
+    WorkerPool pool(2);
+    std::atomic<unsigned> numCalls(0);
+    try
+    {
+        pool.Run(10, [&numCalls](unsigned i) {
+            numCalls++;
+            if(i == 3 || i == 7)
+                throw std::runtime_error(std::to_string(i));
+        });
+        BOOST_TEST_FAIL("No exception thrown");
+    } catch(const std::runtime_error& e)
+    {
+        BOOST_TEST(e.what() == std::string("3"));
+    }
+    // All tasks still run
+    BOOST_TEST(numCalls == 10u);
+    // And the pool is still usable
+    numCalls = 0;
+    pool.Run(5, [&numCalls](unsigned) { numCalls++; });
+    BOOST_TEST(numCalls == 5u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
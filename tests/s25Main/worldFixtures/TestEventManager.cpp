@@ -9,49 +9,31 @@ unsigned TestEventManager::ExecuteNextEvent(unsigned maxGF)
 {
     if(GetCurrentGF() >= maxGF)
         return 0;
-    if(events.empty())
+    if(GetNumActiveEvents() == 0u || GetNextEventGF() > maxGF)
     {
         unsigned numGFs = maxGF - GetCurrentGF();
-        currentGF = maxGF;
+        AdvanceToGF(maxGF);
         return numGFs;
     }
-    auto itEvents = events.begin();
-    if(itEvents->first > maxGF)
-    {
-        unsigned numGFs = maxGF - GetCurrentGF();
-        currentGF = maxGF;
-        return numGFs;
-    }
-    unsigned numGFs = itEvents->first - GetCurrentGF();
-    currentGF = itEvents->first;
-    ExecuteEvents(itEvents);
+    const unsigned nextGF = GetNextEventGF();
+    unsigned numGFs = nextGF - GetCurrentGF();
+    AdvanceToGF(nextGF);
+    ExecuteCurrentEvents();
     DestroyCurrentObjects();
     return numGFs;
 }
 
 std::vector<const GameEvent*> TestEventManager::GetObjEvents(const GameObject& obj) const
 {
-    std::vector<const GameEvent*> objEvnts;
-    for(const auto& event : events)
-    {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->obj == &obj)
-                objEvnts.push_back(ev);
-        }
-    }
-    return objEvnts;
+    return GetObjectEvents(obj);
 }
 
 bool TestEventManager::IsEventActive(const GameObject& obj, const unsigned id) const
 {
-    for(const auto& event : events)
+    for(const GameEvent* ev : GetObjectEvents(obj))
     {
-        for(const GameEvent* ev : event.second)
-        {
-            if(ev->id == id && ev->obj == &obj)
-                return true;
-        }
+        if(ev->id == id)
+            return true;
     }
 
     return false;